@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""Expand the firmware's binary log lines ("#L<hex>") in a Serial capture.
+
+The device logs the address of each format string rather than the text, so
+decoding needs the ELF of the exact build that produced the capture:
+
+    pio device monitor | tee capture.txt
+    python3 decode_log.py .pio/build/esp32_35_st7796/firmware.elf capture.txt
+
+Data records (the DIAG samples) are formatted on the device and reach Serial
+as plain CSV lines; those and other lines (boot messages) are passed through
+unchanged.
+Reads the capture from stdin when no file is given.
+"""
+
+import re
+import struct
+import sys
+
+LEVELS = {0: "DEBUG", 1: "INFO", 2: "ERROR"}
+LEVEL_DATA = 4
+ARG_I32, ARG_U32, ARG_I64, ARG_U64, ARG_F32, ARG_STR = range(1, 7)
+SPEC = re.compile(r"%(%|[-+ #0]*\d*(?:\.\d+)?(?:hh|h|ll|l|z|j|t)?[diouxXeEfFgGaAcsp])")
+
+
+class Elf32:
+    """Just enough of ELF32 to read NUL-terminated strings by address."""
+
+    def __init__(self, path):
+        with open(path, "rb") as f:
+            self.data = f.read()
+        if self.data[:4] != b"\x7fELF" or self.data[4] != 1:
+            raise ValueError("not a 32-bit ELF file: " + path)
+        endian = "<" if self.data[5] == 1 else ">"
+        shoff, = struct.unpack_from(endian + "I", self.data, 0x20)
+        shentsize, shnum = struct.unpack_from(endian + "HH", self.data, 0x2E)
+        self.sections = []
+        for i in range(shnum):
+            _, sh_type, flags, addr, offset, size = struct.unpack_from(
+                endian + "IIIIII", self.data, shoff + i * shentsize)
+            # Allocated sections with file contents (SHT_NOBITS = 8 has none)
+            if flags & 0x2 and sh_type != 8 and size:
+                self.sections.append((addr, offset, size))
+
+    def string_at(self, addr):
+        for start, offset, size in self.sections:
+            if start <= addr < start + size:
+                pos = offset + (addr - start)
+                end = self.data.index(b"\0", pos, offset + size)
+                return self.data[pos:end].decode("utf-8", "replace")
+        return None
+
+
+def read_args(record, pos):
+    args = []
+    while pos < len(record):
+        kind = record[pos]
+        pos += 1
+        if kind == ARG_STR:
+            n = record[pos]
+            args.append(("s", record[pos + 1:pos + 1 + n].decode("utf-8", "replace")))
+            pos += 1 + n
+        elif kind in (ARG_I32, ARG_U32, ARG_F32):
+            code = {ARG_I32: "<i", ARG_U32: "<I", ARG_F32: "<f"}[kind]
+            args.append(("f" if kind == ARG_F32 else "i", struct.unpack_from(code, record, pos)[0]))
+            pos += 4
+        elif kind in (ARG_I64, ARG_U64):
+            args.append(("i", struct.unpack_from("<q" if kind == ARG_I64 else "<Q", record, pos)[0]))
+            pos += 8
+        else:
+            break
+    return args
+
+
+def format_arg(spec, arg):
+    """Format one argument the way the device's text mode does: by the type
+    recorded, keeping the spec's flags, width and precision."""
+    kind, value = arg
+    conv = spec[-1]
+    base = re.sub(r"(hh|h|ll|l|z|j|t)", "", spec[:-1])
+    if kind == "s":
+        return ("%" + base + "s") % value
+    if kind == "f":
+        return ("%" + base + (conv if conv in "eEfFgG" else "f")) % value
+    if conv in "eEfFgG":
+        return ("%" + base + conv) % float(value)
+    if conv == "c":
+        return chr(value & 0xFF)
+    if conv in "xXo":
+        return ("%" + base + conv) % (value & 0xFFFFFFFFFFFFFFFF if value < 0 else value)
+    return ("%" + base + "d") % value
+
+
+def decode(record, elf):
+    level = record[1]
+    ms, fmt_addr = struct.unpack_from("<II", record, 2)
+    fmt = elf.string_at(fmt_addr)
+    args = read_args(record, 10)
+    if fmt is None:
+        text = "<format 0x%08x not in ELF> %r" % (fmt_addr, [a[1] for a in args])
+    else:
+        it = iter(args)
+
+        def expand(m):
+            if m.group(1) == "%":
+                return "%"
+            arg = next(it, None)
+            return "<?>" if arg is None else format_arg(m.group(1), arg)
+
+        text = SPEC.sub(expand, fmt)
+    if level == LEVEL_DATA:
+        return text
+    return "[%-5s %10u ms] %s" % (LEVELS.get(level, "?"), ms, text)
+
+
+def main():
+    if len(sys.argv) < 2:
+        sys.exit(__doc__)
+    elf = Elf32(sys.argv[1])
+    source = open(sys.argv[2], errors="replace") if len(sys.argv) > 2 else sys.stdin
+    for line in source:
+        line = line.rstrip("\r\n")
+        idx = line.find("#L")
+        if idx < 0:
+            print(line)
+            continue
+        try:
+            record = bytes.fromhex(line[idx + 2:].strip())
+            print(line[:idx] + decode(record, elf))
+        except (ValueError, struct.error):
+            print(line)
+
+
+if __name__ == "__main__":
+    main()
@@ -185,6 +185,12 @@ public:
     long   toLong()  const { return atol(_s.c_str()); }
 
     // Checks
+    bool equalsIgnoreCase(const String& o) const {
+        if (_s.size() != o._s.size()) return false;
+        for (size_t i = 0; i < _s.size(); ++i)
+            if (::tolower((unsigned char)_s[i]) != ::tolower((unsigned char)o._s[i])) return false;
+        return true;
+    }
     bool startsWith(const String& prefix) const {
         return _s.size() >= prefix._s.size() && _s.compare(0, prefix._s.size(), prefix._s) == 0;
     }
@@ -250,6 +256,8 @@ public:
 class HardwareSerial {
 public:
     void begin(int) {}
+    void setTxBufferSize(size_t) {}
+    int availableForWrite()       { return 4096; }
     void print(const char* s)     { if(s) fputs(s, stdout); fflush(stdout); }
     void print(const String& s)   { fputs(s.c_str(), stdout); fflush(stdout); }
     void print(int v)             { printf("%d", v); fflush(stdout); }
@@ -261,6 +269,7 @@ public:
     void println(int v)           { printf("%d\n", v); fflush(stdout); }
     void println(unsigned long v) { printf("%lu\n", v); fflush(stdout); }
     void println()                { puts(""); fflush(stdout); }
+    size_t write(const uint8_t* buf, size_t len) { fwrite(buf, 1, len, stdout); fflush(stdout); return len; }
     void printf(const char* fmt, ...) {
         va_list args; va_start(args, fmt); vprintf(fmt, args); va_end(args); fflush(stdout);
     }
@@ -273,12 +282,24 @@ inline void configTime(long, long, const char*, const char* = nullptr) {
 }
 
 // ── ESP.restart() ─────────────────────────────────────────────────────────────
+// Shutdown handlers run before the page reloads, as they do before esp_restart().
+typedef void (*shutdown_handler_t)(void);
+inline shutdown_handler_t* _shutdownHandlers() { static shutdown_handler_t h[5] = {}; return h; }
+inline int esp_register_shutdown_handler(shutdown_handler_t handler) {
+    for (int i = 0; i < 5; i++) {
+        if (!_shutdownHandlers()[i]) { _shutdownHandlers()[i] = handler; return 0; }
+    }
+    return -1;
+}
+
 class ESP32Class {
 public:
     void restart() {
+        for (int i = 4; i >= 0; i--) if (_shutdownHandlers()[i]) _shutdownHandlers()[i]();
         EM_ASM({ location.reload(); });
     }
     uint32_t getFreeHeap() { return 1024 * 1024; }
+    uint32_t getMaxAllocHeap() { return 1024 * 1024; }
 };
 extern ESP32Class ESP;
 
@@ -9,6 +9,7 @@
 
 #define FILE_READ  "r"
 #define FILE_WRITE "w"
+#define FILE_APPEND "a"
 
 // ── File class ────────────────────────────────────────────────────────────────
 // Extends Stream so ArduinoJson's deserializeJson(doc, file) works correctly.
@@ -29,21 +30,28 @@ public:
     int    read()      override { if (_pos >= _buf.size()) return -1; return (unsigned char)_buf[_pos++]; }
     int    available() override { return (int)(_buf.size() - _pos); }
     int    peek()      override { if (_pos >= _buf.size()) return -1; return (unsigned char)_buf[_pos]; }
+    size_t read(uint8_t* buf, size_t len) {
+        size_t n = std::min(len, _buf.size() - std::min(_pos, _buf.size()));
+        memcpy(buf, _buf.data() + _pos, n);
+        _pos += n;
+        return n;
+    }
+    bool   seek(size_t pos) { if (pos > _buf.size()) return false; _pos = pos; return true; }
+    size_t position() const { return _pos; }
 
     // ── Print interface (required by ArduinoJson serialization) ──────────────
-    size_t write(uint8_t c) override {
-        if (_write_mode) _buf += (char)c;
-        return 1;
-    }
+    // Writes go at the current position, overwriting ("r+") or extending.
+    size_t write(uint8_t c) override { return write(&c, 1); }
     size_t write(const uint8_t* data, size_t len) {
-        if (_write_mode) _buf.append((const char*)data, len);
+        if (!_write_mode) return len;
+        if (_pos > _buf.size()) _buf.resize(_pos);
+        _buf.replace(_pos, std::min(len, _buf.size() - _pos), (const char*)data, len);
+        _pos += len;
         return len;
     }
     size_t print(const char* s) {
         if (!s) return 0;
-        size_t n = strlen(s);
-        if (_write_mode) _buf.append(s, n);
-        return n;
+        return write((const uint8_t*)s, strlen(s));
     }
     size_t print(const String& s)   { return print(s.c_str()); }
     size_t println(const char* s)   { size_t n = print(s); write('\n'); return n + 1; }
@@ -58,6 +66,7 @@ public:
     void close();
 
     const char* name() const { return _path.c_str(); }
+    const char* path() const { return _path.c_str(); }
 };
 
 #endif // FS_H
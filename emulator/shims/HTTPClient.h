@@ -3,12 +3,14 @@
 #define HTTPCLIENT_H
 
 #include "Arduino.h"
+#include "WiFi.h"
 #include <emscripten.h>
 #include <vector>
 #include <string>
 
 #define HTTP_CODE_OK      200
 #define HTTP_CODE_CREATED 201
+#define HTTP_CODE_NOT_MODIFIED 304
 #define HTTPC_STRICT_FOLLOW_REDIRECTS 1
 
 // ── Native browser fetch (defined once in shim_impl.cpp via EM_ASYNC_JS) ─────
@@ -27,6 +29,7 @@ class HTTPClient {
     int                      _statusCode = 0;
     int                      _timeout    = 10000;
     std::vector<std::string> _headerKV;   // alternating key, value
+    WiFiClient               _stream;
 
     int _sendRequest(const char* method, const char* body = nullptr) {
         // Encode headers as "Key: Value\n..." for the JS side
@@ -51,14 +54,22 @@ class HTTPClient {
             _responseBody.clear();
             if (_statusCode == 0) _statusCode = -1;
         }
+        _stream._load(_responseBody);
         return _statusCode;
     }
 
 public:
     void begin(const String& url) { _url = url.c_str(); _responseBody.clear(); }
     void begin(const char* url)   { _url = url;         _responseBody.clear(); }
+    // Caller-owned client (keep-alive pooling on the device); the browser
+    // manages its own connections, so the client is ignored here.
+    void begin(WiFiClient&, const String& url) { begin(url); }
+    void setReuse(bool)           {}
+    void collectHeaders(const char* [], size_t) {}
+    String header(const char*)    { return String(); }
     void setTimeout(int ms)       { _timeout = ms; }
     void setFollowRedirects(int)  {}
+    void useHTTP10(bool)          {}   // browser fetch never exposes chunked framing
 
     void addHeader(const String& key, const String& value) {
         _headerKV.push_back(key.c_str());
@@ -83,12 +94,15 @@ public:
     }
 
     String getString()      { return String(_responseBody.c_str()); }
+    WiFiClient& getStream() { return _stream; }
+    int    getSize()        { return (int)_responseBody.size(); }
     int    getResponseCode(){ return _statusCode; }
 
     void end() {
         _url.clear();
         _responseBody.clear();
         _headerKV.clear();
+        _stream.stop();
         _statusCode = 0;
     }
 };
@@ -14,6 +14,7 @@
 class SPIFFSClass {
 public:
     bool begin(bool = false) { return true; }
+    void end() {}
 
     bool exists(const char* path) {
         return EM_ASM_INT({
@@ -39,6 +40,23 @@ public:
         return true;
     }
     bool remove(const String& path) { return remove(path.c_str()); }
+
+    // Like SPIFFS on the device, fails if the target already exists.
+    bool rename(const char* from, const char* to) {
+        return EM_ASM_INT({
+            var src = UTF8ToString($0), dst = UTF8ToString($1);
+            var val = localStorage.getItem('spiffs:' + src);
+            if (val === null || localStorage.getItem('spiffs:' + dst) !== null) return 0;
+            localStorage.setItem('spiffs:' + dst, val);
+            localStorage.removeItem('spiffs:' + src);
+            var kl = JSON.parse(localStorage.getItem('spiffs:__keys__') || '[]');
+            var idx = kl.indexOf(src);
+            if (idx >= 0) kl[idx] = dst; else kl.push(dst);
+            localStorage.setItem('spiffs:__keys__', JSON.stringify(kl));
+            return 1;
+        }, from, to) != 0;
+    }
+    bool rename(const String& from, const String& to) { return rename(from.c_str(), to.c_str()); }
 };
 
 extern SPIFFSClass SPIFFS;
@@ -16,6 +16,31 @@ public:
     operator String() const { return toString(); }
 };
 
+// ── WiFiClient ────────────────────────────────────────────────────────────────
+// In the browser there is no socket; HTTPClient loads the whole response body
+// into this client so firmware code can read it through the Stream interface
+// (e.g. deserializeJson(doc, http.getStream())).
+class WiFiClient : public Stream {
+public:
+    std::string _buf;
+    size_t      _pos = 0;
+
+    void   _load(const std::string& body) { _buf = body; _pos = 0; }
+    int    read()      override { if (_pos >= _buf.size()) return -1; return (unsigned char)_buf[_pos++]; }
+    int    available() override { return (int)(_buf.size() - _pos); }
+    int    peek()      override { if (_pos >= _buf.size()) return -1; return (unsigned char)_buf[_pos]; }
+    size_t write(uint8_t) override { return 1; }
+    size_t readBytes(char* buf, size_t len) {
+        size_t n = std::min(len, _buf.size() - _pos);
+        memcpy(buf, _buf.data() + _pos, n);
+        _pos += n;
+        return n;
+    }
+    size_t readBytes(uint8_t* buf, size_t len) { return readBytes((char*)buf, len); }
+    bool   connected() { return _pos < _buf.size(); }
+    void   stop() { _buf.clear(); _pos = 0; }
+};
+
 class WiFiClass {
 public:
     void mode(int) {}
@@ -23,6 +48,8 @@ public:
     int  status() { return WL_CONNECTED; }  // always connected in browser
     bool disconnect(bool, bool) { return true; }
     IPAddress localIP() { return IPAddress(); }
+    // The browser resolves names itself inside fetch(); report success.
+    int  hostByName(const char*, IPAddress& result) { result = IPAddress(); return 1; }
 };
 
 extern WiFiClass WiFi;
@@ -0,0 +1,21 @@
+#pragma once
+#ifndef WIFICLIENTSECURE_H
+#define WIFICLIENTSECURE_H
+
+#include "Arduino.h"
+#include "WiFi.h"
+
+// ── WiFiClientSecure shim ─────────────────────────────────────────────────────
+// TLS is handled by the browser's fetch(); this only has to satisfy the
+// connection-pool code in Network.cpp, which pre-connects pooled clients.
+class WiFiClientSecure : public WiFiClient {
+    bool _open = false;
+public:
+    void setInsecure() {}
+    int  connect(IPAddress, uint16_t, const char*, const char*, const char*, const char*) { _open = true; return 1; }
+    int  connect(const char*, uint16_t) { _open = true; return 1; }
+    bool connected() { return _open; }
+    void stop() { _open = false; WiFiClient::stop(); }
+};
+
+#endif // WIFICLIENTSECURE_H
@@ -0,0 +1,42 @@
+#pragma once
+// ── ROM miniz shim ────────────────────────────────────────────────────────────
+// The browser's fetch() inflates responses itself and the HTTPClient shim
+// reports no Content-Encoding, so the firmware's gzip path never runs here.
+// Declarations match the ESP32 ROM; decompression always fails.
+
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned char mz_uint8;
+typedef uint32_t mz_uint32;
+
+#define TINFL_LZ_DICT_SIZE 32768
+
+enum {
+    TINFL_FLAG_PARSE_ZLIB_HEADER = 1,
+    TINFL_FLAG_HAS_MORE_INPUT = 2,
+    TINFL_FLAG_USING_NON_WRAPPING_OUTPUT_BUF = 4,
+    TINFL_FLAG_COMPUTE_ADLER32 = 8
+};
+
+typedef enum {
+    TINFL_STATUS_BAD_PARAM = -3,
+    TINFL_STATUS_ADLER32_MISMATCH = -2,
+    TINFL_STATUS_FAILED = -1,
+    TINFL_STATUS_DONE = 0,
+    TINFL_STATUS_NEEDS_MORE_INPUT = 1,
+    TINFL_STATUS_HAS_MORE_OUTPUT = 2
+} tinfl_status;
+
+typedef struct tinfl_decompressor_tag {
+    mz_uint32 m_state;
+} tinfl_decompressor;
+
+#define tinfl_init(r) do { (r)->m_state = 0; } while (0)
+
+inline tinfl_status tinfl_decompress(tinfl_decompressor*, const mz_uint8*, size_t* pIn_buf_size,
+                                     mz_uint8*, mz_uint8*, size_t* pOut_buf_size, const mz_uint32) {
+    *pIn_buf_size = 0;
+    *pOut_buf_size = 0;
+    return TINFL_STATUS_FAILED;
+}
@@ -0,0 +1,44 @@
+#pragma once
+// FreeRTOS shim — the browser build is single-threaded. Mutexes always succeed,
+// and task/queue creation fails so callers fall back to running work inline.
+#include <cstdint>
+#include <cstddef>
+
+typedef int BaseType_t;
+typedef unsigned int UBaseType_t;
+typedef uint32_t TickType_t;
+typedef void *TaskHandle_t;
+typedef void *QueueHandle_t;
+typedef void *SemaphoreHandle_t;
+typedef void (*TaskFunction_t)(void *);
+
+#define pdTRUE  1
+#define pdFALSE 0
+#define pdPASS  1
+#define pdFAIL  0
+#define portMAX_DELAY 0xFFFFFFFFUL
+#define portTICK_PERIOD_MS 1
+#define pdMS_TO_TICKS(ms) ((TickType_t)(ms))
+
+inline BaseType_t xTaskCreatePinnedToCore(TaskFunction_t, const char *, uint32_t, void *, UBaseType_t,
+                                          TaskHandle_t *handle, BaseType_t) {
+    if (handle) *handle = nullptr;
+    return pdFAIL;
+}
+inline void vTaskDelete(TaskHandle_t) {}
+
+inline QueueHandle_t xQueueCreate(UBaseType_t, UBaseType_t) { return nullptr; }
+inline BaseType_t xQueueSend(QueueHandle_t, const void *, TickType_t) { return pdFALSE; }
+inline BaseType_t xQueueOverwrite(QueueHandle_t, const void *) { return pdFALSE; }
+inline BaseType_t xQueueReceive(QueueHandle_t, void *, TickType_t) { return pdFALSE; }
+inline UBaseType_t uxQueueMessagesWaiting(QueueHandle_t) { return 0; }
+
+// Critical sections guard data shared between cores; nothing to guard here.
+typedef int portMUX_TYPE;
+#define portMUX_INITIALIZER_UNLOCKED 0
+#define portENTER_CRITICAL(mux) ((void)(mux))
+#define portEXIT_CRITICAL(mux) ((void)(mux))
+
+inline SemaphoreHandle_t xSemaphoreCreateRecursiveMutex() { static int token; return &token; }
+inline BaseType_t xSemaphoreTakeRecursive(SemaphoreHandle_t, TickType_t) { return pdTRUE; }
+inline BaseType_t xSemaphoreGiveRecursive(SemaphoreHandle_t) { return pdTRUE; }
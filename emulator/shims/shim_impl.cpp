@@ -100,14 +100,26 @@ File File::openNextFile() {
 }
 
 // ── File::close ───────────────────────────────────────────────────────────────
+// Text (JSON) files are stored as-is so they stay readable in devtools; files
+// holding binary records are stored base64-encoded behind a "b64:" prefix.
 void File::close() {
     if (_write_mode && _valid) {
+        bool binary = false;
+        for (unsigned char c : _buf) {
+            if (c == 0 || (c < 0x20 && c != '\t' && c != '\n' && c != '\r')) { binary = true; break; }
+        }
         // Persist buffer to localStorage and record the key in the key list.
-        const char* path = _path.c_str();
-        const char* buf  = _buf.c_str();
         EM_ASM({
             var path = UTF8ToString($0);
-            var data = UTF8ToString($1);
+            var data;
+            if ($3) {
+                var bytes = HEAPU8.subarray($1, $1 + $2);
+                var bin = '';
+                for (var i = 0; i < bytes.length; i++) bin += String.fromCharCode(bytes[i]);
+                data = 'b64:' + btoa(bin);
+            } else {
+                data = UTF8ToString($1, $2);
+            }
             var key  = 'spiffs:' + path;
             localStorage.setItem(key, data);
             // Maintain key list
@@ -116,7 +128,7 @@ void File::close() {
                 kl.push(path);
                 localStorage.setItem('spiffs:__keys__', JSON.stringify(kl));
             }
-        }, path, buf);
+        }, _path.c_str(), _buf.data(), (int)_buf.size(), binary ? 1 : 0);
     }
     _valid = false;
     _buf.clear();
@@ -126,6 +138,8 @@ void File::close() {
 // ── SPIFFSClass::open ─────────────────────────────────────────────────────────
 File SPIFFSClass::open(const char* path, const char* mode) {
     bool isWrite = (mode && (mode[0] == 'w' || mode[0] == 'W'));
+    bool isAppend = (mode && mode[0] == 'a');
+    bool isUpdate = (mode && mode[0] && mode[1] == '+');
 
     // Special case: opening the root "/" returns a directory-listing File.
     if (strcmp(path, "/") == 0) {
@@ -138,24 +152,40 @@ File SPIFFSClass::open(const char* path, const char* mode) {
 
     File f;
     f._path       = path;
-    f._write_mode = isWrite;
+    f._write_mode = isWrite || isAppend || isUpdate;
     f._pos        = 0;
 
     if (!isWrite) {
-        // Load existing content from localStorage.
+        // Load existing content from localStorage as [uint32 length][bytes].
         char* data = (char*)EM_ASM_PTR({
             var key  = 'spiffs:' + UTF8ToString($0);
             var val  = localStorage.getItem(key);
             if (val === null) return 0;
-            var len = lengthBytesUTF8(val) + 1;
-            var ptr = _malloc(len);
-            stringToUTF8(val, ptr, len);
+            var ptr;
+            if (val.startsWith('b64:')) {
+                var bin = atob(val.substring(4));
+                ptr = _malloc(bin.length + 4);
+                HEAPU32[ptr >> 2] = bin.length;
+                for (var i = 0; i < bin.length; i++) HEAPU8[ptr + 4 + i] = bin.charCodeAt(i);
+            } else {
+                var len = lengthBytesUTF8(val);
+                ptr = _malloc(len + 5);
+                HEAPU32[ptr >> 2] = len;
+                stringToUTF8(val, ptr + 4, len + 1);
+            }
             return ptr;
         }, path);
 
-        if (!data) { f._valid = false; return f; }
-        f._buf = std::string(data);
-        free(data);
+        if (data) {
+            uint32_t len;
+            memcpy(&len, data, sizeof(len));
+            f._buf.assign(data + 4, len);
+            free(data);
+        } else if (!isAppend) {
+            f._valid = false;
+            return f;
+        }
+        if (isAppend) f._pos = f._buf.size();
     }
     f._valid = true;
     return f;
@@ -12,15 +12,28 @@ extern const float DEFAULT_LOCATION_2_LAT;
 extern const float DEFAULT_LOCATION_2_LON;
 
 // File paths for persistent storage
+extern const char *SETTINGS_FILE;
+extern const char *TIDE_SERIES_FILE;
+extern const char *TIDE_HARMONICS_FILE;
+extern const char *FORECAST_SNAPSHOT_FILE;
+extern const char *GEOCODE_CACHE_FILE;
+extern const char *PROBE_CACHE_FILE;
+extern const char *LOCATION_CACHE_FILE;
+extern const char *HISTORY_FILE;
+
+// Tide state files from older firmware, only deleted now
+extern const char *TIDE_DIRECTION_FILE;
+extern const char *TIDE_BOUNDS_FILE;
+extern const char *TIDE_HOURLY_FILE;
+
+// Per-preference JSON files from older firmware, migrated into SETTINGS_FILE
 extern const char *WIFI_FILE;
 extern const char *LOCATION_FILE;
 extern const char *THEME_FILE;
 extern const char *WAVE_PREF_FILE;
-extern const char *TIDE_DIRECTION_FILE;
-extern const char *TIDE_BOUNDS_FILE;
-extern const char *TIDE_HOURLY_FILE;
 extern const char *PLAYER_NAME_FILE;
 extern const char *DEFAULTS_FILE;
+extern const char *OVERVIEW_FILE;
 
 // TFT Display pins
 #define TFT_CS 15
@@ -42,7 +55,13 @@ extern const char *DEFAULTS_FILE;
 #define TOUCH_MAX_Y 3860
 
 // Timing
-static const uint32_t REFRESH_INTERVAL_MS = 900000; // 15 minutes
+// Longest gap between forecast rebuilds. Rebuilds re-index the cached hourly
+// series locally; each upstream source is refetched only when it is due
+// (see RefreshScheduler.h).
+static const uint32_t FORECAST_REINDEX_INTERVAL_MS = 900000; // 15 minutes
+
+// Harmonic tide prediction vs NOAA's published series: larger gaps are logged
+static const float TIDE_CROSSCHECK_TOLERANCE_M = 0.15f;
 
 // API URLs
 static const char *GEOCODE_URL = "https://geocoding-api.open-meteo.com/v1/search";
@@ -0,0 +1,58 @@
+#ifndef DIAGNOSTICS_H
+#define DIAGNOSTICS_H
+
+#include <Arduino.h>
+
+// Per-stage timing and heap samples for network work, kept in a fixed ring
+// (oldest overwritten) for the Diagnostics screen and printed to Serial as
+// one comma-separated "DIAG," line each:
+//   DIAG,<millis>,<request>,<stage>,<ms>,<bytes>,<http code>,<free before>,<free after>,<max block before>,<max block after>
+enum DiagStage : uint8_t {
+  STAGE_DNS,         // host lookup (pooled clients only)
+  STAGE_TLS,         // TCP connect + TLS handshake (pooled clients only)
+  STAGE_FIRST_BYTE,  // request sent until the status line and headers are in
+  STAGE_BODY,        // waiting on the socket for body bytes
+  STAGE_PARSE,       // JSON parsing (and inflating) of the body
+  STAGE_TOTAL,       // a whole call, e.g. a forecast refresh
+  STAGE_COUNT
+};
+
+static const int DIAG_RING_SIZE = 48;
+
+struct StageSample {
+  uint32_t at;             // millis() when the stage ended
+  char request[14];        // what the stage belongs to, e.g. "marine"
+  DiagStage stage;
+  int16_t httpCode;        // 0 where it does not apply, -1 for a failed DNS/connect
+  uint32_t durationMs;
+  uint32_t bytes;
+  uint32_t freeHeapBefore;
+  uint32_t freeHeapAfter;
+  uint32_t maxBlockBefore;
+  uint32_t maxBlockAfter;
+};
+
+const char *diagStageName(DiagStage stage);
+
+// Times one stage from construction; finish() records it (at most once, and
+// from the destructor if never called). durationMs overrides the measured time
+// for stages that interleave with others, such as body and parse.
+class StageTimer {
+ public:
+  StageTimer(const char *request, DiagStage stage);
+  ~StageTimer() { finish(); }
+  void finish(int httpCode = 0, uint32_t bytes = 0, uint32_t durationMs = UINT32_MAX);
+
+ private:
+  const char *request_;
+  DiagStage stage_;
+  uint32_t start_;
+  uint32_t freeHeap_;
+  uint32_t maxBlock_;
+  bool done_;
+};
+
+// Copy the ring, oldest first, into out (up to max). Returns the count.
+int copyStageSamples(StageSample *out, int max);
+
+#endif // DIAGNOSTICS_H
@@ -3,6 +3,7 @@
 
 #include "Types.h"
 #include <Arduino_GFX_Library.h>
+#include <vector>
 
 // Display hardware
 extern Arduino_DataBus *bus;
@@ -21,8 +22,14 @@ void drawSettingsScreen(Rect &backButton, Rect &forgetButton, Rect &forgetLocati
 void drawForgetButton(Rect &forgetButton, Rect &forgetLocationButton, Rect &themeButton, Rect &waveButton, Rect &tideButton);
 void drawForecast(const LocationInfo &location, const SurfForecast &forecast, 
                   Rect &settingsButton, Rect &badSurfGraphicRect,
-                  float waveHeightThreshold, float minTide, float maxTide, int tideDirection, bool hasTideFile);
+                  float waveHeightThreshold, float minTide, float maxTide, int tideDirection, bool hasTideTrend,
+                  int waveTrend);
+void drawSpotOverview(const std::vector<LocationInfo> &spots, const std::vector<SpotForecast> &forecasts,
+                      float waveHeightThreshold);
+void drawUpdatingIndicator(bool updating);
+void drawForecastAge(time_t fetchedAt);
 void viewFilesScreen(Rect &backButton);
+void viewDiagnosticsScreen(Rect &backButton);
 void drawWelcomeScreen(Rect &setupButton);
 void drawNameConfirmScreen(const String &name, Rect &confirmButton);
 
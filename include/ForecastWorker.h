@@ -0,0 +1,29 @@
+#ifndef FORECAST_WORKER_H
+#define FORECAST_WORKER_H
+
+#include "Types.h"
+#include <vector>
+
+// Start the background forecast task on core 0. If the task cannot be created
+// (e.g. in the emulator), requests are served inline by requestForecast().
+void startForecastWorker();
+
+// Ask for a fresh forecast for the given location. Supersedes any request that
+// has not completed yet; results for older requests are dropped.
+void requestForecast(float latitude, float longitude);
+
+// Ask for the multi-spot overview of up to MAX_OVERVIEW_SPOTS spots. Supersedes
+// pending requests the same way; the result is parallel to spots (empty if no
+// spot could be forecast).
+void requestSpotForecasts(const std::vector<LocationInfo> &spots);
+
+// True while a requested forecast has not been delivered yet.
+bool forecastUpdating();
+
+// Non-blocking: take the newest finished forecast, if any.
+bool pollForecast(SurfForecast &forecast);
+
+// Non-blocking: take the newest finished overview, if any.
+bool pollSpotForecasts(std::vector<SpotForecast> &spots);
+
+#endif // FORECAST_WORKER_H
@@ -0,0 +1,46 @@
+#ifndef HISTORY_H
+#define HISTORY_H
+
+#include "Types.h"
+
+// Conditions at each successful refresh, as fixed 16-byte records in a ring
+// file of HISTORY_CAPACITY slots (32 KB, about three months of hourly
+// refreshes). Appends write one record in place; lookups binary-search the
+// ring by time and read records in blocks. Records are in time order, and
+// each carries a tag of the spot it was taken at.
+static const int HISTORY_CAPACITY = 2048;
+static const uint32_t HISTORY_MIN_SPACING_S = 20UL * 60UL;
+static const int HISTORY_LOOKBACK = 32;
+
+struct HistoryRecord {
+  uint32_t time = 0;           // UTC seconds
+  uint16_t waveHeightCm = 0;
+  uint16_t wavePeriodDs = 0;   // 0.1 s
+  uint16_t windSpeedX10 = 0;   // 0.1 of windSpeed's unit
+  int16_t tideHeightMm = 0;    // above MLLW
+  int8_t tideRateCmH = 0;      // cm per hour, positive = rising
+  uint8_t waveDirection2 = 0;  // degrees / 2
+  uint8_t windDirection2 = 0;  // degrees / 2
+  uint8_t spot = 0;            // historySpotTag() of the location
+};
+
+// A one-byte tag for a location (its ~1 km grid square, hashed). Different
+// spots can share a tag; it only keeps one spot's trend from reading another's.
+uint8_t historySpotTag(float latitude, float longitude);
+
+// Append the forecast for a location. Skipped before NTP sync, when a record
+// for the same spot is less than HISTORY_MIN_SPACING_S old, or out of order.
+bool appendHistory(const LocationInfo &location, const SurfForecast &forecast, time_t at);
+
+// Records with from <= time <= to, oldest first, up to maxRecords. Returns the
+// count.
+int readHistory(uint32_t from, uint32_t to, HistoryRecord *out, int maxRecords);
+
+// The newest record for the location at or before t, looking back at most
+// HISTORY_LOOKBACK records from there.
+bool findHistoryBefore(const LocationInfo &location, uint32_t t, HistoryRecord &out);
+
+int historyCount();
+void clearHistory();
+
+#endif // HISTORY_H
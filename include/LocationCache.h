@@ -0,0 +1,38 @@
+#ifndef LOCATION_CACHE_H
+#define LOCATION_CACHE_H
+
+#include "Types.h"
+
+// What a forecast needs to know about a place before its first request, per
+// grid cell of LOCATION_CELL_DEG: the blend tide stations, the NWS forecast URL
+// and the last forecast series. Kept as a bounded LRU in flash so switching
+// between recent spots, or rebooting, skips the resolution steps.
+static const float LOCATION_CELL_DEG = 0.1f;
+static const int LOCATION_CELL_STATIONS = 3;
+
+struct LocationCell {
+  int16_t latCell = 0;
+  int16_t lonCell = 0;
+  uint32_t storedAt = 0;                               // wall clock of the resolution, 0 = unknown
+  bool stationsResolved = false;                       // stationCount 0 then means "none in range"
+  uint8_t stationCount = 0;
+  char stationId[LOCATION_CELL_STATIONS][10] = {};
+  float stationDistKm[LOCATION_CELL_STATIONS] = {};
+  char nwsForecastUrl[96] = "";                        // "" = not resolved (or outside the US)
+  ForecastSeries series;
+};
+
+// The cell containing a point, from the cache if present (and most recently
+// used from then on), or a blank one for that cell otherwise.
+LocationCell lookupLocationCell(float latitude, float longitude);
+bool sameLocationCell(const LocationCell &cell, float latitude, float longitude);
+
+// Insert or replace the cell at the front. Written to flash by
+// flushLocationCache() only when a cell was added or its contents changed;
+// storing an identical cell just moves it to the front in RAM.
+void storeLocationCell(const LocationCell &cell);
+void flushLocationCache();
+
+void clearLocationCache();
+
+#endif // LOCATION_CACHE_H
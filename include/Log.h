@@ -0,0 +1,139 @@
+#ifndef LOG_H
+#define LOG_H
+
+#include <Arduino.h>
+#include <string.h>
+
+// Printf-style logging that never touches the heap. A call stores the address
+// of its format string and its raw arguments in a RAM ring; logDrain(), called
+// from the main loop, getTouchPoint() and the other UI wait loops, prints each
+// record to Serial as a "#L<hex>" line that decode_log.py expands against the
+// firmware ELF. Built with -DLOG_TEXT (as the emulator is), logDrain() formats
+// the records on the device instead. LOG_DATA records are always formatted on
+// the device.
+//
+// Calls below LOG_LEVEL compile to nothing, arguments included. Formats take
+// the usual conversions (%d %u %x %ld %lu %f %.3f %s %c ...); integers are
+// printed by the type actually passed, so %d fits any integer. Pass String
+// objects as they are; strings are copied up to LOG_MAX_STRING characters.
+#define LOG_LEVEL_DEBUG 0
+#define LOG_LEVEL_INFO 1
+#define LOG_LEVEL_ERROR 2
+#define LOG_LEVEL_NONE 3
+// Machine-readable lines (the DIAG samples): formatted on the device even
+// without LOG_TEXT, printed bare (no level and time prefix), and kept whatever
+// LOG_LEVEL is
+#define LOG_LEVEL_DATA 4
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+static const size_t LOG_RING_BYTES = 4096;
+static const size_t LOG_RECORD_MAX = 192;
+static const size_t LOG_MAX_STRING = 48;
+
+// Record: length, level, millis (4 bytes LE), format address (pointer size,
+// 4 bytes on the ESP32), then per argument a type byte and its value.
+// Strings are a length byte and the characters, without a terminator.
+enum LogArgType : uint8_t {
+  LOG_ARG_I32 = 1,
+  LOG_ARG_U32,
+  LOG_ARG_I64,
+  LOG_ARG_U64,
+  LOG_ARG_F32,
+  LOG_ARG_STR
+};
+
+namespace logdetail {
+
+struct Record {
+  uint8_t data[LOG_RECORD_MAX];
+  size_t len;
+
+  Record(uint8_t level, const char *fmt) : len(2) {
+    data[1] = level;
+    uint32_t ms = millis();
+    put(&ms, sizeof(ms));
+    put(&fmt, sizeof(fmt));
+  }
+  void put(const void *value, size_t n) {
+    if (len + n > sizeof(data)) return;
+    memcpy(data + len, value, n);
+    len += n;
+  }
+  void arg(LogArgType type, const void *value, size_t n) {
+    if (len + 1 + n > sizeof(data)) return;   // arguments past the end are dropped
+    data[len++] = type;
+    put(value, n);
+  }
+};
+
+inline void add(Record &r, int v) { int32_t x = v; r.arg(LOG_ARG_I32, &x, 4); }
+inline void add(Record &r, unsigned v) { uint32_t x = v; r.arg(LOG_ARG_U32, &x, 4); }
+inline void add(Record &r, long long v) { int64_t x = v; r.arg(LOG_ARG_I64, &x, 8); }
+inline void add(Record &r, unsigned long long v) { uint64_t x = v; r.arg(LOG_ARG_U64, &x, 8); }
+inline void add(Record &r, long v) {
+  if (sizeof(long) == 4) add(r, (int)v);
+  else add(r, (long long)v);
+}
+inline void add(Record &r, unsigned long v) {
+  if (sizeof(long) == 4) add(r, (unsigned)v);
+  else add(r, (unsigned long long)v);
+}
+inline void add(Record &r, double v) { float x = (float)v; r.arg(LOG_ARG_F32, &x, 4); }
+inline void add(Record &r, const char *s) {
+  if (!s) s = "(null)";
+  size_t n = strnlen(s, LOG_MAX_STRING);
+  if (r.len + 2 + n > sizeof(r.data)) return;
+  r.data[r.len++] = LOG_ARG_STR;
+  r.data[r.len++] = (uint8_t)n;
+  r.put(s, n);
+}
+inline void add(Record &r, const String &s) { add(r, s.c_str()); }
+
+inline void addAll(Record &) {}
+template <typename T, typename... Rest>
+void addAll(Record &r, const T &first, const Rest &... rest) {
+  add(r, first);
+  addAll(r, rest...);
+}
+
+void commit(Record &r);
+
+}  // namespace logdetail
+
+template <typename... Args>
+void logRecord(uint8_t level, const char *fmt, const Args &... args) {
+  logdetail::Record r(level, fmt);
+  logdetail::addAll(r, args...);
+  logdetail::commit(r);
+}
+
+#if LOG_LEVEL <= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(fmt, ...) logRecord(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_INFO
+#define LOG_INFO(fmt, ...) logRecord(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define LOG_INFO(fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL <= LOG_LEVEL_ERROR
+#define LOG_ERROR(fmt, ...) logRecord(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(fmt, ...) do {} while (0)
+#endif
+
+#define LOG_DATA(fmt, ...) logRecord(LOG_LEVEL_DATA, fmt, ##__VA_ARGS__)
+
+// Print buffered records while Serial can take them without blocking. Only the
+// UI task calls it (any loop that waits on the user or spins should), so it is
+// the only Serial writer after setup() and lines from different tasks never
+// interleave; each line goes out in a single write.
+void logDrain();
+
+#endif // LOG_H
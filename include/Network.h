@@ -8,21 +8,87 @@
 String urlEncode(const String &value);
 
 // WiFi connection
-bool connectWifi(const WifiCredentials &creds);
+bool connectWifi(const WifiCredentials &creds, bool showProgress = true);
+
+// Serialise HTTPS work between the UI and the background forecast task.
+// Recursive; every public network call takes it via NetworkLock.
+void lockNetwork();
+void unlockNetwork();
+
+struct NetworkLock {
+  NetworkLock() { lockNetwork(); }
+  ~NetworkLock() { unlockNetwork(); }
+};
+
+// Close the keep-alive HTTPS sessions pooled during a refresh or search
+void closeHttpConnections();
+
+class HTTPClient;
+
+// Validators from the last 200 response for a resource, kept beside its
+// cached parse. Sent back as If-None-Match / If-Modified-Since so an unchanged
+// resource answers 304 with no body to download or parse.
+struct HttpValidators {
+  String etag;
+  String lastModified;
+};
+
+// Response headers to pass to HTTPClient::collectHeaders() for storeValidators()
+extern const char *VALIDATOR_HEADERS[2];
+// After begin(): add the conditional headers for the cached copy, if any.
+void sendValidators(HTTPClient &http, const HttpValidators &validators);
+// After a 200: keep the response's validators. False if it sent none.
+bool storeValidators(HTTPClient &http, HttpValidators &validators);
+
+// Retry pacing for a repeating operation, polled from loop() instead of
+// delay()ing: each failure doubles the wait from baseMs up to maxMs, with
+// jitter so devices that failed together do not retry together.
+struct RetryBackoff {
+  uint32_t baseMs;
+  uint32_t maxMs;
+  uint8_t failures;
+  uint32_t waitStart;   // millis() when the current wait began
+  uint32_t waitMs;
+
+  RetryBackoff(uint32_t base, uint32_t max) : baseMs(base), maxMs(max), failures(0), waitStart(0), waitMs(0) {}
+};
+
+// Record a failed attempt and schedule the next one. Returns the wait in ms.
+uint32_t backoffAfterFailure(RetryBackoff &backoff);
+// Clear the failure count and schedule the next attempt waitMs from now.
+void backoffReset(RetryBackoff &backoff, uint32_t waitMs);
+// End the current wait early (e.g. on a user tap); failures are kept.
+void backoffRetryNow(RetryBackoff &backoff);
+// True once the scheduled wait has elapsed. Never blocks.
+bool backoffDue(const RetryBackoff &backoff);
+// Milliseconds left in the current wait.
+uint32_t backoffRemainingMs(const RetryBackoff &backoff);
 
 // Location API
 std::vector<LocationInfo> fetchLocationMatches(const String &location, int maxResults = 10);
 LocationInfo fetchLocation(const String &location);
 
-// Marine forecast API
+// Marine forecast API: every source fetched fresh
 SurfForecast fetchSurfForecast(float latitude, float longitude);
+// Rebuild base (a previous result for the same spot) for the current time,
+// refetching only the sources the refresh scheduler reports as due and
+// re-indexing the cached hourly series for the rest.
+SurfForecast updateSurfForecast(const SurfForecast &base, float latitude, float longitude);
 
 // NOAA Tide functions
 String findNearestTideStation(float latitude, float longitude);
-float fetchNOAATideHeight(const String &stationId, float &minTide, float &maxTide);
-void clearTideStationCache();
+float fetchNOAATideHeight(const String &stationId, float &minTide, float &maxTide, float *tideRate = nullptr);
 
 // Location data availability check (for filtering search results)
 bool locationHasData(float lat, float lon);
+// Batched form: one marine API request covers every candidate without a
+// nearby NOAA station. Result is parallel to candidates.
+std::vector<bool> locationsHaveData(const std::vector<LocationInfo> &candidates);
+
+// Multi-spot overview: fill in spots (coordinates set; series and station kept
+// from the previous call) for the current time. One marine request covers every
+// spot whose series is due; tides are computed once per station. Returns true
+// if at least one spot has a forecast.
+bool updateSpotForecasts(std::vector<SpotForecast> &spots);
 
 #endif // NETWORK_H
@@ -0,0 +1,39 @@
+#ifndef REFRESH_SCHEDULER_H
+#define REFRESH_SCHEDULER_H
+
+#include <Arduino.h>
+
+// Upstream sources behind a forecast, each refetched on its own schedule.
+enum ForecastSource : uint8_t {
+  SOURCE_MARINE,   // Open-Meteo marine hourly series
+  SOURCE_WIND,     // NWS grid /forecast periods
+  SOURCE_TIDE,     // NOAA prediction series for the day (cross-check)
+  SOURCE_COUNT
+};
+
+const char *forecastSourceName(ForecastSource source);
+
+// Record a successful fetch. freshForMs comes from the response's
+// Cache-Control/Expires headers, or 0 to use the source's known update times.
+void markSourceFetched(ForecastSource source, uint32_t freshForMs);
+
+// Record a failed fetch; the source is retried after a short delay rather
+// than on every pass.
+void markSourceFailed(ForecastSource source);
+
+// Force every source to be fetched on the next update (e.g. a new spot).
+void markAllSourcesStale();
+
+bool sourceStale(ForecastSource source);
+
+// Milliseconds until a source is due (0 when stale). For diagnostics.
+uint32_t sourceDueInMs(ForecastSource source);
+
+// Milliseconds until the forecast should next be rebuilt: the earliest source
+// due time, or FORECAST_REINDEX_INTERVAL_MS if a local re-index comes sooner.
+uint32_t nextForecastUpdateMs();
+
+// One Serial line with each source's next due time.
+void logRefreshSchedule();
+
+#endif // REFRESH_SCHEDULER_H
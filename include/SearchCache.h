@@ -0,0 +1,23 @@
+#ifndef SEARCH_CACHE_H
+#define SEARCH_CACHE_H
+
+#include "Types.h"
+#include <vector>
+
+// Bounded LRU caches for location search, kept in flash so repeat searches and
+// fuzzy retries need no network. Entries expire after a TTL once NTP has synced.
+
+// Geocoding results keyed by the normalised query. A hit requires the cached
+// lookup to have asked for at least maxResults (or to have returned fewer).
+bool lookupGeocodeCache(const String &query, int maxResults, std::vector<LocationInfo> &results);
+void storeGeocodeCache(const String &query, int maxResults, const std::vector<LocationInfo> &results);
+
+// Marine "has data" verdicts keyed by coordinates rounded to 0.01°.
+// Returns 1 (has data), 0 (no data) or -1 (not cached).
+int lookupProbeCache(float latitude, float longitude);
+void storeProbeCache(float latitude, float longitude, bool hasData);
+void flushProbeCache();   // write stored verdicts to flash, once per batch
+
+void clearSearchCache();
+
+#endif // SEARCH_CACHE_H
@@ -2,12 +2,40 @@
 #define STORAGE_H
 
 #include "Types.h"
+#include <FS.h>
 #include <time.h>
 #include <vector>
 
-// Logging functions
-void logInfo(const String &message);
-void logError(const String &message);
+// Filesystem backend, used through STORAGE_FS everywhere. LittleFS on the
+// device; builds with -DSTORAGE_SPIFFS (the emulator, whose SPIFFS shim keeps
+// files in localStorage) use SPIFFS.
+#ifdef STORAGE_SPIFFS
+#include <SPIFFS.h>
+#define STORAGE_FS SPIFFS
+#else
+#include <LittleFS.h>
+#define STORAGE_FS LittleFS
+#endif
+
+// Mounts the filesystem, once at boot. The first LittleFS boot after SPIFFS
+// firmware copies the old files across (both use the same partition), and any
+// replacement cut short by a power loss is rolled back or finished. Returns
+// false if nothing could be mounted.
+bool beginStorage();
+
+// Whole-file replacement: openReplace() opens a temp file beside path, and
+// commitReplace() closes it and, when ok, renames it over path. A power cut
+// at any point leaves either the old file or the new one, never half of each.
+File openReplace(const char *path);
+bool commitReplace(File &f, const char *path, bool ok = true);
+
+// Preferences (Wi-Fi, theme, overview, wave height, location, player name,
+// default locations) share one CRC-checked binary record, loaded once on first
+// use and kept in RAM. Per-preference JSON files from older firmware are
+// migrated into it automatically.
+
+// True once any of Wi-Fi, location, theme or wave height has been saved
+bool haveSavedPreferences();
 
 // WiFi credentials storage
 bool saveWifiCredentials(const WifiCredentials &creds);
@@ -19,9 +47,15 @@ bool saveThemePreference(bool isDark);
 bool loadThemePreference();
 void deleteThemePreference();
 
+// Multi-spot overview preference storage
+bool saveOverviewPreference(bool enabled);
+bool loadOverviewPreference();
+void deleteOverviewPreference();
+
 // Wave height preference storage
 bool saveWaveHeightPreference(float threshold);
 float loadWaveHeightPreference();
+bool haveWaveHeightPreference();
 void deleteWaveHeightPreference();
 
 // Surf location storage
@@ -29,20 +63,40 @@ bool saveSurfLocation(const LocationInfo &locInfo);
 LocationInfo loadSurfLocationInfo();
 void deleteSurfLocation();
 
-// Tide direction storage
-bool saveTideDirection(float tideHeightOneHourAgo, time_t tideDirectionTimestamp, int currentTideDirection);
-void loadTideDirection(float &tideHeightOneHourAgo, time_t &tideDirectionTimestamp, int &currentTideDirection);
-void deleteTideDirection();
+// The forecast snapshot is written behind: saves update RAM and
+// flushStateFiles(), called from the main loop, writes a change once it is two
+// hours old (or at once when forced). The first save after boot and any
+// material change to the forecast values skip the wait; only a newer fetch
+// time waits. A shutdown hook flushes before esp_restart().
+void flushStateFiles(bool force = false);
+
+struct StateFileStats {
+  const char *path;
+  uint32_t saves;    // save calls since boot
+  uint32_t writes;   // flash writes since boot
+  bool dirty;        // holding a change not yet on flash
+};
+int copyStateFileStats(StateFileStats *out, int max);
+
+// Removes the tide direction, tide bounds and hourly baseline files older
+// firmware kept
+void deleteLegacyTideFiles();
+
+// Tide prediction series storage (a week of highs and lows per station,
+// binary, a few stations per file)
+bool saveTideSeries(const TideSeries &series);
+bool loadTideSeries(const char *stationId, TideSeries &series);
+void deleteTideSeries();
 
-// Tide bounds storage (daily min/max)
-bool saveTideBounds(float minTide, float maxTide, const String &date);
-bool loadTideBounds(float &minTide, float &maxTide, String &date);
-void deleteTideBounds();
+// Tide harmonic constants storage (binary, a handful of stations per file)
+bool saveTideHarmonics(const TideHarmonics &harmonics);
+bool loadTideHarmonics(const char *stationId, TideHarmonics &harmonics);
+void deleteTideHarmonics();
 
-// Hourly tide tracking storage
-bool saveTideHourlyCheck(float startHeight, time_t startTime, int hour);
-bool loadTideHourlyCheck(float &startHeight, time_t &startTime, int &hour);
-void deleteTideHourlyCheck();
+// Last successful forecast, shown at boot before the network is up
+bool saveForecastSnapshot(const LocationInfo &location, const SurfForecast &forecast, time_t fetchedAt);
+bool loadForecastSnapshot(LocationInfo &location, SurfForecast &forecast, time_t &fetchedAt);
+void deleteForecastSnapshot();
 
 // Player name storage
 bool savePlayerName(const String &name);
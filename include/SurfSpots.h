@@ -0,0 +1,22 @@
+#ifndef SURF_SPOTS_H
+#define SURF_SPOTS_H
+
+#include "Types.h"
+#include "TideStations.h"
+#include <vector>
+
+// Up to maxResults catalogued surf spots and saved locations (e.g. from
+// loadDefaultLocations()) matching a partial query, best match first. Saved
+// locations come ahead of catalog entries. Local lookup only.
+std::vector<LocationInfo> suggestLocations(const String &query, const std::vector<LocationInfo> &saved, int maxResults);
+
+// Resolves a query to one location without the network: an exact
+// (case-insensitive) name match, or a spot name shared by no other entry.
+bool resolveLocalLocation(const String &query, const std::vector<LocationInfo> &saved, LocationInfo &result);
+
+// Precomputed NOAA blend stations for a catalogued spot at these coordinates,
+// nearest first. Returns how many were filled, or -1 if the point is not a
+// catalogued spot.
+int surfSpotTideStations(float latitude, float longitude, TideStationMatch *matches, int maxMatches);
+
+#endif // SURF_SPOTS_H
@@ -0,0 +1,22 @@
+#ifndef TIDE_PREDICTOR_H
+#define TIDE_PREDICTOR_H
+
+#include "Types.h"
+
+// Index of a NOAA constituent name (e.g. "M2") in the predictor's table,
+// or -1 if the predictor does not model it.
+int tideConstituentIndex(const char *name);
+
+// Predicted height (m above MLLW) at a UTC time.
+float predictTideHeight(const TideHarmonics &harmonics, time_t t);
+
+// Rate of change (m per hour, positive = rising) at a UTC time.
+float predictTideRate(const TideHarmonics &harmonics, time_t t);
+
+// Highs and lows during the UTC day containing t. Fills up to maxEvents
+// (events may be nullptr) and the day's min/max height. Returns the number
+// of events found.
+int predictTideDay(const TideHarmonics &harmonics, time_t t, TideEvent *events, int maxEvents,
+                   float &minTide, float &maxTide);
+
+#endif // TIDE_PREDICTOR_H
@@ -0,0 +1,21 @@
+#ifndef TIDE_STATIONS_H
+#define TIDE_STATIONS_H
+
+#include <stdint.h>
+
+struct TideStationMatch {
+  const char *id;
+  const char *name;
+  float distKm;
+};
+
+// Nearest distinct NOAA tide stations within maxKm of a point, nearest first.
+// Fills up to maxMatches entries and returns how many were found. Local table
+// lookup only; only the latitude bands within maxKm are scanned.
+int findNearestTideStations(float latitude, float longitude, float maxKm, TideStationMatch *matches, int maxMatches);
+
+// Station of one table point, for tables precomputed against the point list
+// (see SurfSpots.cpp). Returns false if the index is out of range.
+bool tideStationAtPoint(int pointIndex, TideStationMatch &match);
+
+#endif // TIDE_STATIONS_H
@@ -17,7 +17,8 @@ bool pointInRect(int16_t x, int16_t y, const Rect &r);
 TouchPoint getTouchPoint();
 
 // UI interaction functions
-String touchKeyboardInput(const String &title, const String &initial, bool secret);
+// suggestSpots lists matching surf spots and saved locations under the keys
+String touchKeyboardInput(const String &title, const String &initial, bool secret, bool suggestSpots = false);
 WifiCredentials runWifiSetupTouch();
 String runLocationSetupTouch(LocationInfo &cachedLocation);
 float runWaveHeightSetupTouch();
@@ -26,7 +27,7 @@ int selectLocationFromList(const std::vector<LocationInfo> &locations);
 LocationInfo selectDefaultLocation();
 
 // Main screen touch handling
-int handleMainScreenTouch(const Rect &settingsButton, const Rect &badSurfGraphicRect);
+int handleMainScreenTouch(const Rect &settingsButton, const Rect &badSurfGraphicRect, const Rect &spotTitleRect);
 int handleSettingsScreenTouch(const Rect &backButton, const Rect &forgetButton, const Rect &forgetLocationButton, 
                               const Rect &themeButton, const Rect &waveButton, const Rect &tideButton, const Rect &filesButton,
                               const Rect &leaderboardButton,
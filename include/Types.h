@@ -2,6 +2,7 @@
 #define TYPES_H
 
 #include <Arduino.h>
+#include <time.h>
 
 struct LocationInfo {
   float latitude = 0.0f;
@@ -10,6 +11,23 @@ struct LocationInfo {
   bool valid = false;
 };
 
+// Hourly marine and wind samples from one fetch, kept in fixed point (~220
+// bytes a day) so the current hour can be re-derived without a download.
+// Sample i is for start + i hours, UTC.
+static const int FORECAST_SERIES_HOURS = 24;
+
+struct ForecastSeries {
+  time_t start = 0;
+  uint8_t count = 0;
+  bool hasWind = false;                                  // NWS periods were merged in
+  uint16_t waveHeightCm[FORECAST_SERIES_HOURS] = {};
+  uint16_t wavePeriodDs[FORECAST_SERIES_HOURS] = {};     // 0.1 s
+  uint16_t waveDirectionDeg[FORECAST_SERIES_HOURS] = {};
+  uint16_t windSpeedX10[FORECAST_SERIES_HOURS] = {};     // 0.1 of windSpeed's unit
+  uint16_t windDirectionDeg[FORECAST_SERIES_HOURS] = {};
+  bool valid = false;
+};
+
 struct SurfForecast {
   float waveHeight = 0.0f;
   float wavePeriod = 0.0f;
@@ -17,12 +35,75 @@ struct SurfForecast {
   float windSpeed = 0.0f;
   float windDirection = 0.0f;
   float tideHeight = 0.0f;
+  float tideRate = 0.0f;   // m per hour from the prediction curve, positive = rising
   float minTide = 0.0f;
   float maxTide = 0.0f;
   String timeLabel = "";
+  ForecastSeries series;
+  bool valid = false;
+};
+
+// One row of the multi-spot overview: the spot's wave series (no wind) from the
+// batched marine request, the values for now sampled from it, and the tide at
+// its nearest NOAA station (shared with other spots on the same station).
+static const int MAX_OVERVIEW_SPOTS = 5;
+
+struct SpotForecast {
+  float latitude = 0.0f;
+  float longitude = 0.0f;
+  char stationId[10] = "";
+  ForecastSeries series;
+  float waveHeight = 0.0f;
+  float wavePeriod = 0.0f;
+  float waveDirection = 0.0f;
+  float tideHeight = 0.0f;
+  float tideRate = 0.0f;   // m per hour, positive = rising
+  bool hasTide = false;
   bool valid = false;
 };
 
+// NOAA high/low tide predictions for a station over about a week, starting the
+// UTC day before the download. The curve between consecutive extremes is
+// rebuilt locally by cosine interpolation.
+static const int TIDE_SERIES_DAYS = 8;
+static const int TIDE_SERIES_EVENTS = 40;   // ~4 a day, with room for mixed tides
+
+struct TideSeries {
+  char stationId[10] = "";
+  uint32_t start = 0;                         // UTC midnight the window begins
+  uint8_t count = 0;                          // extremes filled, in time order
+  uint16_t minute[TIDE_SERIES_EVENTS] = {};   // of each extreme, from start
+  int16_t heightMm[TIDE_SERIES_EVENTS] = {};  // MLLW datum
+  bool valid = false;
+};
+
+// Harmonic constants for a station, provisioned once from NOAA's metadata API.
+// A valid record with count 0 marks a station without harmonic constants
+// (subordinate stations) so it is not requested again.
+static const int TIDE_MAX_CONSTITUENTS = 24;
+
+struct TideConstituent {
+  uint8_t index = 0;           // into the predictor's constituent table
+  uint8_t reserved = 0;
+  uint16_t amplitudeMm = 0;
+  uint16_t phaseCentiDeg = 0;  // Greenwich phase lag (kappa), 0.01 degree units
+};
+
+struct TideHarmonics {
+  char stationId[10] = "";
+  int16_t mslMm = 0;           // mean sea level above MLLW
+  uint8_t count = 0;
+  TideConstituent constituents[TIDE_MAX_CONSTITUENTS];
+  bool valid = false;
+};
+
+// A high or low water turning point of the predicted curve
+struct TideEvent {
+  time_t time = 0;
+  float height = 0.0f;         // m above MLLW
+  bool high = false;
+};
+
 struct WifiCredentials {
   String ssid;
   String password;
@@ -9,12 +9,25 @@ const float DEFAULT_LOCATION_2_LAT = 30.3268f;
 const float DEFAULT_LOCATION_2_LON = -81.3836f;
 
 // File paths for persistent storage
+const char *SETTINGS_FILE = "/settings.bin";
+const char *TIDE_SERIES_FILE = "/tide_series.bin";
+const char *TIDE_HARMONICS_FILE = "/tide_harmonics.bin";
+const char *FORECAST_SNAPSHOT_FILE = "/forecast_snapshot.json";
+const char *GEOCODE_CACHE_FILE = "/geocode_cache.bin";
+const char *PROBE_CACHE_FILE = "/probe_cache.bin";
+const char *LOCATION_CACHE_FILE = "/location_cache.bin";
+const char *HISTORY_FILE = "/history.bin";
+
+// Tide state files from older firmware, only deleted now
+const char *TIDE_DIRECTION_FILE = "/tide_direction.json";
+const char *TIDE_BOUNDS_FILE = "/tide_bounds.json";
+const char *TIDE_HOURLY_FILE = "/tide_hourly.json";
+
+// Per-preference JSON files from older firmware, migrated into SETTINGS_FILE
 const char *WIFI_FILE = "/wifi.json";
 const char *LOCATION_FILE = "/location.json";
 const char *THEME_FILE = "/theme.json";
 const char *WAVE_PREF_FILE = "/wave_pref.json";
-const char *TIDE_DIRECTION_FILE = "/tide_direction.json";
-const char *TIDE_BOUNDS_FILE = "/tide_bounds.json";
-const char *TIDE_HOURLY_FILE = "/tide_hourly.json";
 const char *PLAYER_NAME_FILE = "/player_name.json";
-const char *DEFAULTS_FILE    = "/defaults.json";
+const char *DEFAULTS_FILE = "/defaults.json";
+const char *OVERVIEW_FILE = "/overview.json";
@@ -1,53 +1,103 @@
 #include "Database.h"
 #include "Storage.h"
+#include "Network.h"
+#include "Diagnostics.h"
+#include "Log.h"
 #include <HTTPClient.h>
 #include <WiFi.h>
 #include <ArduinoJson.h>
 
 static const char *API_BASE = "https://surf-board-api-production.up.railway.app";
 
-// Fetch the top-scoring record (GET /records returns rows ordered by score DESC).
-GlobalHighScore fetchGlobalHighScore() {
-  GlobalHighScore result;
+// GET /records returns rows ordered by score DESC. The top 10 are kept with the
+// response's validators; most requests only revalidate them, and a 304 reuses
+// the parsed rows without downloading or parsing the body.
+static Leaderboard cachedRecords;
+static HttpValidators recordsValidators;
+
+static bool fetchRecords(Leaderboard &result, const char *caller) {
   if (WiFi.status() != WL_CONNECTED) {
-    logError("fetchGlobalHighScore: WiFi not connected");
-    return result;
+    LOG_ERROR("%s: WiFi not connected", caller);
+    return false;
   }
 
+  // Not pooled: DNS and the TLS handshake fall inside the first-byte stage
+  StageTimer total("db-records", STAGE_TOTAL);
   HTTPClient http;
   http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
   http.begin(String(API_BASE) + "/records");
   http.setTimeout(10000);
+  http.collectHeaders(VALIDATOR_HEADERS, 2);
+  bool conditional = cachedRecords.valid;
+  if (conditional) sendValidators(http, recordsValidators);
+  StageTimer firstByte("db-records", STAGE_FIRST_BYTE);
   int code = http.GET();
+  firstByte.finish(code);
 
+  if (code == HTTP_CODE_NOT_MODIFIED && conditional) {
+    http.end();
+    result = cachedRecords;
+    return true;
+  }
   if (code == HTTP_CODE_OK) {
+    HttpValidators validators;
+    bool validated = storeValidators(http, validators);
+    StageTimer bodyTimer("db-records", STAGE_BODY);
     String payload = http.getString();
+    bodyTimer.finish(code, payload.length());
+    StageTimer parseTimer("db-records", STAGE_PARSE);
     DynamicJsonDocument doc(4096);
-    if (!deserializeJson(doc, payload)) {
+    DeserializationError err = deserializeJson(doc, payload);
+    parseTimer.finish(err ? -1 : 0, payload.length());
+    if (!err) {
       JsonArray arr = doc.as<JsonArray>();
-      if (!arr.isNull() && arr.size() > 0) {
-        result.name  = arr[0]["name"].as<String>();
-        result.score = arr[0]["score"] | 0UL;
+      if (!arr.isNull()) {
+        result = Leaderboard();
+        for (JsonVariant entry : arr) {
+          if (result.count >= 10) break;
+          result.entries[result.count].rank  = result.count + 1;
+          result.entries[result.count].name  = entry["name"].as<String>();
+          result.entries[result.count].score = entry["score"] | 0UL;
+          result.count++;
+        }
         result.valid = true;
-        logInfo("Global high score: " + result.name + " - " + String(result.score));
+        cachedRecords = validated ? result : Leaderboard();
+        recordsValidators = validators;
       }
     } else {
-      logError("fetchGlobalHighScore: JSON parse failed");
+      LOG_ERROR("%s: JSON parse failed", caller);
     }
   } else {
-    logError("fetchGlobalHighScore: HTTP " + String(code));
+    LOG_ERROR("%s: HTTP %d", caller, code);
   }
 
   http.end();
+  total.finish(result.valid ? code : -1);
+  return result.valid;
+}
+
+// Fetch the top-scoring record.
+GlobalHighScore fetchGlobalHighScore() {
+  NetworkLock lock;
+  GlobalHighScore result;
+  Leaderboard records;
+  if (fetchRecords(records, "fetchGlobalHighScore") && records.count > 0) {
+    result.name  = records.entries[0].name;
+    result.score = records.entries[0].score;
+    result.valid = true;
+    LOG_INFO("Global high score: %s - %u", result.name, result.score);
+  }
   return result;
 }
 
 // Submit a new record (POST /records). Returns "" on success or error message on failure.
 String submitRecord(const String &name, unsigned long score) {
+  NetworkLock lock;
   if (WiFi.status() != WL_CONNECTED) {
     return "No WiFi connection";
   }
 
+  StageTimer total("db-submit", STAGE_TOTAL);
   HTTPClient http;
   http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
   http.begin(String(API_BASE) + "/records");
@@ -60,11 +110,13 @@ String submitRecord(const String &name, unsigned long score) {
   String payload;
   serializeJson(body, payload);
 
+  StageTimer firstByte("db-submit", STAGE_FIRST_BYTE);
   int code = http.POST(payload);
+  firstByte.finish(code, payload.length());
   String errorMsg = "";
 
   if (code == HTTP_CODE_OK || code == HTTP_CODE_CREATED) {
-    logInfo("Record submitted: " + name + " - " + String(score));
+    LOG_INFO("Record submitted: %s - %u", name, score);
   } else {
     // Try to extract an error message from the response body
     String resp = http.getString();
@@ -74,50 +126,20 @@ String submitRecord(const String &name, unsigned long score) {
     } else {
       errorMsg = "HTTP " + String(code);
     }
-    logError("submitRecord failed: " + errorMsg);
+    LOG_ERROR("submitRecord failed: %s", errorMsg);
   }
 
   http.end();
+  total.finish(code);
   return errorMsg;
 }
 
 // Fetch all records ordered by score DESC, return up to 10 as a Leaderboard.
 Leaderboard fetchLeaderboard() {
+  NetworkLock lock;
   Leaderboard result;
-  if (WiFi.status() != WL_CONNECTED) {
-    logError("fetchLeaderboard: WiFi not connected");
-    return result;
+  if (fetchRecords(result, "fetchLeaderboard")) {
+    LOG_INFO("Leaderboard fetched: %d entries", result.count);
   }
-
-  HTTPClient http;
-  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-  http.begin(String(API_BASE) + "/records");
-  http.setTimeout(10000);
-  int code = http.GET();
-
-  if (code == HTTP_CODE_OK) {
-    String payload = http.getString();
-    DynamicJsonDocument doc(4096);
-    if (!deserializeJson(doc, payload)) {
-      JsonArray arr = doc.as<JsonArray>();
-      if (!arr.isNull()) {
-        for (JsonVariant entry : arr) {
-          if (result.count >= 10) break;
-          result.entries[result.count].rank  = result.count + 1;
-          result.entries[result.count].name  = entry["name"].as<String>();
-          result.entries[result.count].score = entry["score"] | 0UL;
-          result.count++;
-        }
-        result.valid = true;
-        logInfo("Leaderboard fetched: " + String(result.count) + " entries");
-      }
-    } else {
-      logError("fetchLeaderboard: JSON parse failed");
-    }
-  } else {
-    logError("fetchLeaderboard: HTTP " + String(code));
-  }
-
-  http.end();
   return result;
 }
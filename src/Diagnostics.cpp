@@ -0,0 +1,63 @@
+#include "Diagnostics.h"
+#include "Log.h"
+#include <freertos/FreeRTOS.h>
+
+// Written by whichever context serves the request (usually the forecast task
+// on core 0) and read by the UI, so the ring is guarded by a spinlock. The
+// DIAG line goes through the log ring, so it reaches Serial from logDrain()
+// on the UI task and never lands inside another line.
+
+static StageSample ring[DIAG_RING_SIZE];
+static int ringNext = 0;
+static int ringCount = 0;
+static portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+
+static const char *STAGE_NAMES[STAGE_COUNT] = {"dns", "tls", "ttfb", "body", "parse", "total"};
+
+const char *diagStageName(DiagStage stage) {
+  return stage < STAGE_COUNT ? STAGE_NAMES[stage] : "?";
+}
+
+static void recordStage(const StageSample &sample) {
+  portENTER_CRITICAL(&ringMux);
+  ring[ringNext] = sample;
+  ringNext = (ringNext + 1) % DIAG_RING_SIZE;
+  if (ringCount < DIAG_RING_SIZE) ringCount++;
+  portEXIT_CRITICAL(&ringMux);
+
+  LOG_DATA("DIAG,%lu,%s,%s,%lu,%lu,%d,%lu,%lu,%lu,%lu", (unsigned long)sample.at, sample.request,
+           diagStageName(sample.stage), (unsigned long)sample.durationMs, (unsigned long)sample.bytes,
+           sample.httpCode, (unsigned long)sample.freeHeapBefore, (unsigned long)sample.freeHeapAfter,
+           (unsigned long)sample.maxBlockBefore, (unsigned long)sample.maxBlockAfter);
+}
+
+StageTimer::StageTimer(const char *request, DiagStage stage)
+    : request_(request), stage_(stage), start_(millis()), freeHeap_(ESP.getFreeHeap()),
+      maxBlock_(ESP.getMaxAllocHeap()), done_(false) {}
+
+void StageTimer::finish(int httpCode, uint32_t bytes, uint32_t durationMs) {
+  if (done_) return;
+  done_ = true;
+  StageSample sample;
+  sample.at = millis();
+  strncpy(sample.request, request_ ? request_ : "", sizeof(sample.request) - 1);
+  sample.request[sizeof(sample.request) - 1] = '\0';
+  sample.stage = stage_;
+  sample.httpCode = (int16_t)httpCode;
+  sample.durationMs = durationMs == UINT32_MAX ? sample.at - start_ : durationMs;
+  sample.bytes = bytes;
+  sample.freeHeapBefore = freeHeap_;
+  sample.freeHeapAfter = ESP.getFreeHeap();
+  sample.maxBlockBefore = maxBlock_;
+  sample.maxBlockAfter = ESP.getMaxAllocHeap();
+  recordStage(sample);
+}
+
+int copyStageSamples(StageSample *out, int max) {
+  portENTER_CRITICAL(&ringMux);
+  int n = ringCount < max ? ringCount : max;
+  int first = (ringNext - n + DIAG_RING_SIZE) % DIAG_RING_SIZE;
+  for (int i = 0; i < n; i++) out[i] = ring[(first + i) % DIAG_RING_SIZE];
+  portEXIT_CRITICAL(&ringMux);
+  return n;
+}
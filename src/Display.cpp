@@ -2,7 +2,9 @@
 #include "Config.h"
 #include "Theme.h"
 #include "TouchUI.h"
-#include <SPIFFS.h>
+#include "Diagnostics.h"
+#include "Log.h"
+#include "Storage.h"
 #include <FS.h>
 #include <ArduinoJson.h>
 #include <vector>
@@ -155,6 +157,14 @@ void drawDirectionArrow(int16_t cx, int16_t cy, int16_t length, float degrees, u
   gfx->drawLine(endX, endY, rightX, rightY, color);
 }
 
+static const char *degreesToCardinal(float deg) {
+  while (deg < 0.0f) deg += 360.0f;
+  while (deg >= 360.0f) deg -= 360.0f;
+  int idx = (int)((deg + 22.5f) / 45.0f) % 8;
+  static const char *dirs[] = {"N", "NE", "E", "SE", "S", "SW", "W", "NW"};
+  return dirs[idx];
+}
+
 void drawForgetButton(Rect &forgetButton, Rect &forgetLocationButton, Rect &themeButton, Rect &waveButton, Rect &tideButton) {
   // 2x3 grid layout in top right (added tide button below wave)
   int btnW = 48;  // 30% skinnier than original 68
@@ -249,8 +259,9 @@ void drawSettingsScreen(Rect &backButton, Rect &forgetButton, Rect &forgetLocati
 
 void drawForecast(const LocationInfo &location, const SurfForecast &forecast, 
                   Rect &settingsButton, Rect &badSurfGraphicRect,
-                  float waveHeightThreshold, float minTide, float maxTide, int tideDirection, bool hasTideFile) {
-  Serial.printf("[DISPLAY] drawForecast: tideH=%.3fm (%.2fft), min=%.3fm (%.2fft), max=%.3fm (%.2fft), dir=%d\n",
+                  float waveHeightThreshold, float minTide, float maxTide, int tideDirection, bool hasTideTrend,
+                  int waveTrend) {
+  LOG_DEBUG("[DISPLAY] drawForecast: tideH=%.3fm (%.2fft), min=%.3fm (%.2fft), max=%.3fm (%.2fft), dir=%d",
     forecast.tideHeight, forecast.tideHeight * 3.28084f,
     minTide, minTide * 3.28084f,
     maxTide, maxTide * 3.28084f,
@@ -262,6 +273,10 @@ void drawForecast(const LocationInfo &location, const SurfForecast &forecast,
   gfx->setTextSize(3);
   gfx->setCursor(10, 10);
   gfx->println("Surf spot");
+  // The title opens the multi-spot overview (see handleMainScreenTouch)
+  gfx->setTextSize(1);
+  gfx->setCursor(183, 13);
+  gfx->print("all spots >");
 
   gfx->setTextColor(currentTheme.text);
   gfx->setTextSize(4);
@@ -285,6 +300,13 @@ void drawForecast(const LocationInfo &location, const SurfForecast &forecast,
   gfx->setTextSize(3);
   gfx->setCursor(20, 86);
   gfx->println("Wave height");
+  // Building or dropping since a few hours ago (see setWaveTrendFromHistory)
+  if (waveTrend != 0) {
+    int16_t ax = 20 + 11 * 18 + 16;
+    int16_t ay = 86 + 10;
+    if (waveTrend > 0) gfx->fillTriangle(ax, ay - 8, ax - 7, ay + 5, ax + 7, ay + 5, currentTheme.accent);
+    else gfx->fillTriangle(ax, ay + 8, ax - 7, ay - 5, ax + 7, ay - 5, currentTheme.accent);
+  }
 
   float waveHeightFeet = forecast.waveHeight * 3.28084f;
   gfx->setTextColor(currentTheme.text);
@@ -339,13 +361,6 @@ void drawForecast(const LocationInfo &location, const SurfForecast &forecast,
   drawDirectionArrow(windCenterX, arrowY, 42, forecast.windDirection + 180.0f, windArrowColor);
 
   // Cardinal direction labels below each arrow
-  auto degreesToCardinal = [](float deg) -> const char* {
-    while (deg < 0.0f) deg += 360.0f;
-    while (deg >= 360.0f) deg -= 360.0f;
-    int idx = (int)((deg + 22.5f) / 45.0f) % 8;
-    const char* dirs[] = {"N", "NE", "E", "SE", "S", "SW", "W", "NW"};
-    return dirs[idx];
-  };
   const char* swellCardinal = degreesToCardinal(forecast.waveDirection);
   const char* windCardinal  = degreesToCardinal(forecast.windDirection);
   gfx->setTextSize(1);
@@ -369,7 +384,7 @@ void drawForecast(const LocationInfo &location, const SurfForecast &forecast,
   // Check if tide data is unavailable (all zero)
   bool tideUnavailable = (forecast.tideHeight == 0.0f && minTide == 0.0f && maxTide == 0.0f);
   if (tideUnavailable) {
-    Serial.println("[DISPLAY] Tide data unavailable: tideHeight, minTide, and maxTide are all 0");
+    LOG_DEBUG("[DISPLAY] Tide data unavailable: tideHeight, minTide, and maxTide are all 0");
   }
 
   // Normalise current position within today's low→high range (0=low, 1=high)
@@ -416,10 +431,10 @@ void drawForecast(const LocationInfo &location, const SurfForecast &forecast,
     gfx->setCursor(tideX - 14, tideBarY + tideBarH + 14);
     gfx->print("not avail.");
   } else {
-    // Direction arrow — only drawn if the tide snapshot file exists.
+    // Direction arrow — only drawn when the forecast has a tide curve.
     // Black in dark mode, white in light mode (WHITE/BLACK constants are stored
     // pre-inverted for hardware, so they render correctly on screen).
-    if (hasTideFile) {
+    if (hasTideTrend) {
       int16_t arrowCX = tideX + (tideBarW / 2);
       int16_t arrowSz = 5;
       uint16_t arrowCol = darkMode ? BLACK : WHITE;
@@ -461,138 +476,318 @@ void drawForecast(const LocationInfo &location, const SurfForecast &forecast,
   drawSettingsButton(settingsButton);
 }
 
-void viewFilesScreen(Rect &backButton) {
-  // Collect all file info first
-  struct FileInfo {
-    String name;
-    String content;
-  };
-  
-  std::vector<FileInfo> files;
-  File root = SPIFFS.open("/");
-  File file = root.openNextFile();
-  
-  while (file) {
-    FileInfo info;
-    info.name = String(file.name());
-    info.content = "";
-    while (file.available() && info.content.length() < 500) {
-      info.content += (char)file.read();
+// Multi-spot overview: one row per spot with waves (coloured against the
+// threshold), period, swell direction and tide. Any tap returns to the single
+// spot screen.
+void drawSpotOverview(const std::vector<LocationInfo> &spots, const std::vector<SpotForecast> &forecasts,
+                      float waveHeightThreshold) {
+  gfx->fillScreen(currentTheme.background);
+  gfx->setTextColor(currentTheme.textSecondary);
+  gfx->setTextSize(3);
+  gfx->setCursor(10, 10);
+  gfx->print("All spots");
+  gfx->setTextSize(1);
+  gfx->setCursor(183, 13);
+  gfx->print("< tap for one spot");
+
+  const int16_t headerY = 44;
+  const int16_t rowY = 58;
+  const int16_t rowH = 52;
+  const int16_t waveX = 220;
+  const int16_t periodX = 320;
+  const int16_t tideX = 395;
+  gfx->setCursor(10, headerY);
+  gfx->print("Spot");
+  gfx->setCursor(waveX, headerY);
+  gfx->print("Waves");
+  gfx->setCursor(periodX, headerY);
+  gfx->print("Period");
+  gfx->setCursor(tideX, headerY);
+  gfx->print("Tide");
+
+  for (size_t i = 0; i < spots.size() && i < (size_t)MAX_OVERVIEW_SPOTS; i++) {
+    int16_t y = rowY + (int16_t)i * rowH;
+    if (i > 0) gfx->drawFastHLine(10, y - 6, gfx->width() - 20, currentTheme.textSecondary);
+
+    String name = spots[i].displayName;
+    int comma = name.indexOf(',');
+    if (comma > 0) name = name.substring(0, comma);
+    if (name.length() > 15) name = name.substring(0, 14) + ".";
+    gfx->setTextColor(currentTheme.text);
+    gfx->setTextSize(2);
+    gfx->setCursor(10, y + 8);
+    gfx->print(name);
+
+    const SpotForecast *f = i < forecasts.size() ? &forecasts[i] : nullptr;
+    if (!f || !f->valid) {
+      gfx->setTextColor(currentTheme.textSecondary);
+      gfx->setCursor(waveX, y + 8);
+      gfx->print("no data");
+      continue;
+    }
+
+    float waveFeet = f->waveHeight * 3.28084f;
+    gfx->setTextColor(waveFeet >= waveHeightThreshold ? currentTheme.success : currentTheme.error);
+    gfx->setTextSize(3);
+    gfx->setCursor(waveX, y + 4);
+    gfx->print(String(waveFeet, 1));
+
+    gfx->setTextColor(currentTheme.periodDirNumberColor);
+    gfx->setTextSize(2);
+    gfx->setCursor(periodX, y);
+    gfx->print(String(f->wavePeriod, 0) + "s");
+    gfx->setTextColor(YELLOW);
+    gfx->setTextSize(1);
+    gfx->setCursor(periodX, y + 22);
+    gfx->print(degreesToCardinal(f->waveDirection));
+
+    gfx->setTextColor(currentTheme.periodDirNumberColor);
+    gfx->setTextSize(2);
+    gfx->setCursor(tideX, y + 8);
+    if (!f->hasTide) {
+      gfx->print("--");
+      continue;
     }
-    files.push_back(info);
-    file = root.openNextFile();
+    gfx->print(String(f->tideHeight * 3.28084f, 1));
+    int16_t ax = gfx->width() - 14;
+    int16_t ay = y + 15;
+    uint16_t arrowCol = darkMode ? BLACK : WHITE;
+    if (f->tideRate >= 0.0f) gfx->fillTriangle(ax, ay - 6, ax - 5, ay + 3, ax + 5, ay + 3, arrowCol);
+    else gfx->fillTriangle(ax, ay + 6, ax - 5, ay - 3, ax + 5, ay - 3, arrowCol);
   }
-  
-  int scrollOffset = 0;
+}
+
+// Small "updating" tag left of the Settings button while a refresh runs in the
+// background; the forecast under it stays as last fetched.
+void drawUpdatingIndicator(bool updating) {
+  const int16_t tagW = 54;
+  int16_t x = gfx->width() - 65 - tagW - 4;
+  gfx->fillRect(x, 10, tagW, 14, currentTheme.background);
+  if (!updating) return;
+  gfx->setTextColor(currentTheme.textSecondary);
+  gfx->setTextSize(1);
+  gfx->setCursor(x + 3, 13);
+  gfx->print("updating");
+}
+
+// Age tag for a forecast restored from flash at boot. Before NTP sync the age
+// is unknown, so the fetch time (UTC) is shown instead.
+void drawForecastAge(time_t fetchedAt) {
+  String label;
+  time_t now = time(nullptr);
+  if (now >= 1000000000 && now >= fetchedAt) {
+    long mins = (long)((now - fetchedAt) / 60);
+    if (mins < 60) label = "cached " + String(mins) + "m ago";
+    else if (mins < 48 * 60) label = "cached " + String(mins / 60) + "h ago";
+    else label = "cached " + String(mins / 1440) + "d ago";
+  } else {
+    struct tm t;
+    gmtime_r(&fetchedAt, &t);
+    char buf[24];
+    snprintf(buf, sizeof(buf), "cached %02d/%02d %02d:%02dZ", t.tm_mon + 1, t.tm_mday, t.tm_hour, t.tm_min);
+    label = buf;
+  }
+  gfx->fillRect(180, 10, 110, 14, currentTheme.background);
+  gfx->setTextColor(currentTheme.textSecondary);
+  gfx->setTextSize(1);
+  gfx->setCursor(183, 13);
+  gfx->print(label);
+}
+
+// Stored files viewer. Every file is read once, when the screen opens, into a
+// flat table of display lines whose text shares one pool, so drawing a row is
+// a lookup. JSON files show a line per top-level key, other text files their
+// first line, and binary files a hex dump of their first FILE_VIEW_HEX_BYTES.
+static const size_t FILE_VIEW_JSON_BYTES = 4096;
+static const size_t FILE_VIEW_HEX_BYTES = 64;
+static const size_t FILE_VIEW_COLUMNS = 76;   // 6 px characters from x = 15
+
+enum FileViewStyle : uint8_t { FILE_VIEW_GAP, FILE_VIEW_NAME, FILE_VIEW_TEXT };
+
+struct FileViewLine {
+  uint16_t offset;      // into FileView::text
+  uint8_t length;
+  uint8_t keyLength;    // leading characters drawn as a key
+  FileViewStyle style;
+};
+
+struct FileView {
+  std::vector<FileViewLine> lines;
+  std::vector<char> text;
+};
+
+static void addFileViewLine(FileView &view, FileViewStyle style, const char *s, size_t len, size_t keyLength) {
+  bool cut = len > FILE_VIEW_COLUMNS;
+  if (cut) len = FILE_VIEW_COLUMNS - 3;
+  if (view.text.size() + len + 3 > 0xFFFF) return;
+  FileViewLine line = {(uint16_t)view.text.size(), (uint8_t)(cut ? len + 3 : len), (uint8_t)min(keyLength, len), style};
+  view.text.insert(view.text.end(), s, s + len);
+  if (cut) view.text.insert(view.text.end(), 3, '.');
+  view.lines.push_back(line);
+}
+
+static bool looksBinary(const uint8_t *data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if (data[i] < 0x20 && data[i] != '\n' && data[i] != '\r' && data[i] != '\t') return true;
+  }
+  return false;
+}
+
+static void addJsonLines(FileView &view, JsonObject obj) {
+  char line[FILE_VIEW_COLUMNS + 16];
+  for (JsonPair kv : obj) {
+    int key = snprintf(line, sizeof(line), "%s: ", kv.key().c_str());
+    key = min(key, (int)sizeof(line) - 1);
+    if (kv.value().is<const char *>()) {
+      snprintf(line + key, sizeof(line) - key, "%s", kv.value().as<const char *>());
+    } else {
+      serializeJson(kv.value(), line + key, sizeof(line) - key);
+    }
+    addFileViewLine(view, FILE_VIEW_TEXT, line, strlen(line), key);
+  }
+}
+
+static void addFileLines(FileView &view, File &file, JsonDocument &doc) {
+  char line[FILE_VIEW_COLUMNS + 16];
+  int n = snprintf(line, sizeof(line), "%s  (%lu bytes)", file.name(), (unsigned long)file.size());
+  addFileViewLine(view, FILE_VIEW_NAME, line, min(n, (int)sizeof(line) - 1), 0);
+
+  uint8_t head[FILE_VIEW_HEX_BYTES];
+  size_t got = file.read(head, sizeof(head));
+  bool binary = looksBinary(head, got);
+  if (got > 0 && head[0] == '{' && !binary && file.seek(0)) {
+    if (!deserializeJson(doc, file) && doc.is<JsonObject>()) {
+      addJsonLines(view, doc.as<JsonObject>());
+      return;
+    }
+  }
+  if (got > 0 && !binary) {
+    size_t len = 0;
+    while (len < got && head[len] != '\n' && head[len] != '\r') len++;
+    addFileViewLine(view, FILE_VIEW_TEXT, (const char *)head, len, 0);
+    return;
+  }
+  for (size_t at = 0; at < got; at += 16) {
+    int pos = snprintf(line, sizeof(line), "%04x ", (unsigned)at);
+    for (size_t i = at; i < at + 16; i++) {
+      pos += i < got ? snprintf(line + pos, sizeof(line) - pos, " %02x", head[i]) : snprintf(line + pos, sizeof(line) - pos, "   ");
+    }
+    line[pos++] = ' ';
+    line[pos++] = ' ';
+    for (size_t i = at; i < at + 16 && i < got; i++) line[pos++] = (head[i] >= 0x20 && head[i] < 0x7f) ? (char)head[i] : '.';
+    addFileViewLine(view, FILE_VIEW_TEXT, line, pos, 0);
+  }
+}
+
+static void loadFileView(FileView &view) {
+  DynamicJsonDocument doc(FILE_VIEW_JSON_BYTES);
+  File root = STORAGE_FS.open("/");
+  if (!root) return;
+  for (File file = root.openNextFile(); file; file = root.openNextFile()) {
+    addFileLines(view, file, doc);
+    file.close();
+    addFileViewLine(view, FILE_VIEW_GAP, "", 0, 0);
+  }
+  root.close();
+}
+
+// Clears the row and draws one table line into it
+static void drawFileViewRow(const FileView &view, int index, int16_t y, int16_t lineHeight) {
+  gfx->fillRect(0, y, gfx->width(), lineHeight, currentTheme.background);
+  if (index < 0 || index >= (int)view.lines.size()) return;
+  const FileViewLine &line = view.lines[index];
+  char text[FILE_VIEW_COLUMNS + 1];
+  memcpy(text, view.text.data() + line.offset, line.length);
+  text[line.length] = '\0';
+
+  gfx->setTextSize(1);
+  if (line.style == FILE_VIEW_NAME) {
+    gfx->setTextColor(currentTheme.accent);
+    gfx->setCursor(5, y);
+    gfx->print(">");
+    gfx->setCursor(12, y);
+    gfx->print(text);
+  } else if (line.style == FILE_VIEW_TEXT) {
+    gfx->setCursor(15, y);
+    gfx->setTextColor(currentTheme.textSecondary);
+    char rest = text[line.keyLength];
+    text[line.keyLength] = '\0';
+    gfx->print(text);
+    text[line.keyLength] = rest;
+    gfx->setTextColor(currentTheme.text);
+    gfx->print(text + line.keyLength);
+  }
+}
+
+static void drawFileViewPosition(int top, int maxTop) {
+  gfx->fillRect(380, 5, 100, 10, currentTheme.background);
+  if (maxTop <= 0) return;
+  gfx->setTextColor(currentTheme.textSecondary);
+  gfx->setTextSize(1);
+  gfx->setCursor(390, 5);
+  gfx->print(String(top) + "/" + String(maxTop));
+}
+
+void viewFilesScreen(Rect &backButton) {
+  Rect diagnosticsButton = {0, 0, 0, 0};
   const int lineHeight = 10;
   const int headerHeight = 30;
   const int footerHeight = 45;
-  const int contentHeight = 320 - headerHeight - footerHeight;
-  const int maxLines = contentHeight / lineHeight;
-  
-  // Calculate total content height
-  int totalLines = 0;
-  for (const auto& f : files) {
-    totalLines += 1; // filename
-    DynamicJsonDocument doc(1024);
-    DeserializationError error = deserializeJson(doc, f.content);
-    if (!error) {
-      JsonObject obj = doc.as<JsonObject>();
-      for (JsonPair kv : obj) {
-        totalLines++;
-      }
-    } else if (f.content.length() > 0) {
-      totalLines++;
-    }
-    totalLines++; // gap
-  }
-  
+  const int maxLines = (320 - headerHeight - footerHeight) / lineHeight;
+
+  FileView view;
+  loadFileView(view);
+  int totalLines = (int)view.lines.size();
+  int maxTop = max(0, totalLines - maxLines);
+
+  // The table line each row shows, -1 when blank; a scroll redraws only the
+  // rows whose line changes
+  std::vector<int> shown(maxLines, -2);
+  int top = 0;
   bool needsRedraw = true;
-  
+  bool needsScroll = false;
+
   while (true) {
     if (needsRedraw) {
       gfx->fillScreen(currentTheme.background);
       
-      // Title
       gfx->setTextColor(currentTheme.textSecondary);
       gfx->setTextSize(2);
       gfx->setCursor(10, 5);
       gfx->println("Stored Files");
       
-      // Show scroll indicator if needed
-      if (totalLines > maxLines) {
+      if (totalLines == 0) {
         gfx->setTextSize(1);
-        gfx->setCursor(390, 5);
-        gfx->print(scrollOffset / lineHeight);
-        gfx->print("/");
-        gfx->print((totalLines - maxLines));
-      }
-      
-      // Draw content with scroll offset
-      gfx->setTextSize(1);
-      int16_t y = headerHeight;
-      int currentLine = 0;
-      
-      for (const auto& f : files) {
-        // File name header
-        if (currentLine >= scrollOffset / lineHeight && y < headerHeight + contentHeight) {
-          gfx->setTextColor(currentTheme.accent);
-          gfx->setCursor(5, y);
-          gfx->print(">");
-          gfx->setCursor(12, y);
-          gfx->println(f.name);
-          y += lineHeight;
-        }
-        currentLine++;
-        
-        // Parse and display content
-        DynamicJsonDocument doc(1024);
-        DeserializationError error = deserializeJson(doc, f.content);
-        
-        if (!error) {
-          JsonObject obj = doc.as<JsonObject>();
-          for (JsonPair kv : obj) {
-            if (currentLine >= scrollOffset / lineHeight && y < headerHeight + contentHeight) {
-              gfx->setCursor(15, y);
-              gfx->setTextColor(currentTheme.textSecondary);
-              gfx->print(String(kv.key().c_str()) + ":");
-              
-              gfx->setTextColor(currentTheme.text);
-              String value = kv.value().as<String>();
-              if (value.length() > 30) value = value.substring(0, 27) + "...";
-              gfx->print(" " + value);
-              y += lineHeight;
-            }
-            currentLine++;
-          }
-        } else if (f.content.length() > 0) {
-          if (currentLine >= scrollOffset / lineHeight && y < headerHeight + contentHeight) {
-            gfx->setTextColor(currentTheme.text);
-            gfx->setCursor(15, y);
-            String content = f.content;
-            if (content.length() > 45) content = content.substring(0, 42) + "...";
-            gfx->println(content);
-            y += lineHeight;
-          }
-          currentLine++;
-        }
-        currentLine++; // gap
-      }
-      
-      if (files.size() == 0) {
         gfx->setCursor(10, 50);
-        gfx->setTextColor(currentTheme.textSecondary);
         gfx->println("No files found");
       }
       
-      // Back button at bottom
+      // Back and Diagnostics buttons at bottom
       int btnW = 140;
       int btnH = 40;
-      int startX = (gfx->width() - btnW) / 2;
+      int gap = 10;
+      int startX = (gfx->width() - (btnW * 2 + gap)) / 2;
       backButton = {int16_t(startX), int16_t(320 - btnH - 5), int16_t(btnW), int16_t(btnH)};
       drawButton(backButton, "< Back", currentTheme.buttonSecondary, currentTheme.text, 2);
+      diagnosticsButton = {int16_t(startX + btnW + gap), int16_t(320 - btnH - 5), int16_t(btnW), int16_t(btnH)};
+      drawButton(diagnosticsButton, "Diagnostics", currentTheme.buttonList, currentTheme.text, 2);
       
+      // The screen is blank now, so every non-blank row needs drawing
+      for (int &line : shown) line = -1;
       needsRedraw = false;
+      needsScroll = true;
+    }
+
+    if (needsScroll) {
+      for (int row = 0; row < maxLines; row++) {
+        int index = top + row;
+        int want = (index < totalLines && view.lines[index].style != FILE_VIEW_GAP) ? index : -1;
+        if (shown[row] == want) continue;
+        drawFileViewRow(view, want, headerHeight + row * lineHeight, lineHeight);
+        shown[row] = want;
+      }
+      drawFileViewPosition(top, maxTop);
+      needsScroll = false;
     }
     
     // Handle touch for scrolling or back button
@@ -602,30 +797,146 @@ void viewFilesScreen(Rect &backButton) {
         while (touch.touched()) delay(20);
         return;
       }
-      
-      // Scroll up/down based on touch position
-      if (p.y < 160 && scrollOffset > 0) {
-        // Scroll up
-        scrollOffset -= lineHeight * 3;
-        if (scrollOffset < 0) scrollOffset = 0;
-        needsRedraw = true;
-      } else if (p.y >= 160 && scrollOffset < (totalLines - maxLines) * lineHeight) {
-        // Scroll down
-        scrollOffset += lineHeight * 3;
-        int maxScroll = (totalLines - maxLines) * lineHeight;
-        if (maxScroll < 0) maxScroll = 0;
-        if (scrollOffset > maxScroll) scrollOffset = maxScroll;
+      if (pointInRect(p.x, p.y, diagnosticsButton)) {
+        while (touch.touched()) delay(20);
+        viewDiagnosticsScreen(backButton);
         needsRedraw = true;
+        continue;
+      }
+      
+      // Taps in the upper/lower half scroll by half a page
+      if (p.y < 160 && top > 0) {
+        top = max(0, top - maxLines / 2);
+        needsScroll = true;
+      } else if (p.y >= 160 && top < maxTop) {
+        top = min(maxTop, top + maxLines / 2);
+        needsScroll = true;
       }
       
       while (touch.touched()) delay(20);
-      delay(100);
     }
     
     delay(50);
   }
 }
 
+// Network stage samples, newest first, with the slowest one called out, and
+// the write-behind state files' flash writes. Redraws as new samples arrive;
+// taps in the upper/lower half scroll.
+void viewDiagnosticsScreen(Rect &backButton) {
+  static StageSample samples[DIAG_RING_SIZE];
+  const int lineHeight = 10;
+  const int headerHeight = 46;
+  const int footerHeight = 72;
+  const int maxLines = (320 - headerHeight - footerHeight) / lineHeight;
+  int count = 0;
+  uint32_t newestAt = 0;
+  int scroll = 0;
+  bool needsRedraw = true;
+  uint32_t lastPoll = 0;
+
+  while (true) {
+    if (millis() - lastPoll > 1000) {
+      lastPoll = millis();
+      count = copyStageSamples(samples, DIAG_RING_SIZE);
+      uint32_t at = count > 0 ? samples[count - 1].at : 0;
+      if (at != newestAt) {
+        newestAt = at;
+        needsRedraw = true;
+      }
+    }
+
+    if (needsRedraw) {
+      gfx->fillScreen(currentTheme.background);
+      gfx->setTextColor(currentTheme.textSecondary);
+      gfx->setTextSize(2);
+      gfx->setCursor(10, 5);
+      gfx->println("Diagnostics");
+
+      gfx->setTextSize(1);
+      gfx->setCursor(200, 5);
+      gfx->print("heap " + String(ESP.getFreeHeap() / 1024) + "K, block " + String(ESP.getMaxAllocHeap() / 1024) + "K");
+
+      int slowest = -1;
+      for (int i = 0; i < count; i++) {
+        if (samples[i].stage == STAGE_TOTAL) continue;
+        if (slowest < 0 || samples[i].durationMs > samples[slowest].durationMs) slowest = i;
+      }
+      if (slowest >= 0) {
+        gfx->setTextColor(currentTheme.accent);
+        gfx->setCursor(200, 16);
+        gfx->print(String("slowest: ") + samples[slowest].request + " " + diagStageName(samples[slowest].stage) +
+                   " " + String(samples[slowest].durationMs) + " ms");
+      }
+
+      gfx->setTextColor(currentTheme.textSecondary);
+      gfx->setCursor(5, headerHeight - 14);
+      gfx->print("  age request       stage     ms  bytes code    free K   block K");
+
+      char line[96];
+      uint32_t now = millis();
+      int16_t y = headerHeight;
+      for (int row = scroll; row < count && row < scroll + maxLines; row++) {
+        const StageSample &s = samples[count - 1 - row];
+        snprintf(line, sizeof(line), "%4lus %-13s %-5s %6lu %6lu %4d %4lu>%-4lu %4lu>%-4lu",
+                 (unsigned long)((now - s.at) / 1000), s.request, diagStageName(s.stage),
+                 (unsigned long)s.durationMs, (unsigned long)s.bytes, s.httpCode,
+                 (unsigned long)(s.freeHeapBefore / 1024), (unsigned long)(s.freeHeapAfter / 1024),
+                 (unsigned long)(s.maxBlockBefore / 1024), (unsigned long)(s.maxBlockAfter / 1024));
+        bool slow = s.durationMs >= 5000;
+        gfx->setTextColor(slow ? currentTheme.error : (s.stage == STAGE_TOTAL ? currentTheme.accent : currentTheme.text));
+        gfx->setCursor(5, y);
+        gfx->print(line);
+        y += lineHeight;
+      }
+      if (count == 0) {
+        gfx->setTextColor(currentTheme.textSecondary);
+        gfx->setCursor(10, headerHeight + 10);
+        gfx->print("No network activity recorded yet");
+      }
+
+      StateFileStats files[4];
+      int fileCount = copyStateFileStats(files, 4);
+      int16_t filesY = 320 - footerHeight + 2;
+      gfx->setTextColor(currentTheme.textSecondary);
+      gfx->setCursor(5, filesY);
+      gfx->print("state file writes/saves since boot (* = pending)");
+      for (int i = 0; i < fileCount; i++) {
+        const char *name = files[i].path + 1;
+        const char *ext = strchr(name, '.');
+        snprintf(line, sizeof(line), "%.*s %lu/%lu%s", ext ? (int)(ext - name) : (int)strlen(name), name,
+                 (unsigned long)files[i].writes, (unsigned long)files[i].saves, files[i].dirty ? "*" : "");
+        gfx->setCursor(5 + i * 160, filesY + lineHeight);
+        gfx->print(line);
+      }
+
+      int btnW = 140;
+      int btnH = 40;
+      backButton = {int16_t((gfx->width() - btnW) / 2), int16_t(320 - btnH - 5), int16_t(btnW), int16_t(btnH)};
+      drawButton(backButton, "< Back", currentTheme.buttonSecondary, currentTheme.text, 2);
+      needsRedraw = false;
+    }
+
+    TouchPoint p = getTouchPoint();
+    if (p.pressed) {
+      if (pointInRect(p.x, p.y, backButton)) {
+        while (touch.touched()) delay(20);
+        return;
+      }
+      int maxScroll = count > maxLines ? count - maxLines : 0;
+      if (p.y < 160 && scroll > 0) {
+        scroll = max(0, scroll - maxLines / 2);
+        needsRedraw = true;
+      } else if (p.y >= 160 && scroll < maxScroll) {
+        scroll = min(maxScroll, scroll + maxLines / 2);
+        needsRedraw = true;
+      }
+      while (touch.touched()) delay(20);
+    }
+    delay(50);
+  }
+}
+
 void drawWelcomeScreen(Rect &setupButton) {
   const int16_t screenWidth = gfx->width();
   const int16_t screenHeight = gfx->height();
@@ -0,0 +1,193 @@
+#include "ForecastWorker.h"
+#include "Network.h"
+#include "Storage.h"
+#include "Log.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+
+// The fetch task owns all forecast HTTP work so the UI loop keeps polling touch.
+// Requests go in through a one-slot queue (newest wins); finished snapshots come
+// back as heap-allocated results because SurfForecast holds a String and cannot
+// be copied byte-wise through a FreeRTOS queue.
+// spotCount > 0 asks for the multi-spot overview instead of one forecast.
+struct ForecastRequest {
+  float latitude;
+  float longitude;
+  uint32_t generation;
+  uint8_t spotCount;
+  float spotLatitude[MAX_OVERVIEW_SPOTS];
+  float spotLongitude[MAX_OVERVIEW_SPOTS];
+};
+
+struct ForecastResult {
+  SurfForecast forecast;
+  std::vector<SpotForecast> spots;
+  bool overview;
+  uint32_t generation;
+};
+
+static const uint32_t WORKER_STACK_BYTES = 12 * 1024;  // TLS handshake + JSON parsing
+static const UBaseType_t WORKER_PRIORITY = 1;
+static const BaseType_t WORKER_CORE = 0;
+
+static QueueHandle_t requestQueue = nullptr;
+static QueueHandle_t resultQueue = nullptr;
+static TaskHandle_t workerTask = nullptr;
+static volatile uint32_t latestGeneration = 0;     // written by the UI
+static volatile uint32_t completedGeneration = 0;  // written by the worker
+static ForecastResult *inlineResult = nullptr;  // used when no task is running
+static ForecastResult *heldResult = nullptr;    // current, waiting for the poll of its kind
+
+// Last good forecast and its spot. Requests for the same spot rebuild it,
+// refetching only the sources that are due. Only touched by whichever context
+// serves requests.
+static SurfForecast lastForecast;
+static float lastLatitude = 0.0f;
+static float lastLongitude = 0.0f;
+
+static SurfForecast serveRequest(float latitude, float longitude) {
+  bool sameSpot = lastForecast.valid && latitude == lastLatitude && longitude == lastLongitude;
+  SurfForecast forecast = sameSpot ? updateSurfForecast(lastForecast, latitude, longitude)
+                                   : fetchSurfForecast(latitude, longitude);
+  if (forecast.valid) {
+    lastForecast = forecast;
+    lastLatitude = latitude;
+    lastLongitude = longitude;
+  }
+  return forecast;
+}
+
+// Overview rows from the last request, so series and stations carry over to
+// the next one for the same spots.
+static std::vector<SpotForecast> lastSpots;
+
+static std::vector<SpotForecast> serveSpotRequest(const ForecastRequest &request) {
+  std::vector<SpotForecast> spots(request.spotCount);
+  for (size_t i = 0; i < spots.size(); i++) {
+    spots[i].latitude = request.spotLatitude[i];
+    spots[i].longitude = request.spotLongitude[i];
+    for (const SpotForecast &previous : lastSpots) {
+      if (previous.latitude == spots[i].latitude && previous.longitude == spots[i].longitude) {
+        spots[i] = previous;
+        break;
+      }
+    }
+  }
+  if (!updateSpotForecasts(spots)) spots.clear();
+  else lastSpots = spots;
+  return spots;
+}
+
+static ForecastResult *serve(const ForecastRequest &request) {
+  ForecastResult *result = new ForecastResult();
+  result->overview = request.spotCount > 0;
+  if (result->overview) result->spots = serveSpotRequest(request);
+  else result->forecast = serveRequest(request.latitude, request.longitude);
+  result->generation = request.generation;
+  return result;
+}
+
+static void forecastTask(void *) {
+  ForecastRequest request;
+  for (;;) {
+    if (xQueueReceive(requestQueue, &request, portMAX_DELAY) != pdTRUE) continue;
+    ForecastResult *result = serve(request);
+    if (xQueueSend(resultQueue, &result, 0) != pdTRUE) delete result;
+    completedGeneration = request.generation;
+  }
+}
+
+void startForecastWorker() {
+  if (workerTask) return;
+  // Create the network mutex here, before a second task can race to create it
+  lockNetwork();
+  unlockNetwork();
+  requestQueue = xQueueCreate(1, sizeof(ForecastRequest));
+  resultQueue = xQueueCreate(2, sizeof(ForecastResult *));
+  if (requestQueue && resultQueue &&
+      xTaskCreatePinnedToCore(forecastTask, "forecast", WORKER_STACK_BYTES, nullptr, WORKER_PRIORITY, &workerTask,
+                              WORKER_CORE) == pdPASS) {
+    LOG_INFO("Forecast worker started on core %d", WORKER_CORE);
+    return;
+  }
+  workerTask = nullptr;
+  LOG_INFO("Forecast worker unavailable, fetching inline");
+}
+
+static void submitRequest(ForecastRequest &request) {
+  request.generation = ++latestGeneration;
+  if (workerTask) {
+    xQueueOverwrite(requestQueue, &request);
+    return;
+  }
+  delete inlineResult;
+  inlineResult = serve(request);
+  completedGeneration = request.generation;
+}
+
+void requestForecast(float latitude, float longitude) {
+  ForecastRequest request = {};
+  request.latitude = latitude;
+  request.longitude = longitude;
+  submitRequest(request);
+}
+
+void requestSpotForecasts(const std::vector<LocationInfo> &spots) {
+  ForecastRequest request = {};
+  request.spotCount = (uint8_t)min(spots.size(), (size_t)MAX_OVERVIEW_SPOTS);
+  for (int i = 0; i < request.spotCount; i++) {
+    request.spotLatitude[i] = spots[i].latitude;
+    request.spotLongitude[i] = spots[i].longitude;
+  }
+  submitRequest(request);
+}
+
+bool forecastUpdating() {
+  return completedGeneration != latestGeneration;
+}
+
+// The newest current result of the given kind, if any. Results for superseded
+// requests are dropped; a current one of the other kind is held for its poll.
+static ForecastResult *takeResult(bool overview) {
+  ForecastResult *result = nullptr;
+  if (workerTask) {
+    ForecastResult *received = nullptr;
+    while (xQueueReceive(resultQueue, &received, 0) == pdTRUE) {
+      delete result;
+      result = received;
+    }
+  } else {
+    result = inlineResult;
+    inlineResult = nullptr;
+  }
+  if (result) {
+    delete heldResult;
+    heldResult = result;
+  }
+  if (heldResult && heldResult->generation != latestGeneration) {
+    // A newer request (e.g. a location change) supersedes this snapshot
+    delete heldResult;
+    heldResult = nullptr;
+  }
+  if (!heldResult || heldResult->overview != overview) return nullptr;
+  result = heldResult;
+  heldResult = nullptr;
+  return result;
+}
+
+bool pollForecast(SurfForecast &forecast) {
+  ForecastResult *result = takeResult(false);
+  if (!result) return false;
+  forecast = result->forecast;
+  delete result;
+  return true;
+}
+
+bool pollSpotForecasts(std::vector<SpotForecast> &spots) {
+  ForecastResult *result = takeResult(true);
+  if (!result) return false;
+  spots = result->spots;
+  delete result;
+  return true;
+}
@@ -5,14 +5,14 @@
 #include "Display.h"
 #include "Storage.h"
 #include "Database.h"
-#include <SPIFFS.h>
+#include "Log.h"
 #include <ArduinoJson.h>
 
 // High score storage
 unsigned long loadHighScore() {
-  if (!SPIFFS.exists("/high_score.json")) return 0;
+  if (!STORAGE_FS.exists("/high_score.json")) return 0;
   
-  File file = SPIFFS.open("/high_score.json", "r");
+  File file = STORAGE_FS.open("/high_score.json", "r");
   if (!file) return 0;
   
   DynamicJsonDocument doc(128);
@@ -27,13 +27,12 @@ bool saveHighScore(unsigned long score) {
   DynamicJsonDocument doc(128);
   doc["highScore"] = score;
   
-  File file = SPIFFS.open("/high_score.json", "w");
+  File file = openReplace("/high_score.json");
   if (!file) return false;
   
-  serializeJson(doc, file);
-  file.close();
+  if (!commitReplace(file, "/high_score.json", serializeJson(doc, file) > 0)) return false;
   
-  logInfo("High score saved: " + String(score));
+  LOG_INFO("High score saved: %u", score);
   return true;
 }
 
@@ -171,6 +170,7 @@ void runSurfGame(Rect &exitButton) {
   
   // Game loop
   while (!gameOver) {
+    logDrain();
     // Progressive difficulty — slower individual sharks (base 1, max 5)
     int currentSpeed = 1 + (score / 150);
     if (currentSpeed > 5) currentSpeed = 5;
@@ -578,6 +578,7 @@ void runSurfGame(Rect &exitButton) {
 
   // Wait for touch to exit
   while (!touch.touched()) {
+    logDrain();
     delay(50);
   }
   while (touch.touched()) delay(20); // Debounce
@@ -632,6 +633,7 @@ void runSurfGame(Rect &exitButton) {
     
     // Wait for touch
     while (!touch.touched()) {
+      logDrain();
       delay(50);
     }
     while (touch.touched()) delay(20); // Debounce
@@ -726,6 +728,7 @@ void showLeaderboard() {
   
   // Wait for touch to exit
   while (!touch.touched()) {
+    logDrain();
     delay(50);
   }
   while (touch.touched()) delay(20); // Debounce
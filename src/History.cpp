@@ -0,0 +1,235 @@
+#include "History.h"
+#include "Config.h"
+#include "Storage.h"
+#include "Log.h"
+#include <math.h>
+#include <time.h>
+
+// File: an 8-byte header (magic, record size, capacity), then the slots. The
+// file grows by appending until it holds HISTORY_CAPACITY records; after that
+// each append overwrites the oldest slot. Slot order is therefore time order
+// rotated by the index of the oldest record, which is found at load by binary
+// search and then kept in RAM with the count and the newest record.
+
+static const uint32_t HISTORY_MAGIC = 0x31545348;  // "HST1"
+static const size_t HISTORY_HEADER_BYTES = 8;
+static const int HISTORY_BLOCK_RECORDS = 16;       // records per read
+
+static_assert(sizeof(HistoryRecord) == 16, "history records are 16 bytes on flash");
+
+struct HistoryHeader {
+  uint32_t magic;
+  uint16_t recordSize;
+  uint16_t capacity;
+};
+
+static bool historyLoaded = false;
+static int historyRecords = 0;   // slots in use
+static int historyOldest = 0;    // slot of the oldest record
+static HistoryRecord historyNewest;
+
+static size_t slotOffset(int slot) {
+  return HISTORY_HEADER_BYTES + (size_t)slot * sizeof(HistoryRecord);
+}
+
+// Slot of the i-th record, oldest first
+static int slotOf(int i) {
+  return (historyOldest + i) % HISTORY_CAPACITY;
+}
+
+static bool readSlots(File &f, int slot, HistoryRecord *out, int n) {
+  size_t bytes = (size_t)n * sizeof(HistoryRecord);
+  return f.seek(slotOffset(slot)) && f.read((uint8_t *)out, bytes) == bytes;
+}
+
+static uint32_t timeAt(File &f, int i) {
+  uint32_t t = 0;
+  if (!f.seek(slotOffset(slotOf(i))) || f.read((uint8_t *)&t, sizeof(t)) != sizeof(t)) return 0;
+  return t;
+}
+
+// Index (oldest first) of the first record with time > t, or historyRecords
+static int upperBound(File &f, uint32_t t) {
+  int lo = 0, hi = historyRecords;
+  while (lo < hi) {
+    int mid = (lo + hi) / 2;
+    if (timeAt(f, mid) <= t) lo = mid + 1;
+    else hi = mid;
+  }
+  return lo;
+}
+
+static void loadHistory() {
+  historyLoaded = true;
+  historyRecords = 0;
+  historyOldest = 0;
+  historyNewest = HistoryRecord();
+  if (!STORAGE_FS.exists(HISTORY_FILE)) return;
+  File f = STORAGE_FS.open(HISTORY_FILE, FILE_READ);
+  if (!f) return;
+
+  HistoryHeader header;
+  if (f.read((uint8_t *)&header, sizeof(header)) != sizeof(header) || header.magic != HISTORY_MAGIC ||
+      header.recordSize != sizeof(HistoryRecord) || header.capacity != HISTORY_CAPACITY) {
+    LOG_ERROR("History file has unknown format, ignoring.");
+    f.close();
+    return;
+  }
+  size_t size = f.size();
+  int slots = size > HISTORY_HEADER_BYTES ? (int)((size - HISTORY_HEADER_BYTES) / sizeof(HistoryRecord)) : 0;
+  historyRecords = min(slots, HISTORY_CAPACITY);
+
+  // Once wrapped, the oldest record is the first slot whose time is below slot 0's
+  if (historyRecords == HISTORY_CAPACITY) {
+    uint32_t first = timeAt(f, 0);
+    int lo = 1, hi = HISTORY_CAPACITY;
+    while (lo < hi) {
+      int mid = (lo + hi) / 2;
+      if (timeAt(f, mid) < first) hi = mid;
+      else lo = mid + 1;
+    }
+    historyOldest = lo % HISTORY_CAPACITY;
+  }
+  if (historyRecords > 0 && !readSlots(f, slotOf(historyRecords - 1), &historyNewest, 1)) {
+    historyNewest = HistoryRecord();
+  }
+  f.close();
+  LOG_INFO("Loaded history: %d records, oldest in slot %d.", historyRecords, historyOldest);
+}
+
+uint8_t historySpotTag(float latitude, float longitude) {
+  uint32_t lat = (uint32_t)(int32_t)lroundf(latitude * 100.0f);
+  uint32_t lon = (uint32_t)(int32_t)lroundf(longitude * 100.0f);
+  uint32_t h = lat * 2654435761UL ^ lon * 40503UL;
+  return (uint8_t)(h ^ (h >> 8) ^ (h >> 16) ^ (h >> 24));
+}
+
+static uint16_t clampU16(float value) {
+  if (value <= 0.0f) return 0;
+  if (value >= 65535.0f) return 65535;
+  return (uint16_t)lroundf(value);
+}
+
+static int16_t clampI16(float value) {
+  if (value <= -32768.0f) return -32768;
+  if (value >= 32767.0f) return 32767;
+  return (int16_t)lroundf(value);
+}
+
+static uint8_t halfDegrees(float degrees) {
+  float d = fmodf(degrees, 360.0f);
+  if (d < 0.0f) d += 360.0f;
+  return (uint8_t)((int)lroundf(d / 2.0f) % 180);
+}
+
+bool appendHistory(const LocationInfo &location, const SurfForecast &forecast, time_t at) {
+  if (!forecast.valid || at < 1000000000) return false;
+  if (!historyLoaded) loadHistory();
+
+  HistoryRecord r;
+  r.time = (uint32_t)at;
+  r.waveHeightCm = clampU16(forecast.waveHeight * 100.0f);
+  r.wavePeriodDs = clampU16(forecast.wavePeriod * 10.0f);
+  r.windSpeedX10 = clampU16(forecast.windSpeed * 10.0f);
+  r.tideHeightMm = clampI16(forecast.tideHeight * 1000.0f);
+  r.tideRateCmH = (int8_t)max(-127L, min(127L, lroundf(forecast.tideRate * 100.0f)));
+  r.waveDirection2 = halfDegrees(forecast.waveDirection);
+  r.windDirection2 = halfDegrees(forecast.windDirection);
+  r.spot = historySpotTag(location.latitude, location.longitude);
+
+  if (historyRecords > 0) {
+    if (r.time <= historyNewest.time) return false;
+    if (r.spot == historyNewest.spot && r.time - historyNewest.time < HISTORY_MIN_SPACING_S) return false;
+  }
+
+  bool ok;
+  if (historyRecords == 0) {
+    HistoryHeader header = {HISTORY_MAGIC, (uint16_t)sizeof(HistoryRecord), (uint16_t)HISTORY_CAPACITY};
+    File f = STORAGE_FS.open(HISTORY_FILE, FILE_WRITE);
+    ok = f && f.write((const uint8_t *)&header, sizeof(header)) == sizeof(header) &&
+         f.write((const uint8_t *)&r, sizeof(r)) == sizeof(r);
+    if (f) f.close();
+  } else if (historyRecords < HISTORY_CAPACITY) {
+    File f = STORAGE_FS.open(HISTORY_FILE, FILE_APPEND);
+    ok = f && f.write((const uint8_t *)&r, sizeof(r)) == sizeof(r);
+    if (f) f.close();
+  } else {
+    File f = STORAGE_FS.open(HISTORY_FILE, "r+");
+    ok = f && f.seek(slotOffset(historyOldest)) && f.write((const uint8_t *)&r, sizeof(r)) == sizeof(r);
+    if (f) f.close();
+  }
+  if (!ok) {
+    LOG_ERROR("Failed to append to history file.");
+    // Reload the bookkeeping from whatever reached flash
+    historyLoaded = false;
+    return false;
+  }
+
+  if (historyRecords < HISTORY_CAPACITY) historyRecords++;
+  else historyOldest = (historyOldest + 1) % HISTORY_CAPACITY;
+  historyNewest = r;
+  return true;
+}
+
+int readHistory(uint32_t from, uint32_t to, HistoryRecord *out, int maxRecords) {
+  if (!historyLoaded) loadHistory();
+  if (historyRecords == 0 || maxRecords <= 0 || from > to) return 0;
+  File f = STORAGE_FS.open(HISTORY_FILE, FILE_READ);
+  if (!f) return 0;
+
+  int first = from > 0 ? upperBound(f, from - 1) : 0;
+  int last = upperBound(f, to);  // one past
+  int n = 0;
+  for (int i = first; i < last && n < maxRecords;) {
+    // One read per block, split where the ring wraps
+    int slot = slotOf(i);
+    int run = min(min(last - i, maxRecords - n), min(HISTORY_BLOCK_RECORDS, HISTORY_CAPACITY - slot));
+    if (!readSlots(f, slot, out + n, run)) break;
+    n += run;
+    i += run;
+  }
+  f.close();
+  return n;
+}
+
+bool findHistoryBefore(const LocationInfo &location, uint32_t t, HistoryRecord &out) {
+  if (!historyLoaded) loadHistory();
+  if (historyRecords == 0) return false;
+  File f = STORAGE_FS.open(HISTORY_FILE, FILE_READ);
+  if (!f) return false;
+
+  uint8_t spot = historySpotTag(location.latitude, location.longitude);
+  int end = upperBound(f, t);  // records before this index are at or before t
+  int begin = max(0, end - HISTORY_LOOKBACK);
+  bool found = false;
+  HistoryRecord block[HISTORY_BLOCK_RECORDS];
+  while (end > begin && !found) {
+    // Read the block ending at end, then scan it newest first
+    int slot = slotOf(end - 1);
+    int run = min(min(end - begin, HISTORY_BLOCK_RECORDS), slot + 1);
+    if (!readSlots(f, slot - run + 1, block, run)) break;
+    for (int k = run - 1; k >= 0; k--) {
+      if (block[k].spot != spot) continue;
+      out = block[k];
+      found = true;
+      break;
+    }
+    end -= run;
+  }
+  f.close();
+  return found;
+}
+
+int historyCount() {
+  if (!historyLoaded) loadHistory();
+  return historyRecords;
+}
+
+void clearHistory() {
+  historyLoaded = true;
+  historyRecords = 0;
+  historyOldest = 0;
+  historyNewest = HistoryRecord();
+  if (STORAGE_FS.exists(HISTORY_FILE)) STORAGE_FS.remove(HISTORY_FILE);
+  LOG_INFO("Cleared history.");
+}
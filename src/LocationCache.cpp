@@ -0,0 +1,148 @@
+#include "LocationCache.h"
+#include "Config.h"
+#include "Storage.h"
+#include "Log.h"
+#include <time.h>
+#include <vector>
+
+// Cells live in RAM once loaded, most recently used first. Station and NWS
+// resolutions are kept for a month (the station table ships with the firmware,
+// NWS grids rarely move); the series is kept as is and used only while it
+// still covers the current hour.
+
+static const uint32_t LOCATION_CACHE_MAGIC = 0x31445247;  // "GRD1"
+static const size_t LOCATION_CACHE_ENTRIES = 8;
+static const uint32_t LOCATION_CELL_TTL_S = 30UL * 24UL * 60UL * 60UL;
+
+static std::vector<LocationCell> cells;
+static bool cellsLoaded = false;
+static bool cellsDirty = false;
+
+static int16_t cellIndex(float degrees) {
+  return (int16_t)floorf(degrees / LOCATION_CELL_DEG);
+}
+
+// Wall-clock seconds, or 0 before NTP sync
+static uint32_t cacheNow() {
+  time_t now = time(nullptr);
+  return now >= 1000000000 ? (uint32_t)now : 0;
+}
+
+static bool expired(const LocationCell &cell) {
+  uint32_t now = cacheNow();
+  if (now == 0 || cell.storedAt == 0) return false;
+  return now - cell.storedAt > LOCATION_CELL_TTL_S;
+}
+
+static void loadLocationCache() {
+  cellsLoaded = true;
+  cells.clear();
+  if (!STORAGE_FS.exists(LOCATION_CACHE_FILE)) return;
+  File f = STORAGE_FS.open(LOCATION_CACHE_FILE, FILE_READ);
+  if (!f) return;
+  uint32_t magic = 0;
+  if (f.read((uint8_t *)&magic, sizeof(magic)) == sizeof(magic) && magic == LOCATION_CACHE_MAGIC) {
+    LocationCell cell;
+    while (cells.size() < LOCATION_CACHE_ENTRIES && f.read((uint8_t *)&cell, sizeof(cell)) == sizeof(cell)) {
+      cells.push_back(cell);
+    }
+  } else {
+    LOG_ERROR("Location cache file has unknown format, ignoring.");
+  }
+  f.close();
+  LOG_INFO("Loaded %u cached location cells.", cells.size());
+}
+
+static void saveLocationCache() {
+  File f = openReplace(LOCATION_CACHE_FILE);
+  if (!f) {
+    LOG_ERROR("Failed to open location cache file for write.");
+    return;
+  }
+  bool ok = f.write((const uint8_t *)&LOCATION_CACHE_MAGIC, sizeof(LOCATION_CACHE_MAGIC)) == sizeof(LOCATION_CACHE_MAGIC);
+  if (ok && !cells.empty()) {
+    ok = f.write((const uint8_t *)cells.data(), sizeof(LocationCell) * cells.size()) == sizeof(LocationCell) * cells.size();
+  }
+  if (!ok) LOG_ERROR("Failed to write location cache file.");
+  commitReplace(f, LOCATION_CACHE_FILE, ok);
+}
+
+bool sameLocationCell(const LocationCell &cell, float latitude, float longitude) {
+  return cell.latCell == cellIndex(latitude) && cell.lonCell == cellIndex(longitude);
+}
+
+LocationCell lookupLocationCell(float latitude, float longitude) {
+  if (!cellsLoaded) loadLocationCache();
+  for (size_t i = 0; i < cells.size(); i++) {
+    if (!sameLocationCell(cells[i], latitude, longitude)) continue;
+    LocationCell hit = cells[i];
+    cells.erase(cells.begin() + i);
+    if (expired(hit)) {
+      cellsDirty = true;
+      break;
+    }
+    cells.insert(cells.begin(), hit);
+    return hit;
+  }
+  LocationCell blank;
+  blank.latCell = cellIndex(latitude);
+  blank.lonCell = cellIndex(longitude);
+  return blank;
+}
+
+static bool sameSeries(const ForecastSeries &a, const ForecastSeries &b) {
+  if (a.start != b.start || a.count != b.count || a.hasWind != b.hasWind || a.valid != b.valid) return false;
+  size_t bytes = min((int)a.count, FORECAST_SERIES_HOURS) * sizeof(uint16_t);
+  return memcmp(a.waveHeightCm, b.waveHeightCm, bytes) == 0 && memcmp(a.wavePeriodDs, b.wavePeriodDs, bytes) == 0 &&
+         memcmp(a.waveDirectionDeg, b.waveDirectionDeg, bytes) == 0 &&
+         memcmp(a.windSpeedX10, b.windSpeedX10, bytes) == 0 && memcmp(a.windDirectionDeg, b.windDirectionDeg, bytes) == 0;
+}
+
+// Field by field: the struct has padding, which memcmp would compare too
+static bool sameCell(const LocationCell &a, const LocationCell &b) {
+  if (a.latCell != b.latCell || a.lonCell != b.lonCell || a.storedAt != b.storedAt ||
+      a.stationsResolved != b.stationsResolved || a.stationCount != b.stationCount) {
+    return false;
+  }
+  for (int i = 0; i < a.stationCount && i < LOCATION_CELL_STATIONS; i++) {
+    if (strncmp(a.stationId[i], b.stationId[i], sizeof(a.stationId[i])) != 0 ||
+        a.stationDistKm[i] != b.stationDistKm[i]) {
+      return false;
+    }
+  }
+  return strncmp(a.nwsForecastUrl, b.nwsForecastUrl, sizeof(a.nwsForecastUrl)) == 0 && sameSeries(a.series, b.series);
+}
+
+void storeLocationCell(const LocationCell &cell) {
+  if (!cellsLoaded) loadLocationCache();
+  LocationCell entry = cell;
+  bool changed = true;
+  for (size_t i = 0; i < cells.size(); i++) {
+    if (cells[i].latCell == entry.latCell && cells[i].lonCell == entry.lonCell) {
+      if (entry.storedAt == 0) entry.storedAt = cells[i].storedAt;
+      // Only the LRU order moves for an unchanged cell; like a lookup hit,
+      // that reaches flash with the next real change
+      changed = !sameCell(cells[i], entry);
+      cells.erase(cells.begin() + i);
+      break;
+    }
+  }
+  if (entry.storedAt == 0) entry.storedAt = cacheNow();
+  cells.insert(cells.begin(), entry);
+  if (cells.size() > LOCATION_CACHE_ENTRIES) cells.resize(LOCATION_CACHE_ENTRIES);
+  if (changed) cellsDirty = true;
+}
+
+void flushLocationCache() {
+  if (!cellsDirty) return;
+  saveLocationCache();
+  cellsDirty = false;
+}
+
+void clearLocationCache() {
+  cells.clear();
+  cellsLoaded = true;
+  cellsDirty = false;
+  if (STORAGE_FS.exists(LOCATION_CACHE_FILE)) STORAGE_FS.remove(LOCATION_CACHE_FILE);
+  LOG_INFO("Cleared location cache.");
+}
@@ -0,0 +1,207 @@
+#include "Log.h"
+#include <freertos/FreeRTOS.h>
+#include <stdio.h>
+
+// Records from both cores go into one byte ring under a spinlock; when it is
+// full the oldest records are dropped (and counted) to make room. Nothing is
+// formatted until logDrain() takes a record back out.
+
+static uint8_t ring[LOG_RING_BYTES];
+static size_t ringHead = 0;   // next byte written
+static size_t ringTail = 0;   // first byte of the oldest record
+static size_t ringUsed = 0;
+static uint32_t droppedRecords = 0;
+static portMUX_TYPE ringMux = portMUX_INITIALIZER_UNLOCKED;
+
+static const size_t LOG_HEADER_BYTES = 2 + 4 + sizeof(const char *);
+
+// The longest line a record prints as: "#L", two hex digits a byte, newline
+// (formatted text is cut to fit the same buffer)
+static const size_t LOG_LINE_MAX = 2 + 2 * LOG_RECORD_MAX + 1;
+
+void logdetail::commit(Record &r) {
+  r.data[0] = (uint8_t)r.len;
+  portENTER_CRITICAL(&ringMux);
+  while (LOG_RING_BYTES - ringUsed < r.len) {
+    size_t oldest = ring[ringTail];
+    ringTail = (ringTail + oldest) % LOG_RING_BYTES;
+    ringUsed -= oldest;
+    droppedRecords++;
+  }
+  for (size_t i = 0; i < r.len; i++) ring[(ringHead + i) % LOG_RING_BYTES] = r.data[i];
+  ringHead = (ringHead + r.len) % LOG_RING_BYTES;
+  ringUsed += r.len;
+  portEXIT_CRITICAL(&ringMux);
+}
+
+// Take the oldest record out of the ring. Returns its length, 0 if empty.
+static size_t takeRecord(uint8_t *out) {
+  portENTER_CRITICAL(&ringMux);
+  size_t len = ringUsed > 0 ? ring[ringTail] : 0;
+  for (size_t i = 0; i < len; i++) out[i] = ring[(ringTail + i) % LOG_RING_BYTES];
+  ringTail = (ringTail + len) % LOG_RING_BYTES;
+  ringUsed -= len;
+  portEXIT_CRITICAL(&ringMux);
+  return len;
+}
+
+static uint32_t takeDroppedCount() {
+  portENTER_CRITICAL(&ringMux);
+  uint32_t dropped = droppedRecords;
+  droppedRecords = 0;
+  portEXIT_CRITICAL(&ringMux);
+  return dropped;
+}
+
+// Append one argument to out, formatted by spec (which ends in its conversion
+// character) but read as the type it was recorded with.
+static size_t formatArg(char *out, size_t room, const char *spec, size_t specLen, const uint8_t *&arg,
+                        const uint8_t *end) {
+  if (arg >= end) return snprintf(out, room, "<?>");
+  char conv = spec[specLen - 1];
+  // Keep flags, width and precision; the length comes from the recorded type
+  char fmt[16];
+  size_t n = 0;
+  for (size_t i = 0; i < specLen - 1 && n < sizeof(fmt) - 4; i++) {
+    if (spec[i] != 'l' && spec[i] != 'h' && spec[i] != 'z' && spec[i] != 'j') fmt[n++] = spec[i];
+  }
+  uint8_t type = *arg++;
+  if (type == LOG_ARG_STR) {
+    uint8_t len = *arg++;
+    char text[LOG_MAX_STRING + 1];
+    memcpy(text, arg, len);
+    text[len] = '\0';
+    arg += len;
+    fmt[n++] = 's';
+    fmt[n] = '\0';
+    return snprintf(out, room, fmt, text);
+  }
+  if (type == LOG_ARG_F32) {
+    float v;
+    memcpy(&v, arg, 4);
+    arg += 4;
+    fmt[n++] = strchr("eEfFgGaA", conv) ? conv : 'f';
+    fmt[n] = '\0';
+    return snprintf(out, room, fmt, (double)v);
+  }
+  bool wide = type == LOG_ARG_I64 || type == LOG_ARG_U64;
+  long long sv = 0;
+  unsigned long long uv = 0;
+  if (type == LOG_ARG_I32) { int32_t v; memcpy(&v, arg, 4); sv = v; uv = (uint32_t)v; }
+  if (type == LOG_ARG_U32) { uint32_t v; memcpy(&v, arg, 4); sv = v; uv = v; }
+  if (type == LOG_ARG_I64) { int64_t v; memcpy(&v, arg, 8); sv = v; uv = (uint64_t)v; }
+  if (type == LOG_ARG_U64) { uint64_t v; memcpy(&v, arg, 8); sv = (long long)v; uv = v; }
+  arg += wide ? 8 : 4;
+  if (strchr("eEfFgGaA", conv)) {
+    fmt[n++] = conv;
+    fmt[n] = '\0';
+    return snprintf(out, room, fmt, (double)sv);
+  }
+  if (conv == 'c') {
+    fmt[n++] = 'c';
+    fmt[n] = '\0';
+    return snprintf(out, room, fmt, (int)sv);
+  }
+  fmt[n++] = 'l';
+  fmt[n++] = 'l';
+  if (conv == 'x' || conv == 'X' || conv == 'o') {
+    fmt[n++] = conv;
+    fmt[n] = '\0';
+    return snprintf(out, room, fmt, uv);
+  }
+  bool isSigned = type == LOG_ARG_I32 || type == LOG_ARG_I64;
+  fmt[n++] = isSigned ? 'd' : 'u';
+  fmt[n] = '\0';
+  return isSigned ? snprintf(out, room, fmt, sv) : snprintf(out, room, fmt, uv);
+}
+
+// Format a record as a line of text, newline included, into line (room
+// bytes). Returns the line's length.
+static size_t formatText(const uint8_t *record, size_t len, char *line, size_t room) {
+  uint8_t level = record[1];
+  uint32_t ms;
+  const char *format;
+  memcpy(&ms, record + 2, 4);
+  memcpy(&format, record + 6, sizeof(format));
+  const uint8_t *arg = record + LOG_HEADER_BYTES;
+  const uint8_t *end = record + len;
+
+  size_t pos = 0;
+  if (level != LOG_LEVEL_DATA) {
+    pos = snprintf(line, room, "[%-5s %10lu ms] ",
+                   level == LOG_LEVEL_ERROR ? "ERROR" : (level == LOG_LEVEL_DEBUG ? "DEBUG" : "INFO"),
+                   (unsigned long)ms);
+  }
+  // One byte stays free for the newline
+  for (const char *p = format; *p && pos < room - 2; p++) {
+    if (*p != '%') {
+      line[pos++] = *p;
+      continue;
+    }
+    if (p[1] == '%') {
+      line[pos++] = '%';
+      p++;
+      continue;
+    }
+    size_t specLen = 1;
+    while (p[specLen] && !strchr("diouxXeEfFgGaAcsp", p[specLen])) specLen++;
+    if (!p[specLen]) break;
+    specLen++;
+    size_t written = formatArg(line + pos, room - 1 - pos, p, specLen, arg, end);
+    pos = pos + written < room - 2 ? pos + written : room - 2;
+    p += specLen - 1;
+  }
+  line[pos++] = '\n';
+  return pos;
+}
+
+#ifndef LOG_TEXT
+// As "#L" and the record in hex, for decode_log.py
+static size_t formatHex(const uint8_t *record, size_t len, char *line) {
+  static const char *HEX_DIGITS = "0123456789abcdef";
+  size_t pos = 0;
+  line[pos++] = '#';
+  line[pos++] = 'L';
+  for (size_t i = 0; i < len; i++) {
+    line[pos++] = HEX_DIGITS[record[i] >> 4];
+    line[pos++] = HEX_DIGITS[record[i] & 0x0F];
+  }
+  line[pos++] = '\n';
+  return pos;
+}
+#endif
+
+// Data records are always text, so a capture is readable without the ELF;
+// the rest are text only in LOG_TEXT builds.
+static size_t formatRecord(const uint8_t *record, size_t len, char *line, size_t room) {
+#ifdef LOG_TEXT
+  return formatText(record, len, line, room);
+#else
+  if (record[1] == LOG_LEVEL_DATA) return formatText(record, len, line, room);
+  return formatHex(record, len, line);
+#endif
+}
+
+// A formatted line is written only once the UART's TX buffer has room for all
+// of it; until then it waits here, and so does everything behind it.
+static char pendingLine[LOG_LINE_MAX];
+static size_t pendingLength = 0;
+
+void logDrain() {
+  uint8_t record[LOG_RECORD_MAX];
+  while (true) {
+    if (pendingLength > 0) {
+      if (Serial.availableForWrite() < (int)pendingLength) return;
+      Serial.write((const uint8_t *)pendingLine, pendingLength);
+      pendingLength = 0;
+    }
+    uint32_t dropped = takeDroppedCount();
+    if (dropped > 0) {
+      pendingLength = snprintf(pendingLine, sizeof(pendingLine), "[LOG] %lu records dropped\n", (unsigned long)dropped);
+      continue;
+    }
+    size_t len = takeRecord(record);
+    if (len == 0) return;
+    pendingLength = formatRecord(record, len, pendingLine, sizeof(pendingLine));
+  }
+}
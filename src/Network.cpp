@@ -2,10 +2,22 @@
 #include "Config.h"
 #include "Storage.h"
 #include "Theme.h"
+#include "TidePredictor.h"
+#include "TideStations.h"
+#include "SurfSpots.h"
+#include "SearchCache.h"
+#include "LocationCache.h"
+#include "RefreshScheduler.h"
+#include "Diagnostics.h"
+#include "Log.h"
 #include <WiFi.h>
 #include <HTTPClient.h>
+#include <WiFiClientSecure.h>
 #include <ArduinoJson.h>
 #include <Arduino_GFX_Library.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/semphr.h>
+#include <esp32/rom/miniz.h>
 
 extern Arduino_GFX *gfx;
 extern Theme currentTheme;
@@ -13,15 +25,10 @@ extern Theme currentTheme;
 // Forward declaration
 void showStatus(const String &line1, const String &line2, uint16_t color);
 
-// File-scope tide station cache (can be cleared from outside via clearTideStationCache)
-static String cachedStationId = "";
-static float cachedStationLat = 0.0f;
-static float cachedStationLon = 0.0f;
-
-// File-scope NOAA NWS wind grid URL cache (cleared alongside tide station cache)
-static String cachedNoaaGridUrl = "";
-static float cachedNoaaWindLat = 0.0f;
-static float cachedNoaaWindLon = 0.0f;
+// Grid cell of the spot being forecast: its resolved stations, NWS forecast URL
+// and last series (see LocationCache.h). Reloaded when the spot changes cell.
+static LocationCell currentCell;
+static bool haveCurrentCell = false;
 
 // Blend candidates: up to 3 nearest unique tide stations for the current location,
 // populated by findNearestTideStation and used for inverse-square-distance weighting.
@@ -32,15 +39,589 @@ struct TideCandidate {
 static TideCandidate cachedCandidates[3];
 static int           cachedCandidateCount = 0;
 
-void clearTideStationCache() {
-  cachedStationId = "";
-  cachedStationLat = 0.0f;
-  cachedStationLon = 0.0f;
-  cachedNoaaGridUrl = "";
-  cachedNoaaWindLat = 0.0f;
-  cachedNoaaWindLon = 0.0f;
-  cachedCandidateCount = 0;
-  Serial.println("[TIDE] Station cache cleared");
+// Recursive so public entry points can call each other while holding it
+static SemaphoreHandle_t networkMutex = nullptr;
+
+void lockNetwork() {
+  if (!networkMutex) networkMutex = xSemaphoreCreateRecursiveMutex();
+  xSemaphoreTakeRecursive(networkMutex, portMAX_DELAY);
+}
+
+void unlockNetwork() {
+  xSemaphoreGiveRecursive(networkMutex);
+}
+
+static LocationCell &locationCellFor(float latitude, float longitude) {
+  if (!haveCurrentCell || !sameLocationCell(currentCell, latitude, longitude)) {
+    currentCell = lookupLocationCell(latitude, longitude);
+    haveCurrentCell = true;
+  }
+  return currentCell;
+}
+
+// ── HTTPS connection pool ───────────────────────────────────────────────────
+// One refresh talks to the same few hosts several times (marine API, up to three
+// NOAA stations, NWS points + forecast). Each slot keeps a WiFiClientSecure open
+// with HTTP/1.1 keep-alive so follow-up requests to the same host skip the TLS
+// handshake, and caches the host's address so reconnects skip DNS as well.
+// Sessions are closed by closeHttpConnections() at the end of each refresh or
+// search; only the DNS results survive between them.
+struct PooledConnection {
+  char host[48];
+  IPAddress ip;
+  uint32_t resolvedAt;        // millis() of the DNS lookup, 0 = not resolved
+  uint32_t lastUsed;
+  WiFiClientSecure *client;   // nullptr when no session is held
+};
+
+static const int POOL_SLOTS = 4;
+static const int POOL_MAX_OPEN = 2;                     // each TLS session pins ~40 KB of heap
+static const uint32_t POOL_IDLE_TIMEOUT_MS = 15000;     // servers drop idle keep-alives
+static const uint32_t DNS_CACHE_TTL_MS = 30UL * 60UL * 1000UL;
+
+static PooledConnection connectionPool[POOL_SLOTS];
+
+static String hostFromUrl(const String &url) {
+  int start = url.indexOf("://");
+  start = (start < 0) ? 0 : start + 3;
+  int end = start;
+  while (end < (int)url.length() && url.charAt(end) != '/' && url.charAt(end) != ':' && url.charAt(end) != '?') end++;
+  return url.substring(start, end);
+}
+
+static void closePooledSession(PooledConnection &slot) {
+  if (!slot.client) return;
+  slot.client->stop();
+  delete slot.client;
+  slot.client = nullptr;
+}
+
+void closeHttpConnections() {
+  NetworkLock lock;
+  for (int i = 0; i < POOL_SLOTS; i++) closePooledSession(connectionPool[i]);
+}
+
+// Returns a connected (or at least configured) client for the URL's host, or
+// nullptr for non-HTTPS URLs. If the pre-connect fails, HTTPClient falls back
+// to connecting by hostname on the same client.
+static WiFiClientSecure *acquirePooledClient(const String &url, const char *request) {
+  if (!url.startsWith("https://")) return nullptr;
+  String host = hostFromUrl(url);
+  if (host.isEmpty() || host.length() >= sizeof(connectionPool[0].host)) return nullptr;
+
+  uint32_t now = millis();
+  PooledConnection *slot = nullptr;
+  for (int i = 0; i < POOL_SLOTS; i++) {
+    if (strcmp(connectionPool[i].host, host.c_str()) == 0) { slot = &connectionPool[i]; break; }
+  }
+  if (!slot) {
+    // Take an empty slot, else the least recently used one
+    slot = &connectionPool[0];
+    for (int i = 0; i < POOL_SLOTS; i++) {
+      if (connectionPool[i].host[0] == '\0') { slot = &connectionPool[i]; break; }
+      if (connectionPool[i].lastUsed < slot->lastUsed) slot = &connectionPool[i];
+    }
+    closePooledSession(*slot);
+    strncpy(slot->host, host.c_str(), sizeof(slot->host) - 1);
+    slot->host[sizeof(slot->host) - 1] = '\0';
+    slot->resolvedAt = 0;
+  }
+
+  if (slot->client && slot->client->connected() && now - slot->lastUsed < POOL_IDLE_TIMEOUT_MS) {
+    slot->lastUsed = now;
+    LOG_DEBUG("[HTTP] Reusing keep-alive session to %s", slot->host);
+    return slot->client;
+  }
+
+  if (slot->client) {
+    slot->client->stop();
+  } else {
+    // Cap simultaneous TLS sessions; close the least recently used other one
+    int open = 0;
+    PooledConnection *lru = nullptr;
+    for (int i = 0; i < POOL_SLOTS; i++) {
+      PooledConnection &c = connectionPool[i];
+      if (&c == slot || !c.client) continue;
+      open++;
+      if (!lru || c.lastUsed < lru->lastUsed) lru = &c;
+    }
+    if (open >= POOL_MAX_OPEN && lru) closePooledSession(*lru);
+    slot->client = new WiFiClientSecure();
+    slot->client->setInsecure();
+  }
+
+  if (slot->resolvedAt == 0 || now - slot->resolvedAt > DNS_CACHE_TTL_MS) {
+    StageTimer dns(request, STAGE_DNS);
+    slot->resolvedAt = (WiFi.hostByName(slot->host, slot->ip) == 1) ? now : 0;
+    dns.finish(slot->resolvedAt ? 0 : -1);
+    if (slot->resolvedAt == 0) LOG_ERROR("DNS lookup failed for %s", slot->host);
+  }
+  if (slot->resolvedAt != 0) {
+    // Connect by cached IP; the hostname still goes out as SNI.
+    StageTimer tls(request, STAGE_TLS);
+    int connected = slot->client->connect(slot->ip, 443, slot->host, nullptr, nullptr, nullptr);
+    tls.finish(connected ? 0 : -1);
+  }
+  slot->lastUsed = now;
+  return slot->client;
+}
+
+// gzip bodies are inflated while they are parsed (GzipBodyStream below), which
+// needs the 32 KB LZ window, the ~11 KB decompressor and a small input buffer
+// for the length of one parse.
+static const size_t INFLATE_INPUT_BYTES = 512;
+static const size_t INFLATE_HEAP_BYTES = sizeof(tinfl_decompressor) + TINFL_LZ_DICT_SIZE + INFLATE_INPUT_BYTES;
+static const size_t INFLATE_HEAP_MARGIN = 16 * 1024;   // left over for TLS records and the document
+
+// Offer gzip only while the inflater fits beside the open TLS sessions;
+// otherwise the server sends identity and nothing changes.
+static bool gzipAffordable() {
+  return ESP.getMaxAllocHeap() >= TINFL_LZ_DICT_SIZE && ESP.getFreeHeap() >= INFLATE_HEAP_BYTES + INFLATE_HEAP_MARGIN;
+}
+
+// Label of the request in progress, for its diagnostics samples
+static const char *activeRequest = "";
+
+// Prepare a GET on the pooled keep-alive session for the URL's host. request
+// labels the diagnostics samples of this request (a short static string).
+static void beginHttpGet(HTTPClient &http, const String &url, uint16_t timeoutMs, const char *request) {
+  static const char *headerKeys[] = {"Transfer-Encoding", "Content-Encoding", "Cache-Control", "Expires", "Date",
+                                     "Age", "ETag", "Last-Modified"};
+  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
+  activeRequest = request;
+  WiFiClientSecure *client = acquirePooledClient(url, request);
+  if (client) {
+    http.setReuse(true);
+    http.begin(*client, url);
+  } else {
+    http.begin(url);
+  }
+  http.setTimeout(timeoutMs);
+  http.collectHeaders(headerKeys, sizeof(headerKeys) / sizeof(headerKeys[0]));
+  // HTTPClient always sends its own identity preference; naming gzip as well
+  // lets the server pick it, which they do when it is offered at equal weight.
+  if (gzipAffordable()) http.addHeader("Accept-Encoding", "gzip");
+}
+
+// Send the GET, timing it until the status line and headers are in.
+static int timedGet(HTTPClient &http) {
+  StageTimer timer(activeRequest, STAGE_FIRST_BYTE);
+  int code = http.GET();
+  timer.finish(code, code > 0 ? max(http.getSize(), 0) : 0);
+  return code;
+}
+
+// End a request whose body was not read (error status). Closing the socket keeps
+// the unread bytes from being mistaken for the next response on this session.
+static void endHttpDiscard(HTTPClient &http) {
+  http.getStream().stop();
+  http.end();
+}
+
+const char *VALIDATOR_HEADERS[2] = {"ETag", "Last-Modified"};
+
+void sendValidators(HTTPClient &http, const HttpValidators &validators) {
+  if (!validators.etag.isEmpty()) http.addHeader("If-None-Match", validators.etag);
+  if (!validators.lastModified.isEmpty()) http.addHeader("If-Modified-Since", validators.lastModified);
+}
+
+bool storeValidators(HTTPClient &http, HttpValidators &validators) {
+  validators.etag = http.header("ETag");
+  validators.lastModified = http.header("Last-Modified");
+  return !validators.etag.isEmpty() || !validators.lastModified.isEmpty();
+}
+
+// ── Backoff and circuit breakers ────────────────────────────────────────────
+// Every request is checked against two breakers before any TLS work: one for
+// its host (timeouts, connection failures, 5xx, 429) and optionally one for
+// the specific endpoint, such as a NOAA station or an NWS points lookup. A
+// breaker opens after a run of failures and stays open for a jittered,
+// doubling interval; once it elapses a single trial request is let through,
+// and its result closes the breaker or reopens it for longer.
+//
+// 4xx answers (other than 429) say the endpoint itself is wrong — a station
+// without predictions, an NWS points lookup outside the US — so they open the
+// endpoint breaker at once and for hours rather than minutes.
+
+struct CircuitBreaker {
+  char key[40];          // host name, or caller's endpoint key
+  uint8_t failures;      // consecutive
+  uint32_t openedAt;     // millis()
+  uint32_t openMs;       // 0 = closed
+  uint32_t lastUsed;
+};
+
+struct BreakerPolicy {
+  uint8_t threshold;     // consecutive failures before opening
+  uint32_t baseMs;
+  uint32_t maxMs;
+};
+
+static const int BREAKER_SLOTS = 12;
+static const BreakerPolicy HOST_POLICY = {2, 30UL * 1000UL, 30UL * 60UL * 1000UL};
+static const BreakerPolicy ENDPOINT_POLICY = {2, 60UL * 1000UL, 60UL * 60UL * 1000UL};
+static const BreakerPolicy REJECTED_POLICY = {1, 6UL * 60UL * 60UL * 1000UL, 24UL * 60UL * 60UL * 1000UL};
+
+static CircuitBreaker breakers[BREAKER_SLOTS];
+
+// Half of the doubled delay is fixed and half random ("equal jitter").
+static uint32_t jitteredBackoffMs(uint32_t baseMs, uint32_t maxMs, uint8_t attempt) {
+  uint32_t delayMs = baseMs;
+  for (uint8_t i = 0; i < attempt && delayMs < maxMs; i++) delayMs *= 2;
+  if (delayMs > maxMs) delayMs = maxMs;
+  return delayMs / 2 + (uint32_t)random((long)(delayMs / 2 + 1));
+}
+
+static CircuitBreaker *findBreaker(const String &key, bool create) {
+  if (key.isEmpty()) return nullptr;
+  // Reuse an empty slot, else the least recently used closed one, else the
+  // least recently used of all
+  CircuitBreaker *victim = nullptr;
+  for (int i = 0; i < BREAKER_SLOTS; i++) {
+    CircuitBreaker &b = breakers[i];
+    if (strcmp(b.key, key.c_str()) == 0) return &b;
+    if (victim && victim->key[0] == '\0') continue;
+    if (!victim || b.key[0] == '\0' || (b.openMs == 0) > (victim->openMs == 0) ||
+        ((b.openMs == 0) == (victim->openMs == 0) && b.lastUsed < victim->lastUsed)) {
+      victim = &b;
+    }
+  }
+  if (!create) return nullptr;
+  *victim = CircuitBreaker();
+  strncpy(victim->key, key.c_str(), sizeof(victim->key) - 1);
+  return victim;
+}
+
+static bool breakerAllows(const String &key) {
+  CircuitBreaker *b = findBreaker(key, false);
+  if (!b || b->openMs == 0) return true;
+  uint32_t elapsed = millis() - b->openedAt;
+  if (elapsed >= b->openMs) return true;  // half-open: one trial
+  LOG_DEBUG("[HTTP] Skipping %s, backing off for %lus more", b->key,
+            (unsigned long)((b->openMs - elapsed) / 1000));
+  return false;
+}
+
+static void breakerRecord(const String &key, bool failed, const BreakerPolicy &policy) {
+  CircuitBreaker *b = findBreaker(key, failed);
+  if (!b) return;
+  b->lastUsed = millis();
+  if (!failed) {
+    b->failures = 0;
+    b->openMs = 0;
+    return;
+  }
+  if (b->failures < 255) b->failures++;
+  if (b->failures < policy.threshold) return;
+  b->openedAt = millis();
+  b->openMs = jitteredBackoffMs(policy.baseMs, policy.maxMs, b->failures - policy.threshold);
+  LOG_ERROR("Circuit open for %s after %d failures; retry in %us", b->key, b->failures, b->openMs / 1000);
+}
+
+// Whether a request to url (and optionally a named endpoint on it) may go out.
+// Check this before beginHttpGet() so a skipped request costs no handshake.
+static bool endpointAvailable(const String &url, const String &endpoint = "") {
+  return breakerAllows(hostFromUrl(url)) && breakerAllows(endpoint);
+}
+
+// Feed a GET's status code to the host and endpoint breakers.
+static void recordEndpointResult(const String &url, int code, const String &endpoint = "") {
+  bool transportFailure = code <= 0 || code >= 500 || code == 429;
+  bool rejected = code >= 400 && code < 500 && code != 429;
+  breakerRecord(hostFromUrl(url), transportFailure, HOST_POLICY);
+  breakerRecord(endpoint, transportFailure || rejected, rejected ? REJECTED_POLICY : ENDPOINT_POLICY);
+}
+
+uint32_t backoffAfterFailure(RetryBackoff &backoff) {
+  backoff.waitMs = jitteredBackoffMs(backoff.baseMs, backoff.maxMs, backoff.failures);
+  backoff.waitStart = millis();
+  if (backoff.failures < 255) backoff.failures++;
+  return backoff.waitMs;
+}
+
+void backoffReset(RetryBackoff &backoff, uint32_t waitMs) {
+  backoff.failures = 0;
+  backoff.waitStart = millis();
+  backoff.waitMs = waitMs;
+}
+
+void backoffRetryNow(RetryBackoff &backoff) {
+  backoff.waitMs = 0;
+}
+
+bool backoffDue(const RetryBackoff &backoff) {
+  return millis() - backoff.waitStart >= backoff.waitMs;
+}
+
+uint32_t backoffRemainingMs(const RetryBackoff &backoff) {
+  uint32_t elapsed = millis() - backoff.waitStart;
+  return elapsed >= backoff.waitMs ? 0 : backoff.waitMs - elapsed;
+}
+
+// Response body reader over the raw socket. Decodes chunked transfer encoding
+// and stops at Content-Length, so keep-alive bodies can be fed straight into
+// ArduinoJson and then drained, leaving the connection ready for the next request.
+class HttpBodyStream : public Stream {
+ public:
+  explicit HttpBodyStream(HTTPClient &http) : src_(http.getStream()) {
+    chunked_ = http.header("Transfer-Encoding").equalsIgnoreCase("chunked");
+    remaining_ = chunked_ ? 0 : http.getSize();   // -1 = read until close
+  }
+
+  int available() override {
+    if (done_) return 0;
+    int avail = src_.available();
+    if (!chunked_ && remaining_ >= 0 && avail > remaining_) avail = remaining_;
+    return avail;
+  }
+
+  int read() override {
+    if (!nextByteReady()) return -1;
+    int c = readRaw();
+    if (c >= 0 && remaining_ > 0) remaining_--;
+    return c;
+  }
+
+  int peek() override {
+    if (!nextByteReady()) return -1;
+    return src_.peek();
+  }
+
+  size_t write(uint8_t) override { return 0; }
+
+  // Bytes taken off the socket (chunk framing included) and the time spent
+  // waiting for them
+  uint32_t bytesRead() const { return bytesRead_; }
+  uint32_t waitMs() const { return waitMs_; }
+
+  // Consume whatever is left of the body. Returns false when the body length
+  // is unknown, in which case the connection cannot carry another request.
+  bool drain() {
+    if (!chunked_ && remaining_ < 0) return false;
+    uint32_t start = millis();
+    while (nextByteReady()) {
+      if (readRaw() < 0 || millis() - start > 2000) return false;
+      if (remaining_ > 0) remaining_--;
+    }
+    return true;
+  }
+
+ private:
+  int readRaw() {
+    uint8_t b;
+    uint32_t start = millis();
+    bool got = src_.readBytes(&b, 1) == 1;
+    waitMs_ += millis() - start;
+    if (!got) return -1;
+    bytesRead_++;
+    return b;
+  }
+
+  // For chunked bodies, step over chunk headers/trailers until a data byte or the end.
+  bool nextByteReady() {
+    if (done_) return false;
+    if (!chunked_) {
+      if (remaining_ == 0) done_ = true;
+      return !done_;
+    }
+    while (remaining_ == 0) {
+      if (!firstChunk_) { readRaw(); readRaw(); }   // CRLF after previous chunk data
+      firstChunk_ = false;
+      long size = 0;
+      bool digits = true;
+      int c;
+      while ((c = readRaw()) >= 0 && c != '\n') {
+        if (c == ';' || c == '\r') digits = false;
+        if (!digits || !isxdigit(c)) continue;
+        size = size * 16 + (isdigit(c) ? c - '0' : (tolower(c) - 'a' + 10));
+      }
+      if (c < 0) { done_ = true; return false; }
+      if (size == 0) {
+        // Terminal chunk: skip optional trailers up to the blank line
+        int lineLen = 0;
+        while ((c = readRaw()) >= 0) {
+          if (c == '\n') { if (lineLen == 0) break; lineLen = 0; }
+          else if (c != '\r') lineLen++;
+        }
+        done_ = true;
+        return false;
+      }
+      remaining_ = size;
+    }
+    return true;
+  }
+
+  WiFiClient &src_;
+  uint32_t bytesRead_ = 0;
+  uint32_t waitMs_ = 0;
+  bool chunked_ = false;
+  bool firstChunk_ = true;
+  bool done_ = false;
+  long remaining_ = 0;
+};
+
+// gzip body (RFC 1952) inflated on the fly by the ROM's tinfl, so neither the
+// compressed nor the inflated body is ever held whole. The window doubles as
+// the output buffer: bytes are handed to the reader straight out of it. The
+// trailer CRC is not checked; TLS already protects the bytes and the JSON
+// parse rejects a truncated body.
+class GzipBodyStream : public Stream {
+ public:
+  explicit GzipBodyStream(HttpBodyStream &src) : src_(src) {
+    inflator_ = (tinfl_decompressor *)malloc(sizeof(tinfl_decompressor));
+    window_ = (uint8_t *)malloc(TINFL_LZ_DICT_SIZE);
+    input_ = (uint8_t *)malloc(INFLATE_INPUT_BYTES);
+    if (inflator_) tinfl_init(inflator_);
+    ok_ = inflator_ && window_ && input_ && skipHeader();
+  }
+
+  ~GzipBodyStream() {
+    free(inflator_);
+    free(window_);
+    free(input_);
+  }
+
+  // False when the buffers could not be allocated or the header is not gzip.
+  bool ok() const { return ok_; }
+  size_t compressedBytes() const { return compressed_; }
+  size_t inflatedBytes() const { return inflated_; }
+
+  int available() override { return fill() ? (int)(outEnd_ - outPos_) : 0; }
+
+  int read() override {
+    if (!fill()) return -1;
+    inflated_++;
+    return window_[outPos_++];
+  }
+
+  int peek() override { return fill() ? window_[outPos_] : -1; }
+
+  size_t write(uint8_t) override { return 0; }
+
+ private:
+  // Top up the input buffer with what the socket has, waiting only for the first byte.
+  bool refillInput() {
+    inPos_ = inLen_ = 0;
+    while (inLen_ < INFLATE_INPUT_BYTES) {
+      int c = src_.read();
+      if (c < 0) break;
+      input_[inLen_++] = (uint8_t)c;
+      if (src_.available() == 0) break;
+    }
+    compressed_ += inLen_;
+    if (inLen_ == 0) srcDone_ = true;
+    return inLen_ > 0;
+  }
+
+  int readInput() {
+    if (inPos_ == inLen_ && !refillInput()) return -1;
+    return input_[inPos_++];
+  }
+
+  bool skipZeroTerminated() {
+    int c;
+    while ((c = readInput()) > 0) {}
+    return c == 0;
+  }
+
+  // Fixed 10-byte header, then the optional extra field, name, comment and CRC.
+  bool skipHeader() {
+    uint8_t fixed[10];
+    for (int i = 0; i < 10; i++) {
+      int c = readInput();
+      if (c < 0) return false;
+      fixed[i] = (uint8_t)c;
+    }
+    if (fixed[0] != 0x1f || fixed[1] != 0x8b || fixed[2] != 8) return false;
+    uint8_t flags = fixed[3];
+    if (flags & 0x04) {
+      int lo = readInput();
+      int hi = readInput();
+      if (lo < 0 || hi < 0) return false;
+      for (int n = lo | (hi << 8); n > 0; n--) {
+        if (readInput() < 0) return false;
+      }
+    }
+    if ((flags & 0x08) && !skipZeroTerminated()) return false;
+    if ((flags & 0x10) && !skipZeroTerminated()) return false;
+    if (flags & 0x02) {
+      if (readInput() < 0 || readInput() < 0) return false;
+    }
+    return true;
+  }
+
+  // Make at least one inflated byte available. False at the end of the stream.
+  bool fill() {
+    while (outPos_ == outEnd_) {
+      if (!ok_ || done_) return false;
+      if (outEnd_ == TINFL_LZ_DICT_SIZE) outPos_ = outEnd_ = 0;   // window wraps
+      if (inPos_ == inLen_ && !srcDone_) refillInput();
+      size_t inBytes = inLen_ - inPos_;
+      size_t outBytes = TINFL_LZ_DICT_SIZE - outEnd_;
+      tinfl_status status = tinfl_decompress(inflator_, input_ + inPos_, &inBytes, window_, window_ + outEnd_,
+                                             &outBytes, srcDone_ ? 0 : TINFL_FLAG_HAS_MORE_INPUT);
+      inPos_ += inBytes;
+      outEnd_ += outBytes;
+      if (status < TINFL_STATUS_DONE) {
+        LOG_ERROR("gzip inflate failed: status %d", (int)status);
+        ok_ = false;
+        return false;
+      }
+      if (status == TINFL_STATUS_DONE || (status == TINFL_STATUS_NEEDS_MORE_INPUT && srcDone_)) done_ = true;
+    }
+    return true;
+  }
+
+  HttpBodyStream &src_;
+  tinfl_decompressor *inflator_ = nullptr;
+  uint8_t *window_ = nullptr;
+  uint8_t *input_ = nullptr;
+  size_t inPos_ = 0;
+  size_t inLen_ = 0;
+  size_t outPos_ = 0;
+  size_t outEnd_ = 0;
+  size_t compressed_ = 0;
+  size_t inflated_ = 0;
+  bool srcDone_ = false;
+  bool done_ = false;
+  bool ok_ = false;
+};
+
+// Deserialize the response body from the HTTP stream, keeping only the fields
+// selected by filter. Nothing is buffered into a String, so peak heap is the
+// filtered document alone (plus the inflater for a gzip body). The rest of the
+// body is drained afterwards so the keep-alive session stays usable; if that
+// is impossible the socket is closed.
+//
+// Reading and parsing interleave, so the time blocked on the socket is
+// recorded as the body stage and the rest as the parse stage.
+static DeserializationError parseJsonStream(HTTPClient &http, JsonDocument &doc, const JsonDocument &filter) {
+  StageTimer bodyTimer(activeRequest, STAGE_BODY);
+  StageTimer parseTimer(activeRequest, STAGE_PARSE);
+  uint32_t start = millis();
+  uint32_t parsedBytes = 0;
+  HttpBodyStream body(http);
+  DeserializationError err;
+  if (http.header("Content-Encoding").equalsIgnoreCase("gzip")) {
+    GzipBodyStream inflated(body);
+    if (inflated.ok()) {
+      err = deserializeJson(doc, inflated, DeserializationOption::Filter(filter));
+      parsedBytes = inflated.inflatedBytes();
+      LOG_DEBUG("[HTTP] gzip: %u bytes inflated from %u", (unsigned)inflated.inflatedBytes(),
+                (unsigned)inflated.compressedBytes());
+    } else {
+      LOG_ERROR("gzip body could not be inflated");
+      err = DeserializationError::NoMemory;
+    }
+  } else {
+    err = deserializeJson(doc, body, DeserializationOption::Filter(filter));
+    parsedBytes = body.bytesRead();
+  }
+  if (err || !body.drain()) http.getStream().stop();
+  uint32_t elapsed = millis() - start;
+  bodyTimer.finish(0, body.bytesRead(), body.waitMs());
+  parseTimer.finish(err ? -1 : 0, parsedBytes, elapsed > body.waitMs() ? elapsed - body.waitMs() : 0);
+  return err;
 }
 
 String urlEncode(const String &value) {
@@ -61,51 +642,64 @@ String urlEncode(const String &value) {
   return encoded;
 }
 
-bool connectWifi(const WifiCredentials &creds) {
+// showProgress=false leaves the screen alone (e.g. a restored forecast at boot)
+bool connectWifi(const WifiCredentials &creds, bool showProgress) {
   if (!creds.valid) return false;
 
   WiFi.mode(WIFI_STA);
   WiFi.begin(creds.ssid.c_str(), creds.password.c_str());
-  showStatus("Connecting Wi-Fi", creds.ssid, currentTheme.textSecondary);
+  if (showProgress) showStatus("Connecting Wi-Fi", creds.ssid, currentTheme.textSecondary);
 
   for (uint8_t attempt = 0; attempt < 60; ++attempt) {
     if (WiFi.status() == WL_CONNECTED) {
-      showStatus("Wi-Fi connected", WiFi.localIP().toString(), currentTheme.success);
-      logInfo("Connected to Wi-Fi " + creds.ssid);
-      delay(1000);
+      LOG_INFO("Connected to Wi-Fi %s", creds.ssid);
+      if (showProgress) {
+        showStatus("Wi-Fi connected", WiFi.localIP().toString(), currentTheme.success);
+        delay(1000);
+      }
       return true;
     }
     delay(500);
   }
 
-  logError("Wi-Fi connection failed for SSID: " + creds.ssid);
+  LOG_ERROR("Wi-Fi connection failed for SSID: %s", creds.ssid);
   showStatus("Wi-Fi failed", "Tap to re-enter", currentTheme.error);
   return false;
 }
 
 std::vector<LocationInfo> fetchLocationMatches(const String &location, int maxResults) {
+  NetworkLock lock;
   std::vector<LocationInfo> matches;
+  if (lookupGeocodeCache(location, maxResults, matches)) return matches;
   if (WiFi.status() != WL_CONNECTED) return matches;
 
   HTTPClient http;
   String url = String(GEOCODE_URL) + "?name=" + urlEncode(location) + "&count=" + String(maxResults) + "&language=en&format=json";
-  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-  http.begin(url);
-  http.setTimeout(10000);
-  int code = http.GET();
+  if (!endpointAvailable(url)) return matches;
+  beginHttpGet(http, url, 10000, "geocode");
+  int code = timedGet(http);
+  recordEndpointResult(url, code);
   if (code != HTTP_CODE_OK) {
-    http.end();
+    endHttpDiscard(http);
     return matches;
   }
 
-  DynamicJsonDocument doc(12 * 1024);
-  String payload = http.getString();
+  // Only the fields used below; drops ids, elevation, timezone, postcodes, etc.
+  StaticJsonDocument<128> filter;
+  JsonObject resultFilter = filter["results"].createNestedObject();
+  resultFilter["name"] = true;
+  resultFilter["latitude"] = true;
+  resultFilter["longitude"] = true;
+  resultFilter["admin1"] = true;
+  resultFilter["country"] = true;
+
+  DynamicJsonDocument doc(6 * 1024);
+  DeserializationError err = parseJsonStream(http, doc, filter);
   http.end();
-  if (deserializeJson(doc, payload)) return matches;
+  if (err) return matches;
 
+  // No "results" key means no matches; that verdict is cached too
   JsonArray results = doc["results"];
-  if (results.isNull()) return matches;
-
   for (JsonObject result : results) {
     LocationInfo info;
     info.latitude = result["latitude"] | 0.0f;
@@ -118,663 +712,396 @@ std::vector<LocationInfo> fetchLocationMatches(const String &location, int maxRe
     info.valid = true;
     matches.push_back(info);
   }
+  storeGeocodeCache(location, maxResults, matches);
   return matches;
 }
 
 LocationInfo fetchLocation(const String &location) {
+  NetworkLock lock;
   LocationInfo info;
   auto matches = fetchLocationMatches(location, 1);
   if (!matches.empty()) return matches[0];
   return info;
 }
 
-// Find the nearest NOAA tide station to given coordinates using nearest-neighbor search.
-// Covers US East/Gulf/West coasts, Alaska, Hawaii, Puerto Rico, USVI, and Pacific territories.
-// Locations outside NOAA coverage (e.g. Portugal, El Salvador, Central America) will return ""
-// because no station will be within the MAX_STATION_DISTANCE_KM threshold.
-String findNearestTideStation(float latitude, float longitude) {
-  if (WiFi.status() != WL_CONNECTED) return "";
-
-  logInfo("Finding NOAA station for coordinates: lat=" + String(latitude, 6) + ", lon=" + String(longitude, 6));
-
-  struct TideStation {
-    float lat;
-    float lon;
-    const char *id;
-    const char *name;
-  };
+// Maximum distance (km) to accept a station — beyond this tide info is unavailable.
+// ~400 km covers coastal areas well while rejecting truly unsupported regions.
+static const float MAX_STATION_DISTANCE_KM = 400.0f;
 
-  // Maximum distance (km) to accept a station — beyond this tide info is unavailable.
-  // ~400 km covers coastal areas well while rejecting truly unsupported regions.
-  const float MAX_STATION_DISTANCE_KM = 400.0f;
-
-  static const TideStation stations[] = {
-    // ── US EAST COAST — MAINE ───────────────────────────────────────────────
-    { 44.903f,  -66.990f, "8410140", "Eastport, ME" },
-    { 44.646f,  -67.201f, "8411060", "Cutler Farris Wharf, ME" },
-    { 44.387f,  -68.204f, "8413320", "Bar Harbor, ME" },
-    { 44.225f,  -68.799f, "8414131", "Blue Hill, ME" },
-    { 44.017f,  -69.117f, "8415490", "Rockland, ME" },
-    { 43.951f,  -69.657f, "8416121", "Boothbay Harbor, ME" },
-    { 43.776f,  -70.008f, "8417177", "Wells, ME" },
-    { 43.657f,  -70.247f, "8418150", "Portland, ME" },
-    { 43.325f,  -70.560f, "8419317", "Kennebunk, ME" },
-    { 43.133f,  -70.650f, "8419363", "York Harbor, ME" },
-    // ── US EAST COAST — NEW HAMPSHIRE / MASSACHUSETTS ───────────────────────
-    { 42.980f,  -70.817f, "8423898", "Hampton Harbor, NH" },
-    { 42.814f,  -70.869f, "8425453", "Newburyport, MA" },
-    { 42.608f,  -70.660f, "8441501", "Gloucester, MA" },
-    { 42.359f,  -71.050f, "8443970", "Boston, MA" },
-    { 42.085f,  -70.203f, "8446166", "Plymouth, MA" },
-    { 41.753f,  -70.620f, "8447386", "Fall River, MA" },
-    { 41.524f,  -70.672f, "8447435", "New Bedford, MA" },
-    { 41.524f,  -70.671f, "8447505", "Chatham, MA" },
-    { 41.553f,  -70.614f, "8447930", "Woods Hole, MA" },
-    { 41.284f,  -70.099f, "8449130", "Nantucket, MA" },
-    // ── US EAST COAST — RHODE ISLAND / CONNECTICUT / NEW YORK ───────────────
-    { 41.505f,  -71.327f, "8452660", "Newport, RI" },
-    { 41.732f,  -71.340f, "8452944", "Providence, RI" },
-    { 41.580f,  -71.427f, "8454049", "Quonset Point, RI" },
-    { 41.356f,  -72.090f, "8461490", "New London, CT" },
-    { 41.283f,  -72.928f, "8465705", "New Haven, CT" },
-    { 41.174f,  -73.182f, "8467150", "Bridgeport, CT" },
-    { 41.071f,  -71.960f, "8510560", "Montauk, NY" },
-    { 40.890f,  -73.369f, "8516945", "Kings Point, NY" },
-    { 40.700f,  -74.014f, "8518750", "The Battery, NY" },
-    { 40.638f,  -74.065f, "8519483", "Bergen Point, NY" },
-    { 40.623f,  -73.952f, "8517741", "Jamaica Bay, NY" },
-    // ── US EAST COAST — NEW JERSEY ──────────────────────────────────────────
-    { 40.466f,  -74.009f, "8531680", "Sandy Hook, NJ" },
-    { 40.214f,  -74.012f, "8530973", "Raritan Bay, NJ" },
-    { 39.944f,  -74.053f, "8533085", "Barnegat, NJ" },
-    { 39.356f,  -74.418f, "8534720", "Atlantic City, NJ" },
-    { 38.968f,  -74.960f, "8536110", "Cape May, NJ" },
-    // ── US EAST COAST — DELAWARE / MARYLAND ─────────────────────────────────
-    { 39.579f,  -75.588f, "8551762", "Delaware City, DE" },
-    { 38.782f,  -75.119f, "8557380", "Lewes, DE" },
-    { 38.327f,  -75.088f, "8570283", "Ocean City Inlet, MD" },
-    { 38.571f,  -76.068f, "8571892", "Cambridge, MD" },
-    { 38.983f,  -76.483f, "8574680", "Baltimore, MD" },
-    { 38.317f,  -76.451f, "8577330", "Solomons Island, MD" },
-    { 38.417f,  -76.583f, "8578240", "Bishops Head, MD" },
-    { 38.873f,  -77.021f, "8594900", "Washington DC" },
-    // ── US EAST COAST — VIRGINIA ─────────────────────────────────────────────
-    { 37.167f,  -76.444f, "8637689", "Yorktown, VA" },
-    { 36.947f,  -76.330f, "8638610", "Sewells Point, VA" },
-    { 37.015f,  -76.016f, "8632200", "Kiptopeke, VA" },
-    { 36.832f,  -76.298f, "8639348", "Money Point, VA" },
-    // ── US EAST COAST — NORTH CAROLINA ──────────────────────────────────────
-    { 36.183f,  -75.747f, "8651370", "Duck, NC" },
-    { 35.792f,  -75.549f, "8652587", "Oregon Inlet Marina, NC" },
-    { 35.228f,  -75.703f, "8654467", "Hatteras, NC" },
-    { 34.718f,  -76.667f, "8656483", "Beaufort, NC" },
-    { 34.227f,  -77.953f, "8658120", "Wilmington, NC" },
-    { 33.920f,  -78.015f, "8659084", "Southport, NC" },
-    // ── US EAST COAST — SOUTH CAROLINA ──────────────────────────────────────
-    { 33.655f,  -78.918f, "8661070", "Springmaid Pier, SC" },
-    { 33.352f,  -79.186f, "8662245", "Georgetown, SC" },
-    { 32.782f,  -79.926f, "8665530", "Charleston, SC" },
-    { 32.457f,  -80.671f, "8669289", "Hilton Head, SC" },
-    // ── US EAST COAST — GEORGIA ──────────────────────────────────────────────
-    { 32.083f,  -80.900f, "8670870", "Fort Pulaski, GA" },
-    { 31.233f,  -81.400f, "8677344", "Brunswick, GA" },
-    // ── US EAST COAST — FLORIDA (EAST) ──────────────────────────────────────
-    { 30.670f,  -81.466f, "8720030", "Fernandina Beach, FL" },
-    { 30.397f,  -81.428f, "8720218", "Mayport, FL" },
-    { 29.859f,  -81.265f, "8720587", "St. Augustine, FL" },
-    { 29.228f,  -81.023f, "8721604", "Daytona Beach, FL" },
-    { 28.454f,  -80.558f, "8722956", "Port Canaveral, FL" },
-    { 27.660f,  -80.237f, "8722670", "Lake Worth Pier, FL" },
-    { 26.127f,  -80.104f, "8722669", "Lake Worth, FL" },
-    { 25.774f,  -80.130f, "8723170", "Miami Beach, FL" },
-    { 25.521f,  -80.374f, "8723214", "Virginia Key, FL" },
-    { 24.943f,  -80.537f, "8724580", "Key Largo, FL" },
-    { 24.555f,  -81.808f, "8724580", "Key West, FL" },
-    // ── US GULF COAST — FLORIDA (WEST) ──────────────────────────────────────
-    { 26.133f,  -81.795f, "8725110", "Naples, FL" },
-    { 26.448f,  -82.086f, "8725520", "Fort Myers, FL" },
-    { 26.960f,  -82.460f, "8726384", "Port Charlotte, FL" },
-    { 27.767f,  -82.630f, "8726520", "St. Petersburg, FL" },
-    { 27.920f,  -82.437f, "8726607", "Old Port Tampa, FL" },
-    { 28.929f,  -82.878f, "8727235", "Cedar Key, FL" },
-    { 30.072f,  -84.178f, "8727520", "St. Marks, FL" },
-    { 29.730f,  -85.028f, "8728690", "Apalachicola, FL" },
-    { 30.154f,  -85.660f, "8729108", "Panama City, FL" },
-    // ── US GULF COAST — ALABAMA / MISSISSIPPI ────────────────────────────────
-    { 30.404f,  -87.211f, "8729840", "Pensacola, FL" },
-    { 30.250f,  -88.075f, "8735180", "Dauphin Island, AL" },
-    { 30.691f,  -88.043f, "8737048", "Mobile State Docks, AL" },
-    { 30.268f,  -89.090f, "8741533", "Pascagoula, MS" },
-    { 30.396f,  -88.885f, "8744117", "Biloxi, MS" },
-    { 30.325f,  -89.326f, "8747437", "Bay Waveland, MS" },
-    // ── US GULF COAST — LOUISIANA ────────────────────────────────────────────
-    { 30.220f,  -89.930f, "8760551", "South Pass, LA" },
-    { 29.263f,  -89.957f, "8761724", "Grand Isle, LA" },
-    { 29.949f,  -90.070f, "8761927", "New Canal Station, LA" },
-    { 29.780f,  -90.420f, "8764044", "Berwick, LA" },
-    { 29.456f,  -91.327f, "8764227", "Eugene Island, LA" },
-    { 29.767f,  -91.883f, "8764314", "Cypremort Point, LA" },
-    { 29.782f,  -93.326f, "8767816", "Lake Charles, LA" },
-    { 29.768f,  -93.343f, "8768094", "Calcasieu Pass, LA" },
-    // ── US GULF COAST — TEXAS ────────────────────────────────────────────────
-    { 29.690f,  -93.912f, "8770570", "Sabine Pass North, TX" },
-    { 29.361f,  -94.793f, "8771341", "Galveston (Pier 21), TX" },
-    { 29.285f,  -94.789f, "8771450", "Galveston (Pleasure Pier), TX" },
-    { 28.944f,  -95.323f, "8772447", "Freeport, TX" },
-    { 29.681f,  -95.028f, "8773037", "Morgans Point, TX" },
-    { 29.373f,  -94.897f, "8771341", "Texas City, TX" },
-    { 28.022f,  -97.047f, "8774770", "Rockport, TX" },
-    { 27.834f,  -97.054f, "8775870", "Corpus Christi, TX" },
-    { 27.427f,  -97.221f, "8776604", "Baffin Bay, TX" },
-    { 26.063f,  -97.216f, "8779770", "Port Isabel, TX" },
-    // ── US WEST COAST — WASHINGTON ───────────────────────────────────────────
-    { 48.370f, -124.616f, "9443090", "Neah Bay, WA" },
-    { 48.125f, -123.438f, "9444090", "Port Angeles, WA" },
-    { 48.113f, -122.760f, "9444900", "Port Townsend, WA" },
-    { 48.584f, -123.013f, "9449424", "Friday Harbor, WA" },
-    { 47.602f, -122.339f, "9447130", "Seattle, WA" },
-    { 47.269f, -122.415f, "9446484", "Tacoma, WA" },
-    { 47.052f, -122.905f, "9446482", "Olympia, WA" },
-    { 47.909f, -124.637f, "9441102", "Westport, WA" },
-    { 46.656f, -123.822f, "9440910", "Cape Disappointment, WA" },
-    // ── US WEST COAST — OREGON ───────────────────────────────────────────────
-    { 46.208f, -123.768f, "9439040", "Astoria, OR" },
-    { 44.625f, -124.050f, "9435380", "Newport, OR" },
-    { 43.365f, -124.217f, "9432780", "Charleston, OR" },
-    { 42.744f, -124.504f, "9431647", "Port Orford, OR" },
-    // ── US WEST COAST — CALIFORNIA ───────────────────────────────────────────
-    { 41.745f, -124.184f, "9419750", "Crescent City, CA" },
-    { 40.770f, -124.179f, "9418767", "Humboldt Bay, CA" },
-    { 38.955f, -123.745f, "9415020", "Point Arena, CA" },
-    { 38.062f, -122.919f, "9415020", "Point Reyes, CA" },
-    { 37.806f, -122.465f, "9414290", "San Francisco, CA" },
-    { 37.902f, -122.361f, "9414863", "Richmond, CA" },
-    { 37.928f, -122.025f, "9415096", "Martinez, CA" },
-    { 37.772f, -122.225f, "9414750", "Alameda, CA" },
-    { 37.334f, -121.899f, "9413617", "Alviso Slough, CA" },
-    { 36.965f, -122.017f, "9413745", "Santa Cruz, CA" },
-    { 36.605f, -121.898f, "9413450", "Monterey, CA" },
-    { 35.179f, -120.754f, "9412110", "Port San Luis, CA" },
-    { 34.408f, -119.688f, "9411340", "Santa Barbara, CA" },
-    { 34.002f, -119.494f, "9411399", "Port Hueneme, CA" },
-    { 33.961f, -118.423f, "9410660", "Los Angeles, CA" },
-    { 33.720f, -118.272f, "9410230", "Cabrillo Beach, CA" },
-    { 33.456f, -118.489f, "9410079", "Avalon, CA" },
-    { 32.867f, -117.258f, "9410170", "La Jolla, CA" },
-    { 32.714f, -117.174f, "9410170", "San Diego, CA" },
-    // ── ALASKA — SOUTHEAST ───────────────────────────────────────────────────
-    { 55.342f, -131.626f, "9450460", "Ketchikan, AK" },
-    { 56.469f, -132.377f, "9451054", "Wrangell, AK" },
-    { 56.585f, -132.956f, "9451600", "Petersburg, AK" },
-    { 57.050f, -135.340f, "9451600", "Sitka, AK" },
-    { 58.299f, -134.411f, "9452210", "Juneau, AK" },
-    { 59.546f, -139.727f, "9453220", "Yakutat, AK" },
-    // ── ALASKA — SOUTHCENTRAL ────────────────────────────────────────────────
-    { 60.558f, -145.756f, "9454050", "Cordova, AK" },
-    { 61.128f, -146.361f, "9454240", "Valdez, AK" },
-    { 61.238f, -149.891f, "9455090", "Anchorage, AK" },
-    { 59.441f, -151.716f, "9455500", "Seldovia, AK" },
-    { 59.596f, -151.414f, "9455920", "Homer, AK" },
-    { 57.731f, -152.510f, "9457292", "Kodiak, AK" },
-    { 56.902f, -153.946f, "9457804", "Alitak, AK" },
-    // ── ALASKA — SOUTHWEST / ALEUT ───────────────────────────────────────────
-    { 55.339f, -160.497f, "9459450", "Sand Point, AK" },
-    { 54.991f, -163.535f, "9459881", "King Cove, AK" },
-    { 53.880f, -166.536f, "9462450", "Unalaska/Dutch Harbor, AK" },
-    { 52.943f, -168.876f, "9462620", "Nikolski, AK" },
-    { 51.863f, -176.658f, "9461710", "Adak Island, AK" },
-    // ── ALASKA — WEST / ARCTIC ───────────────────────────────────────────────
-    { 64.500f, -165.427f, "9468756", "Nome, AK" },
-    { 63.881f, -160.800f, "9468333", "Unalakleet, AK" },
-    { 66.897f, -162.595f, "9491094", "Red Dog Dock, AK" },
-    { 70.411f, -148.525f, "9497645", "Prudhoe Bay, AK" },
-    // ── HAWAII ───────────────────────────────────────────────────────────────
-    { 19.730f, -155.060f, "1617760", "Hilo, HI" },
-    { 19.730f, -156.064f, "1617433", "Kawaihae, HI" },
-    { 20.895f, -156.477f, "1615680", "Kahului, HI" },
-    { 20.731f, -156.441f, "1615680", "Maalaea, HI" },
-    { 20.890f, -156.683f, "1615093", "Kaunakakai, HI" },
-    { 21.307f, -157.867f, "1612340", "Honolulu, HI" },
-    { 21.395f, -157.799f, "1613198", "Mokuoloe, HI" },
-    { 21.482f, -158.197f, "1612340", "Waianae, HI" },
-    { 21.954f, -159.356f, "1611400", "Nawiliwili, HI" },
-    { 21.890f, -159.602f, "1611400", "Port Allen, HI" },
-    { 28.210f, -177.375f, "1619910", "Midway Islands, HI" },
-    // ── PUERTO RICO ──────────────────────────────────────────────────────────
-    { 18.469f,  -66.117f, "9755371", "San Juan, PR" },
-    { 18.474f,  -66.721f, "9757809", "Arecibo, PR" },
-    { 18.427f,  -67.154f, "9759110", "Aguadilla, PR" },
-    { 18.214f,  -67.159f, "9759938", "Mayaguez, PR" },
-    { 17.970f,  -66.614f, "9759110", "Magueyes Island, PR" },
-    { 17.970f,  -66.400f, "9759394", "La Parguera, PR" },
-    { 18.000f,  -65.889f, "9752695", "Esperanza, PR" },
-    { 18.335f,  -65.634f, "9753216", "Fajardo, PR" },
-    { 17.962f,  -66.151f, "9754228", "Yabucoa Harbor, PR" },
-    // ── US VIRGIN ISLANDS ────────────────────────────────────────────────────
-    { 18.340f,  -64.924f, "9751401", "Charlotte Amalie, USVI" },
-    { 17.746f,  -64.702f, "9751639", "Christiansted, USVI" },
-    { 18.301f,  -64.998f, "9751381", "Lameshur Bay, USVI" },
-    { 18.195f,  -65.012f, "9752235", "Culebra, USVI" },
-    // ── GREAT LAKES ──────────────────────────────────────────────────────────
-    { 46.785f,  -92.093f, "9099041", "Duluth, MN" },
-    { 46.721f,  -92.103f, "9099018", "Superior Entry, WI" },
-    { 46.495f,  -84.349f, "9076024", "Sault Ste. Marie, MI" },
-    { 46.597f,  -90.887f, "9087044", "Ashland, WI" },
-    { 44.545f,  -87.560f, "9087072", "Green Bay, WI" },
-    { 44.460f,  -87.490f, "9087079", "Kewaunee, WI" },
-    { 43.740f,  -87.700f, "9087044", "Sheboygan, WI" },
-    { 43.038f,  -87.880f, "9087023", "Milwaukee, WI" },
-    { 42.350f,  -87.830f, "9087096", "Waukegan, IL" },
-    { 41.770f,  -87.532f, "9086080", "Chicago, IL" },
-    { 42.360f,  -86.220f, "9087057", "Holland, MI" },
-    { 43.232f,  -86.250f, "9087057", "Muskegon, MI" },
-    { 44.783f,  -85.630f, "9087044", "Traverse City, MI" },
-    { 46.473f,  -84.367f, "9076024", "St. Marys River, MI" },
-    { 42.880f,  -82.430f, "9034052", "Port Huron, MI" },
-    { 41.524f,  -82.708f, "9063053", "Marblehead, OH" },
-    { 41.691f,  -83.472f, "9063054", "Toledo, OH" },
-    { 41.502f,  -81.694f, "9063012", "Cleveland, OH" },
-    { 41.766f,  -81.278f, "9063028", "Fairport, OH" },
-    { 42.083f,  -80.090f, "9063007", "Conneaut, OH" },
-    { 42.130f,  -79.974f, "9063020", "Erie, PA" },
-    { 42.878f,  -78.882f, "9063020", "Buffalo, NY" },
-    // ── PACIFIC TERRITORIES ───────────────────────────────────────────────────
-    { 13.444f,  144.655f, "1631428", "Apra Harbor, Guam" },
-    { 14.276f,  145.023f, "1632200", "Saipan, Northern Mariana Islands" },
-    { -14.281f,-170.690f, "1770000", "Pago Pago, American Samoa" },
-    { 19.283f,  166.618f, "1630000", "Wake Island" },
-    { 16.745f,  169.523f, "1622670", "Johnston Atoll" },
-    // ── ADDITIONAL US EAST COAST FILLS ───────────────────────────────────────
-    { 44.106f,  -68.990f, "8414250", "Penobscot Bay, ME" },
-    { 43.072f,  -70.712f, "8419317", "Portsmouth, NH" },
-    { 42.534f,  -71.164f, "8442150", "Salem, MA" },
-    { 42.090f,  -70.660f, "8446166", "Duxbury, MA" },
-    { 41.668f,  -71.162f, "8447435", "Taunton River, MA" },
-    { 39.087f,  -74.802f, "8535951", "Ocean City, NJ" },
-    { 38.687f,  -75.361f, "8556762", "Rehoboth Beach, DE" },
-    { 38.221f,  -76.070f, "8571773", "Oxford, MD" },
-    { 37.528f,  -76.295f, "8632200", "Windmill Point, VA" },
-    { 37.290f,  -76.502f, "8632837", "Yorktown, VA" },
-    { 36.620f,  -76.018f, "8639348", "Chesapeake, VA" },
-    { 35.918f,  -76.478f, "8651370", "Stumpy Point, NC" },
-    { 35.105f,  -76.843f, "8655875", "Cherry Branch, NC" },
-    { 34.905f,  -76.680f, "8656483", "Morehead City, NC" },
-    // ── ADDITIONAL GULF COAST FILLS ──────────────────────────────────────────
-    { 30.162f,  -85.802f, "8729108", "Panama City Beach, FL" },
-    { 30.348f,  -87.541f, "8729210", "Navarre Beach, FL" },
-    { 30.404f,  -87.650f, "8729840", "Perdido Pass, AL" },
-    { 29.722f,  -94.983f, "8770822", "Texas Point, TX" },
-    { 29.450f,  -95.022f, "8772447", "Texas City, TX" },
-    { 29.100f,  -95.580f, "8773259", "Matagorda Ship Channel, TX" },
-    { 28.444f,  -96.397f, "8773767", "Port O'Connor, TX" },
-    { 27.818f,  -97.398f, "8775870", "Ingleside, TX" },
-    // ── ADDITIONAL WEST COAST FILLS ──────────────────────────────────────────
-    { 48.940f, -122.750f, "9449880", "Bellingham, WA" },
-    { 47.520f, -122.620f, "9446484", "Bremerton, WA" },
-    { 46.970f, -124.105f, "9440910", "Grays Harbor, WA" },
-    { 45.555f, -122.673f, "9440910", "Columbia River, WA" },
-    { 45.555f, -122.673f, "9440422", "Vancouver, WA" },
-    { 44.050f, -124.112f, "9434939", "Florence, OR" },
-    { 43.371f, -124.210f, "9432780", "Coos Bay, OR" },
-    { 42.345f, -124.368f, "9431647", "Gold Beach, OR" },
-    { 40.166f, -124.181f, "9418767", "Eureka, CA" },
-    { 39.445f, -123.807f, "9416841", "Fort Bragg, CA" },
-    { 38.330f, -123.046f, "9415020", "Bodega Bay, CA" },
-    { 37.491f, -122.216f, "9414523", "Redwood City, CA" },
-    { 37.596f, -122.032f, "9414750", "Newark Slough, CA" },
-    { 37.930f, -122.416f, "9414795", "Crockett, CA" },
-    { 38.065f, -122.122f, "9415095", "Benicia, CA" },
-    { 38.120f, -122.935f, "9415020", "Tomales Bay, CA" },
-    { 35.673f, -121.119f, "9412340", "Cayucos, CA" },
-    { 34.914f, -120.440f, "9411541", "Vandenberg, CA" },
-    { 34.460f, -120.017f, "9411081", "Gaviota, CA" },
-    { 34.007f, -118.498f, "9410580", "Santa Monica, CA" },
-    { 33.463f, -117.714f, "9410195", "Dana Point, CA" },
-    { 33.629f, -117.928f, "9410195", "Newport Beach, CA" },
-    { 33.159f, -117.389f, "9410170", "Oceanside, CA" },
-    // ── ADDITIONAL ALASKA FILLS ──────────────────────────────────────────────
-    { 58.388f, -135.724f, "9452400", "Skagway, AK" },
-    { 58.357f, -134.575f, "9452210", "Auke Bay, AK" },
-    { 58.960f, -135.340f, "9453220", "Gustavus, AK" },
-    { 60.120f, -149.441f, "9455090", "Seward, AK" },
-    { 60.765f, -146.353f, "9454240", "Whittier, AK" },
-    { 61.577f, -148.990f, "9455090", "Wasilla, AK" },
-    { 59.050f, -158.490f, "9459450", "Dillingham, AK" },
-    { 58.300f, -162.018f, "9459881", "Naknek, AK" },
-    { 57.537f, -157.485f, "9457804", "Egegik, AK" },
-    { 54.133f, -165.780f, "9462450", "Akutan, AK" },
-    { 63.748f, -171.489f, "9468756", "St. Lawrence Island, AK" },
-    { 64.731f, -163.421f, "9468333", "Elim, AK" },
-    { 67.884f, -164.789f, "9491094", "Kotzebue, AK" },
-    { 71.293f, -156.789f, "9497645", "Barrow/Utqiagvik, AK" },
-    // ── ADDITIONAL HAWAII FILLS ──────────────────────────────────────────────
-    { 21.185f, -157.083f, "1612340", "Kaneohe Bay, HI" },
-    { 20.026f, -155.834f, "1617760", "Kailua-Kona, HI" },
-    { 18.912f, -155.651f, "1617760", "Punaluu, HI" },
-    { 20.783f, -157.038f, "1615680", "Lanai City, HI" },
-    { 21.100f, -157.025f, "1612340", "Laie, HI" },
-    // ── ADDITIONAL PUERTO RICO FILLS ─────────────────────────────────────────
-    { 18.370f,  -65.327f, "9753216", "Vieques, PR" },
-    { 18.461f,  -66.439f, "9757809", "Manati, PR" },
-    { 18.090f,  -65.460f, "9754228", "Humacao, PR" },
-    { 18.003f,  -66.614f, "9759110", "Ponce, PR" },
-    // ── ADDITIONAL GREAT LAKES FILLS ─────────────────────────────────────────
-    { 43.952f,  -76.495f, "9063020", "Sackets Harbor, NY" },
-    { 43.456f,  -76.524f, "9063020", "Oswego, NY" },
-    { 43.165f,  -77.620f, "9063020", "Rochester, NY" },
-    { 42.250f,  -83.150f, "9034052", "Detroit, MI" },
-    { 42.108f,  -86.458f, "9087057", "South Haven, MI" },
-    { 43.789f,  -82.479f, "9034052", "Port Sanilac, MI" },
-    { 44.350f,  -83.903f, "9034052", "Oscoda, MI" },
-    { 45.068f,  -83.431f, "9034052", "Cheboygan, MI" },
-    { 45.777f,  -84.720f, "9076024", "Mackinaw City, MI" },
-    { 46.357f,  -87.994f, "9099018", "Marquette, MI" },
-    { 47.122f,  -88.568f, "9099041", "Houghton, MI" },
-    { 42.728f,  -87.795f, "9086080", "Kenosha, WI" },
-    { 43.800f,  -88.000f, "9087079", "Manitowoc, WI" },
-    { 44.088f,  -87.660f, "9087072", "Two Rivers, WI" },
-    // ── ADDITIONAL PACIFIC TERRITORIES ───────────────────────────────────────
-    { 13.474f,  144.718f, "1631428", "Agana, Guam" },
-    { 15.215f,  145.761f, "1632200", "Rota, Northern Mariana Islands" },
-    { -14.174f,-170.772f, "1770000", "Leone, American Samoa" },
-    { -14.307f,-170.763f, "1770000", "Aunu'u, American Samoa" },
-  };
-
-  const int stationCount = sizeof(stations) / sizeof(stations[0]);
-
-  // Haversine distance in km
-  auto haversineKm = [](float lat1, float lon1, float lat2, float lon2) -> float {
-    const float R = 6371.0f;
-    float dLat = (lat2 - lat1) * 0.01745329f;
-    float dLon = (lon2 - lon1) * 0.01745329f;
-    float a = sinf(dLat / 2) * sinf(dLat / 2) +
-              cosf(lat1 * 0.01745329f) * cosf(lat2 * 0.01745329f) *
-              sinf(dLon / 2) * sinf(dLon / 2);
-    return R * 2.0f * atan2f(sqrtf(a), sqrtf(1.0f - a));
-  };
+// Find the nearest NOAA tide station to given coordinates and remember up to 3
+// distinct stations as blend candidates. Locations outside NOAA coverage (e.g.
+// Portugal, El Salvador, Central America) return "" because no station is within
+// MAX_STATION_DISTANCE_KM.
+String findNearestTideStation(float latitude, float longitude) {
+  NetworkLock lock;
+  LOG_INFO("Finding NOAA station for coordinates: lat=%.6f, lon=%.6f", latitude, longitude);
 
-  // Find up to 3 nearest stations with unique IDs for blending.
-  // Three sequential passes: each pass picks the nearest unselected unique ID.
   // Secondary stations must be within BLEND_MAX_DIST_RATIO × the nearest station's distance.
   const int   MAX_BLEND_STATIONS   = 3;
   const float BLEND_MAX_DIST_RATIO = 3.0f;
 
-  cachedCandidateCount = 0;
-  for (int pass = 0; pass < MAX_BLEND_STATIONS; pass++) {
-    const char *bestId   = nullptr;
-    float       bestDist = 1e9f;
-
-    for (int i = 0; i < stationCount; i++) {
-      float d = haversineKm(latitude, longitude, stations[i].lat, stations[i].lon);
-      if (d > MAX_STATION_DISTANCE_KM) continue;
-
-      // Skip station IDs already selected in a previous pass
-      bool already = false;
-      for (int j = 0; j < cachedCandidateCount; j++) {
-        if (strcmp(cachedCandidates[j].id, stations[i].id) == 0) { already = true; break; }
-      }
-      if (already) continue;
-
-      if (d < bestDist) { bestDist = d; bestId = stations[i].id; }
-    }
-
-    if (!bestId) break;
-
-    // Secondary candidates must be within BLEND_MAX_DIST_RATIO × nearest distance
-    if (pass > 0 && bestDist > cachedCandidates[0].distKm * BLEND_MAX_DIST_RATIO) break;
+  // Catalogued spots carry their stations precomputed under the same rules
+  TideStationMatch matches[MAX_BLEND_STATIONS];
+  int found = surfSpotTideStations(latitude, longitude, matches, MAX_BLEND_STATIONS);
+  if (found < 0) {
+    found = findNearestTideStations(latitude, longitude, MAX_STATION_DISTANCE_KM, matches, MAX_BLEND_STATIONS);
+  }
 
-    strncpy(cachedCandidates[cachedCandidateCount].id, bestId, 9);
+  cachedCandidateCount = 0;
+  for (int i = 0; i < found; i++) {
+    if (i > 0 && matches[i].distKm > matches[0].distKm * BLEND_MAX_DIST_RATIO) break;
+    strncpy(cachedCandidates[cachedCandidateCount].id, matches[i].id, 9);
     cachedCandidates[cachedCandidateCount].id[9]  = '\0';
-    cachedCandidates[cachedCandidateCount].distKm = bestDist;
+    cachedCandidates[cachedCandidateCount].distKm = matches[i].distKm;
     cachedCandidateCount++;
   }
 
   if (cachedCandidateCount == 0) {
-    logError("No NOAA station within " + String(MAX_STATION_DISTANCE_KM, 0) +
-             " km. Tide data unavailable for this region.");
+    LOG_ERROR("No NOAA station within %.0f km. Tide data unavailable for this region.", MAX_STATION_DISTANCE_KM);
     return "";
   }
 
-  logInfo("Nearest NOAA station: " + String(cachedCandidates[0].id) +
-          " — " + String(cachedCandidates[0].distKm, 1) + " km away" +
-          (cachedCandidateCount > 1
-            ? " (+" + String(cachedCandidateCount - 1) + " blend candidate(s))"
-            : ""));
+  LOG_INFO("Nearest NOAA station: %s (%s) — %.1f km away (%d blend candidate(s))", cachedCandidates[0].id,
+           matches[0].name, cachedCandidates[0].distKm, cachedCandidateCount - 1);
   return String(cachedCandidates[0].id);
 }
 
-// Fetch current tide height from NOAA station
-float fetchNOAATideHeight(const String &stationId, float &minTide, float &maxTide) {
-  if (WiFi.status() != WL_CONNECTED || stationId.isEmpty()) {
-    logError("fetchNOAATideHeight: WiFi not connected or stationId empty");
-    minTide = 0.0f;
-    maxTide = 0.0f;
+// ── NOAA tide prediction series ─────────────────────────────────────────────
+// NOAA's high/low predictions (interval=hilo, about four small entries a day)
+// are downloaded a week at a time and kept in TIDE_SERIES_FILE. Every refresh
+// until the window runs out rebuilds the curve locally by cosine interpolation
+// between consecutive extremes, NOAA's own method for subordinate stations.
+static TideSeries tideSeriesCache[3];   // RAM mirror of the blend stations' series
+static int tideSeriesNextSlot = 0;
+
+// Days since 1970-01-01 for a proleptic Gregorian date (H. Hinnant's algorithm).
+static long daysFromCivil(int y, int m, int d) {
+  y -= m <= 2;
+  long era = (y >= 0 ? y : y - 399) / 400;
+  long yoe = y - era * 400;
+  long doy = (153L * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+  long doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+  return era * 146097L + doe - 719468L;
+}
+
+static uint32_t utcDateKey(time_t t) {
+  struct tm utc;
+  gmtime_r(&t, &utc);
+  return (uint32_t)(utc.tm_year + 1900) * 10000 + (utc.tm_mon + 1) * 100 + utc.tm_mday;
+}
+
+static time_t tideEventTime(const TideSeries &series, int i) {
+  return (time_t)series.start + series.minute[i] * 60L;
+}
+
+// True if the extremes bracket the whole UTC day starting at dayStart.
+static bool tideSeriesCovers(const TideSeries &series, time_t dayStart) {
+  return series.valid && series.count >= 2 && tideEventTime(series, 0) <= dayStart &&
+         tideEventTime(series, series.count - 1) >= dayStart + 86400;
+}
+
+// Download the highs and lows from the UTC day before dayStart through
+// TIDE_SERIES_DAYS, so the extreme before midnight is always included.
+static bool downloadTideSeries(const String &stationId, time_t dayStart, TideSeries &series) {
+  if (WiFi.status() != WL_CONNECTED) {
+    LOG_ERROR("Tide series for %s not cached and WiFi is down", stationId);
+    return false;
+  }
+  time_t windowStart = dayStart - 86400;
+  LOG_INFO("Fetching NOAA tides for station %s from %u", stationId, utcDateKey(windowStart));
+
+  HTTPClient http;
+  // GMT so event times line up with the device's UTC clock
+  String url = "https://api.tidesandcurrents.noaa.gov/api/prod/datagetter?product=predictions&station=" + stationId +
+               "&datum=MLLW&time_zone=gmt&units=metric&interval=hilo&begin_date=" + String(utcDateKey(windowStart)) +
+               "&range=" + String(TIDE_SERIES_DAYS * 24) + "&format=json";
+  LOG_DEBUG("[TIDE] Series URL: %s", url.c_str());
+  String endpoint = "tides:" + stationId;
+  if (!endpointAvailable(url, endpoint)) return false;
+  beginHttpGet(http, url, 10000, "tide-hilo");
+  int code = timedGet(http);
+  recordEndpointResult(url, code, endpoint);
+  if (code != HTTP_CODE_OK) {
+    LOG_ERROR("Failed to fetch NOAA tide data: HTTP %d for URL: %s", code, url);
+    endHttpDiscard(http);
+    return false;
+  }
+
+  StaticJsonDocument<128> filter;
+  filter["predictions"][0]["t"] = true;
+  filter["predictions"][0]["v"] = true;
+  filter["error"]["message"] = true;
+  DynamicJsonDocument doc(4 * 1024);
+  DeserializationError error = parseJsonStream(http, doc, filter);
+  http.end();
+  if (error) {
+    LOG_ERROR("Failed to parse NOAA tide JSON: %s", error.c_str());
+    return false;
+  }
+
+  JsonArray predictions = doc["predictions"];
+  if (predictions.isNull() || predictions.size() == 0) {
+    if (doc.containsKey("error")) {
+      LOG_ERROR("NOAA API error: %s", (const char *)doc["error"]["message"]);
+    } else {
+      LOG_ERROR("No tide predictions in NOAA response");
+    }
+    return false;
+  }
+
+  series = TideSeries();
+  strncpy(series.stationId, stationId.c_str(), sizeof(series.stationId) - 1);
+  series.start = (uint32_t)windowStart;
+  for (JsonVariant pred : predictions) {
+    if (series.count >= TIDE_SERIES_EVENTS) break;
+    int y, mo, d, h, mi;
+    if (sscanf(pred["t"] | "", "%4d-%2d-%2d %2d:%2d", &y, &mo, &d, &h, &mi) != 5) continue;
+    long minute = (daysFromCivil(y, mo, d) * 86400L + h * 3600L + mi * 60L - windowStart) / 60;
+    if (minute < 0 || minute > 65535 || (series.count > 0 && minute <= series.minute[series.count - 1])) continue;
+    series.minute[series.count] = (uint16_t)minute;
+    series.heightMm[series.count] = (int16_t)lroundf(atof(pred["v"] | "0") * 1000.0f);
+    series.count++;
+  }
+  series.valid = series.count >= 2;
+  LOG_INFO("NOAA returned %u highs and lows for %s", predictions.size(), stationId);
+  return series.valid;
+}
+
+// A series covering the UTC day from dayStart: RAM first, then flash, then the
+// network.
+static const TideSeries *tideSeriesFor(const String &stationId, time_t dayStart) {
+  const int slots = sizeof(tideSeriesCache) / sizeof(tideSeriesCache[0]);
+  int slot = -1;
+  for (int i = 0; i < slots; i++) {
+    if (stationId == tideSeriesCache[i].stationId) {
+      if (tideSeriesCovers(tideSeriesCache[i], dayStart)) return &tideSeriesCache[i];
+      slot = i;
+      break;
+    }
+  }
+  if (slot < 0) {
+    slot = tideSeriesNextSlot;
+    tideSeriesNextSlot = (tideSeriesNextSlot + 1) % slots;
+  }
+
+  TideSeries &entry = tideSeriesCache[slot];
+  if (loadTideSeries(stationId.c_str(), entry) && tideSeriesCovers(entry, dayStart)) {
+    LOG_DEBUG("[TIDE] Series for %s loaded from flash (from %u)", entry.stationId,
+              (unsigned)utcDateKey((time_t)entry.start));
+    return &entry;
+  }
+  if (!downloadTideSeries(stationId, dayStart, entry) || !tideSeriesCovers(entry, dayStart)) {
+    entry = TideSeries();
+    return nullptr;
+  }
+  saveTideSeries(entry);
+  return &entry;
+}
+
+// Height (m) and rate of change (m/h) at a UTC time, on the half-cosine
+// between the extremes either side of it.
+static void sampleTideSeries(const TideSeries &series, time_t t, float &heightM, float &rateMPerHour) {
+  int i = 0;
+  while (i < series.count - 2 && tideEventTime(series, i + 1) <= t) i++;
+  float span = (float)(tideEventTime(series, i + 1) - tideEventTime(series, i));
+  float frac = (t - tideEventTime(series, i)) / span;
+  if (frac < 0.0f) frac = 0.0f;
+  if (frac > 1.0f) frac = 1.0f;
+  float h0 = series.heightMm[i] / 1000.0f;
+  float h1 = series.heightMm[i + 1] / 1000.0f;
+  heightM = (h0 + h1) / 2.0f + (h0 - h1) / 2.0f * cosf(M_PI * frac);
+  rateMPerHour = (h1 - h0) / 2.0f * sinf(M_PI * frac) * M_PI / span * 3600.0f;
+}
+
+// Lowest and highest water during the UTC day from dayStart: the extremes in
+// it, plus the curve at either midnight for days that end mid-swing.
+static void tideSeriesBounds(const TideSeries &series, time_t dayStart, float &minM, float &maxM) {
+  float rate;
+  float endHeight;
+  sampleTideSeries(series, dayStart, minM, rate);
+  sampleTideSeries(series, dayStart + 86400, endHeight, rate);
+  maxM = minM;
+  if (endHeight < minM) minM = endHeight;
+  if (endHeight > maxM) maxM = endHeight;
+  for (int i = 0; i < series.count; i++) {
+    time_t t = tideEventTime(series, i);
+    if (t < dayStart || t > dayStart + 86400) continue;
+    float h = series.heightMm[i] / 1000.0f;
+    if (h < minM) minM = h;
+    if (h > maxM) maxM = h;
+  }
+}
+
+// Current tide height (m) at a station from its cached series. Also returns the
+// day's min/max and, if tideRate is given, the rate of change in m/h.
+float fetchNOAATideHeight(const String &stationId, float &minTide, float &maxTide, float *tideRate) {
+  NetworkLock lock;
+  minTide = 0.0f;
+  maxTide = 0.0f;
+  if (tideRate) *tideRate = 0.0f;
+  if (stationId.isEmpty()) {
+    LOG_ERROR("fetchNOAATideHeight: stationId empty");
     return 0.0f;
   }
-  
+
   time_t now = time(nullptr);
   if (now < 1000000000) {
-    logError("fetchNOAATideHeight: NTP not synced, skipping tide fetch (time=" + String(now) + ")");
-    minTide = 0.0f;
-    maxTide = 0.0f;
+    LOG_ERROR("fetchNOAATideHeight: NTP not synced, skipping tide fetch (time=%d)", now);
     return 0.0f;
   }
-  
-  // Get current date in YYYYMMDD format
-  struct tm timebuf;  // own copy — avoids pointer invalidation if anything calls localtime/gmtime
-  {
-    struct tm *tmp = localtime(&now);
-    if (tmp) timebuf = *tmp;
-    else { minTide = 0.0f; maxTide = 0.0f; return 0.0f; }
-  }
-  struct tm *timeinfo = &timebuf;
-  char dateStr[16];
-  strftime(dateStr, sizeof(dateStr), "%Y%m%d", timeinfo);
-  String currentDate = String(dateStr);
-  String cacheKey = currentDate + "_gmt"; // suffix ensures old lst_ldt cache is ignored
-  
-  // Check if we have cached tide bounds for today
-  String cachedDate = "";
-  bool hasCachedBounds = loadTideBounds(minTide, maxTide, cachedDate);
-
-  // Invalidate if stale date, wrong tz key, or both zero
-  if (hasCachedBounds && (cachedDate != cacheKey || (minTide == 0.0f && maxTide == 0.0f))) {
-    logInfo("Cached tide bounds invalid or stale (" + cachedDate + " vs " + cacheKey + "), refetching");
-    hasCachedBounds = false;
-  }
-  
-  // If we don't have today's valid bounds cached, fetch from API
-  if (!hasCachedBounds) {
-    logInfo("Fetching NOAA tides for station " + stationId + " for today: " + currentDate);
-    
-    HTTPClient http;
-    // Fetch only today's predictions in GMT so hours match the device's UTC clock
-    String url = "https://api.tidesandcurrents.noaa.gov/api/prod/datagetter?product=predictions&station=" + stationId + 
-                 "&datum=MLLW&time_zone=gmt&units=english&interval=h&begin_date=" + currentDate + 
-                 "&end_date=" + currentDate + "&format=json";
-    Serial.printf("[TIDE] Non-cached URL: %s\n", url.c_str());
-
-    http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-    http.begin(url);
-    http.setTimeout(10000);
-    int code = http.GET();
-    if (code != HTTP_CODE_OK) {
-      logError("Failed to fetch NOAA tide data: HTTP " + String(code) + " for URL: " + url);
-      http.end();
-      minTide = 0.0f;
-      maxTide = 0.0f;
-      return 0.0f;
-    }
-    
-    String payload = http.getString();
-    http.end();
-    
-    logInfo("NOAA API response (first 200 chars): " + payload.substring(0, min(200, (int)payload.length())));
-    
-    DynamicJsonDocument doc(8 * 1024);
-    DeserializationError error = deserializeJson(doc, payload);
-    if (error) {
-      logError("Failed to parse NOAA tide JSON: " + String(error.c_str()));
-      minTide = 0.0f;
-      maxTide = 0.0f;
-      return 0.0f;
-    }
-    
-    JsonArray predictions = doc["predictions"];
-    if (predictions.isNull() || predictions.size() == 0) {
-      // Check if there's an error message in the response
-      if (doc.containsKey("error")) {
-        logError("NOAA API error: " + String((const char*)doc["error"]["message"]));
-      } else {
-        logError("No tide predictions in NOAA response (array size: " + String(predictions.size()) + ")");
-      }
-      minTide = 0.0f;
-      maxTide = 0.0f;
-      return 0.0f;
-    }
-    
-    logInfo("NOAA returned " + String(predictions.size()) + " tide predictions for today");
-    Serial.printf("[TIDE] predictions count=%d, current hour=%d\n", predictions.size(), timeinfo->tm_hour);
-    
-    // Find the prediction for the current hour (predictions[0] is always midnight)
-    int currentHourNow = timeinfo->tm_hour;
-    String currentTideStr = predictions[0]["v"] | "0.0"; // fallback to midnight
-    for (JsonVariant pred : predictions) {
-      String timeStr = pred["t"] | "";
-      int predHour = timeStr.length() >= 13 ? timeStr.substring(11, 13).toInt() : -1;
-      if (predHour == currentHourNow) {
-        currentTideStr = pred["v"] | "0.0";
-        Serial.printf("[TIDE] Matched hour %d: t=%s v=%s\n", currentHourNow, timeStr.c_str(), currentTideStr.c_str());
-        break;
-      }
-    }
-    float currentTideHeight = currentTideStr.toFloat();
-    Serial.printf("[TIDE] currentTideHeight=%.2f ft\n", currentTideHeight);
-    
-    // Find min and max from all predictions for today
-    float minTideFeet = currentTideHeight;
-    float maxTideFeet = currentTideHeight;
-    
-    for (JsonVariant pred : predictions) {
-      String heightStr = pred["v"] | "0.0";
-      float height = heightStr.toFloat();
-      if (height < minTideFeet) minTideFeet = height;
-      if (height > maxTideFeet) maxTideFeet = height;
-    }
-    
-    // Convert from feet to meters for consistency with rest of app
-    float currentTideMeters = currentTideHeight * 0.3048f;
-    minTide = minTideFeet * 0.3048f;
-    maxTide = maxTideFeet * 0.3048f;
-    
-    // Save today's bounds to file for reuse (with _gmt suffix to distinguish from old lst_ldt cache)
-    saveTideBounds(minTide, maxTide, cacheKey);
-    
-    logInfo("NOAA tide - Current: " + String(currentTideHeight, 2) + " ft (" + String(currentTideMeters, 2) + " m), " +
-            "Daily Range: " + String(minTideFeet, 2) + " to " + String(maxTideFeet, 2) + " ft (" + 
-            String(minTide, 2) + " to " + String(maxTide, 2) + " m)");
-    Serial.printf("[TIDE] RETURNING currentM=%.3f, minM=%.3f, maxM=%.3f\n", currentTideMeters, minTide, maxTide);
-    
-    return currentTideMeters;
-  } else {
-    // We have today's bounds cached, just fetch current tide height
-    logInfo("Using cached tide bounds for " + cacheKey + ": " + String(minTide, 2) + "m to " + String(maxTide, 2) + "m");
-    Serial.printf("[TIDE] Cached branch: minM=%.3f maxM=%.3f cacheKey=%s\n", minTide, maxTide, cacheKey.c_str());
-    
-    HTTPClient http;
-    // Fetch full day predictions in GMT so hours match the device's UTC clock
-    String url = "https://api.tidesandcurrents.noaa.gov/api/prod/datagetter?product=predictions&station=" + stationId + 
-                 "&datum=MLLW&time_zone=gmt&units=english&interval=h&begin_date=" + currentDate + 
-                 "&end_date=" + currentDate + "&format=json";
-    Serial.printf("[TIDE] Cached URL: %s\n", url.c_str());
+  time_t dayStart = now - now % 86400;
 
-    http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-    http.begin(url);
-    http.setTimeout(10000);
-    int code = http.GET();
-    if (code != HTTP_CODE_OK) {
-      logError("Failed to fetch current NOAA tide: HTTP " + String(code));
-      http.end();
-      // Preserve cached minTide/maxTide — they were loaded above and are still valid
-      return 0.0f;
-    }
-    
-    String payload = http.getString();
-    http.end();
-    
-    DynamicJsonDocument doc(8 * 1024);
-    DeserializationError error = deserializeJson(doc, payload);
-    if (error) {
-      logError("Failed to parse NOAA tide JSON: " + String(error.c_str()));
-      return 0.0f;
-    }
-    
-    JsonArray predictions = doc["predictions"];
-    if (predictions.isNull() || predictions.size() == 0) {
-      logError("No current tide prediction in NOAA response");
-      return 0.0f;
-    }
-    
-    // Find the prediction for the current hour (predictions[0] is always midnight)
-    int currentHourNow = timeinfo->tm_hour;
-    String currentTideStr = predictions[0]["v"] | "0.0"; // fallback to first
-    Serial.printf("[TIDE] Cached branch: predictions=%d, currentHour=%d\n", predictions.size(), currentHourNow);
-    for (JsonVariant pred : predictions) {
-      String timeStr = pred["t"] | "";
-      int predHour = timeStr.length() >= 13 ? timeStr.substring(11, 13).toInt() : -1;
-      if (predHour == currentHourNow) {
-        currentTideStr = pred["v"] | "0.0";
-        Serial.printf("[TIDE] Cached matched hour %d: t=%s v=%s\n", currentHourNow, timeStr.c_str(), currentTideStr.c_str());
-        break;
-      }
-    }
-    float currentTideHeight = currentTideStr.toFloat();
-    float currentTideMeters = currentTideHeight * 0.3048f;
-    
-    logInfo("Current tide: " + String(currentTideHeight, 2) + " ft (" + String(currentTideMeters, 2) + " m)");
-    Serial.printf("[TIDE] Cached RETURNING currentM=%.3f\n", currentTideMeters);
-    
-    return currentTideMeters;
+  StageTimer timer("tide", STAGE_TOTAL);
+  const TideSeries *series = tideSeriesFor(stationId, dayStart);
+  if (!series) {
+    timer.finish(-1);
+    return 0.0f;
   }
+
+  float height = 0.0f, rate = 0.0f;
+  sampleTideSeries(*series, now, height, rate);
+  tideSeriesBounds(*series, dayStart, minTide, maxTide);
+  if (tideRate) *tideRate = rate;
+
+  LOG_INFO("NOAA tide %s - Current: %.2f m (%.3f m/h), Daily Range: %.2f to %.2f m", stationId, height, rate, minTide, maxTide);
+  return height;
 }
 
-// Lightweight tide height fetch for secondary blend stations.
-// Assumes NTP is already synced (the primary station call ensures this).
-// Does NOT touch the min/max bounds cache — only returns the current-hour prediction.
-// Returns current height in metres, or -9999.0f on any failure.
-static float fetchTideHeightOnly(const String &stationId, const struct tm *ti) {
-  if (WiFi.status() != WL_CONNECTED || stationId.isEmpty()) return -9999.0f;
+// ── Harmonic constants ──────────────────────────────────────────────────────
+// The predictor needs each station's constituents and MSL datum once; after that
+// tides are computed on-device with no network. Stations NOAA publishes no
+// harmonics for (subordinate stations) are remembered with an empty record.
+static TideHarmonics tideHarmonicsCache[MAX_OVERVIEW_SPOTS];   // blend stations, or every overview spot's
+static int tideHarmonicsNextSlot = 0;
+
+static bool downloadTideHarmonics(const String &stationId, TideHarmonics &harmonics) {
+  if (WiFi.status() != WL_CONNECTED) return false;
+  LOG_INFO("Provisioning tide harmonics for station %s", stationId);
+  const String base = "https://api.tidesandcurrents.noaa.gov/mdapi/prod/webapi/stations/" + stationId;
 
-  char dateStr[16];
-  strftime(dateStr, sizeof(dateStr), "%Y%m%d", ti);
+  const String endpoint = "mdapi:" + stationId;
+  if (!endpointAvailable(base, endpoint)) return false;
 
+  // MSL above MLLW, to put predictions on the same datum as the NOAA series
   HTTPClient http;
-  String url = "https://api.tidesandcurrents.noaa.gov/api/prod/datagetter?product=predictions&station=" + stationId +
-               "&datum=MLLW&time_zone=gmt&units=english&interval=h&begin_date=" + String(dateStr) +
-               "&end_date=" + String(dateStr) + "&format=json";
-  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-  http.begin(url);
-  http.setTimeout(10000);
-  int code = http.GET();
-  if (code != HTTP_CODE_OK) { http.end(); return -9999.0f; }
+  beginHttpGet(http, base + "/datums.json?units=metric", 10000, "tide-datums");
+  int code = timedGet(http);
+  recordEndpointResult(base, code, endpoint);
+  if (code != HTTP_CODE_OK) {
+    LOG_ERROR("NOAA datums request failed: HTTP %d", code);
+    endHttpDiscard(http);
+    return false;
+  }
+  StaticJsonDocument<96> datumFilter;
+  datumFilter["datums"][0]["name"] = true;
+  datumFilter["datums"][0]["value"] = true;
+  DynamicJsonDocument datumDoc(2 * 1024);
+  DeserializationError error = parseJsonStream(http, datumDoc, datumFilter);
+  http.end();
+  if (error) {
+    LOG_ERROR("Failed to parse NOAA datums JSON: %s", error.c_str());
+    return false;
+  }
+  float msl = 0.0f, mllw = 0.0f;
+  bool haveMsl = false, haveMllw = false;
+  for (JsonVariant d : datumDoc["datums"].as<JsonArray>()) {
+    const char *name = d["name"] | "";
+    if (strcmp(name, "MSL") == 0) { msl = d["value"] | 0.0f; haveMsl = true; }
+    else if (strcmp(name, "MLLW") == 0) { mllw = d["value"] | 0.0f; haveMllw = true; }
+  }
+  datumDoc.clear();
 
-  String payload = http.getString();
+  beginHttpGet(http, base + "/harcon.json?units=metric", 10000, "tide-harmonic");
+  code = timedGet(http);
+  recordEndpointResult(base, code, endpoint);
+  if (code != HTTP_CODE_OK) {
+    LOG_ERROR("NOAA harcon request failed: HTTP %d", code);
+    endHttpDiscard(http);
+    return false;
+  }
+  StaticJsonDocument<128> harconFilter;
+  harconFilter["HarmonicConstituents"][0]["name"] = true;
+  harconFilter["HarmonicConstituents"][0]["amplitude"] = true;
+  harconFilter["HarmonicConstituents"][0]["phase_GMT"] = true;
+  DynamicJsonDocument harconDoc(4 * 1024);
+  error = parseJsonStream(http, harconDoc, harconFilter);
   http.end();
+  if (error) {
+    LOG_ERROR("Failed to parse NOAA harcon JSON: %s", error.c_str());
+    return false;
+  }
 
-  DynamicJsonDocument doc(8 * 1024);
-  if (deserializeJson(doc, payload)) return -9999.0f;
+  harmonics = TideHarmonics();
+  strncpy(harmonics.stationId, stationId.c_str(), sizeof(harmonics.stationId) - 1);
+  harmonics.valid = true;
+  if (!haveMsl || !haveMllw) {
+    LOG_INFO("Station %s has no MSL/MLLW datums, using NOAA series", stationId);
+    return true;
+  }
+  harmonics.mslMm = (int16_t)lroundf((msl - mllw) * 1000.0f);
+
+  // Keep the largest constituents that fit the record (NOAA lists up to 37)
+  for (JsonVariant c : harconDoc["HarmonicConstituents"].as<JsonArray>()) {
+    int index = tideConstituentIndex(c["name"] | "");
+    float amplitude = c["amplitude"] | 0.0f;
+    float phase = c["phase_GMT"] | 0.0f;
+    if (index < 0 || amplitude <= 0.0f) continue;
+    TideConstituent entry;
+    entry.index = (uint8_t)index;
+    entry.amplitudeMm = (uint16_t)min(lroundf(amplitude * 1000.0f), 65535L);
+    entry.phaseCentiDeg = (uint16_t)(lroundf(fmodf(phase, 360.0f) * 100.0f) % 36000);
+    int slot = harmonics.count;
+    if (slot == TIDE_MAX_CONSTITUENTS) {
+      slot = 0;
+      for (int i = 1; i < harmonics.count; i++) {
+        if (harmonics.constituents[i].amplitudeMm < harmonics.constituents[slot].amplitudeMm) slot = i;
+      }
+      if (harmonics.constituents[slot].amplitudeMm >= entry.amplitudeMm) continue;
+    } else {
+      harmonics.count++;
+    }
+    harmonics.constituents[slot] = entry;
+  }
+  LOG_INFO("Station %s: %d constituents, MSL %.3f m above MLLW", stationId, harmonics.count, harmonics.mslMm / 1000.0f);
+  return true;
+}
 
-  JsonArray predictions = doc["predictions"];
-  if (predictions.isNull() || predictions.size() == 0) return -9999.0f;
+// Harmonic constants for a station with at least one constituent: RAM, flash,
+// then a one-time download. nullptr means the caller should use the NOAA series.
+static const TideHarmonics *tideHarmonicsFor(const String &stationId) {
+  const int slots = sizeof(tideHarmonicsCache) / sizeof(tideHarmonicsCache[0]);
+  for (int i = 0; i < slots; i++) {
+    if (tideHarmonicsCache[i].valid && stationId == tideHarmonicsCache[i].stationId) {
+      return tideHarmonicsCache[i].count > 0 ? &tideHarmonicsCache[i] : nullptr;
+    }
+  }
+  TideHarmonics &entry = tideHarmonicsCache[tideHarmonicsNextSlot];
+  tideHarmonicsNextSlot = (tideHarmonicsNextSlot + 1) % slots;
+  if (!loadTideHarmonics(stationId.c_str(), entry)) {
+    if (!downloadTideHarmonics(stationId, entry)) {
+      entry = TideHarmonics();
+      return nullptr;
+    }
+    saveTideHarmonics(entry);
+  }
+  return entry.count > 0 ? &entry : nullptr;
+}
 
-  int currentHour = ti->tm_hour;
-  String valStr = predictions[0]["v"] | "0.0";
-  for (JsonVariant pred : predictions) {
-    String timeStr = pred["t"] | "";
-    int predHour = timeStr.length() >= 13 ? timeStr.substring(11, 13).toInt() : -1;
-    if (predHour == currentHour) { valStr = pred["v"] | "0.0"; break; }
+// Tide height (m) and rate (m/h) for a secondary blend station: harmonic
+// prediction, else its cached NOAA series. Does NOT touch the min/max bounds
+// file. Returns false if unavailable.
+static bool tideAtStation(const String &stationId, time_t now, float &heightM, float &rateMPerHour) {
+  if (stationId.isEmpty()) return false;
+  const TideHarmonics *harmonics = tideHarmonicsFor(stationId);
+  if (harmonics) {
+    heightM = predictTideHeight(*harmonics, now);
+    rateMPerHour = predictTideRate(*harmonics, now);
+    return true;
   }
-  return valStr.toFloat() * 0.3048f; // feet → metres
+  const TideSeries *series = tideSeriesFor(stationId, now - now % 86400);
+  if (!series) return false;
+  sampleTideSeries(*series, now, heightM, rateMPerHour);
+  return true;
 }
 
 // Returns true if the given coordinates have at least one data source:
@@ -782,42 +1109,91 @@ static float fetchTideHeightOnly(const String &stationId, const struct tm *ti) {
 // 2) Non-null marine wave data from the open-meteo API (global coastal coverage).
 // Used to filter location search results so only surf-capable locations are shown.
 bool locationHasData(float lat, float lon) {
-  // Fast path: local NOAA station lookup (no network needed)
-  String stationId = findNearestTideStation(lat, lon);
-  if (!stationId.isEmpty()) {
-    logInfo("locationHasData: NOAA station " + stationId + " found for (" + String(lat, 4) + "," + String(lon, 4) + ")");
-    return true;
-  }
+  LocationInfo candidate;
+  candidate.latitude = lat;
+  candidate.longitude = lon;
+  return locationsHaveData(std::vector<LocationInfo>(1, candidate))[0];
+}
 
-  // Slow path: probe marine API for wave data (catches non-US coastal locations)
-  if (WiFi.status() != WL_CONNECTED) return false;
-  HTTPClient http;
-  String url = String(MARINE_URL) + "?latitude=" + String(lat, 4) +
-               "&longitude=" + String(lon, 4) +
-               "&hourly=wave_height&forecast_days=1";
-  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-  http.setTimeout(6000);
-  http.begin(url);
-  int code = http.GET();
-  if (code != HTTP_CODE_OK) { http.end(); return false; }
-  String payload = http.getString();
-  http.end();
+// Open-Meteo answers a comma-separated coordinate list in one response; batches
+// are capped so the parsed document stays small.
+static const size_t PROBE_BATCH_SIZE = 10;
+
+std::vector<bool> locationsHaveData(const std::vector<LocationInfo> &candidates) {
+  NetworkLock lock;
+  std::vector<bool> hasData(candidates.size(), false);
+
+  // Fast path: local NOAA station lookup (no network needed, leaves the
+  // forecast's blend candidates untouched)
+  std::vector<size_t> pending;
+  for (size_t i = 0; i < candidates.size(); i++) {
+    TideStationMatch nearest;
+    if (findNearestTideStations(candidates[i].latitude, candidates[i].longitude, MAX_STATION_DISTANCE_KM, &nearest, 1) > 0) {
+      hasData[i] = true;
+      continue;
+    }
+    // Remembered marine verdicts, including negative "inland" ones
+    int cached = lookupProbeCache(candidates[i].latitude, candidates[i].longitude);
+    if (cached >= 0) hasData[i] = cached == 1;
+    else pending.push_back(i);
+  }
+  LOG_INFO("locationsHaveData: %u candidates, probing %u for marine data", candidates.size(), pending.size());
+
+  // Slow path: probe the marine API for wave data (catches non-US coastal locations)
+  if (pending.empty() || WiFi.status() != WL_CONNECTED) return hasData;
+  for (size_t start = 0; start < pending.size(); start += PROBE_BATCH_SIZE) {
+    size_t count = min(PROBE_BATCH_SIZE, pending.size() - start);
+    String lats, lons;
+    for (size_t k = 0; k < count; k++) {
+      const LocationInfo &c = candidates[pending[start + k]];
+      if (k > 0) {
+        lats += ",";
+        lons += ",";
+      }
+      lats += String(c.latitude, 4);
+      lons += String(c.longitude, 4);
+    }
 
-  DynamicJsonDocument doc(4 * 1024);
-  if (deserializeJson(doc, payload)) return false;
+    HTTPClient http;
+    String url = String(MARINE_URL) + "?latitude=" + lats + "&longitude=" + lons +
+                 "&hourly=wave_height&forecast_days=1";
+    if (!endpointAvailable(url)) break;
+    beginHttpGet(http, url, 8000, "probe");
+    int code = timedGet(http);
+    recordEndpointResult(url, code);
+    if (code != HTTP_CODE_OK) {
+      LOG_ERROR("locationsHaveData: marine probe failed: HTTP %d", code);
+      endHttpDiscard(http);
+      continue;
+    }
 
-  JsonArray heights = doc["hourly"]["wave_height"];
-  if (heights.isNull() || heights.size() == 0) return false;
+    // A single coordinate returns an object, several return an array of them
+    StaticJsonDocument<96> filter;
+    if (count > 1) filter[0]["hourly"]["wave_height"] = true;
+    else filter["hourly"]["wave_height"] = true;
+    DynamicJsonDocument doc(768 * count + 256);
+    DeserializationError err = parseJsonStream(http, doc, filter);
+    http.end();
+    if (err) {
+      LOG_ERROR("locationsHaveData: marine probe parse failed: %s", err.c_str());
+      continue;
+    }
 
-  for (JsonVariant h : heights) {
-    if (!h.isNull()) {
-      logInfo("locationHasData: marine wave data found for (" + String(lat, 4) + "," + String(lon, 4) + ")");
-      return true;
+    for (size_t k = 0; k < count; k++) {
+      size_t index = pending[start + k];
+      JsonVariant location = count > 1 ? doc[k].as<JsonVariant>() : doc.as<JsonVariant>();
+      JsonArray heights = location["hourly"]["wave_height"];
+      for (JsonVariant h : heights) {
+        if (!h.isNull()) {
+          hasData[index] = true;
+          break;
+        }
+      }
+      storeProbeCache(candidates[index].latitude, candidates[index].longitude, hasData[index]);
     }
   }
-
-  logInfo("locationHasData: no data for (" + String(lat, 4) + "," + String(lon, 4) + ") — inland/landlocked");
-  return false;
+  flushProbeCache();
+  return hasData;
 }
 
 static float cardinalToDegrees(const String &cardinal) {
@@ -852,101 +1228,218 @@ static float parseNOAAWindSpeed(const String &speedStr) {
   return speedStr.toFloat();
 }
 
-SurfForecast fetchSurfForecast(float latitude, float longitude) {
-  SurfForecast forecast;
-  if (WiFi.status() != WL_CONNECTED) return forecast;
+// ── Hourly forecast series ──────────────────────────────────────────────────
+
+// "YYYY-MM-DDTHH:MM[:SS][Z|+HH:MM|-HH:MM]" to UTC seconds; no offset means UTC
+// (Open-Meteo with timezone=UTC). Returns 0 if the text does not parse.
+static time_t parseIsoTime(const char *text) {
+  if (!text) return 0;
+  int y, mo, d, h, mi, sec = 0, consumed = 0;
+  if (sscanf(text, "%4d-%2d-%2dT%2d:%2d%n", &y, &mo, &d, &h, &mi, &consumed) != 5) return 0;
+  const char *rest = text + consumed;
+  if (*rest == ':') {
+    sec = atoi(rest + 1);
+    rest += 3;
+  }
+  long offsetMin = 0;
+  if (*rest == '+' || *rest == '-') {
+    int oh = 0, om = 0;
+    if (sscanf(rest + 1, "%2d:%2d", &oh, &om) >= 1) offsetMin = (*rest == '-' ? -1 : 1) * (oh * 60L + om);
+  }
+  return (time_t)(daysFromCivil(y, mo, d) * 86400L + h * 3600L + mi * 60L + sec - offsetMin * 60L);
+}
 
-  // ── 1. Wave data from Marine API ────────────────────────────────────────
-  // forecast_days=1 limits response to 24 hrs (~5 KB) instead of 7 days,
-  // keeping the heap less fragmented for subsequent HTTPS calls.
-  HTTPClient http;
-  String url = String(MARINE_URL) + "?latitude=" + String(latitude, 4) + "&longitude=" + String(longitude, 4) +
-               "&hourly=wave_height,wave_period,wave_direction&timezone=UTC&forecast_days=1";
-  http.setFollowRedirects(HTTPC_STRICT_FOLLOW_REDIRECTS);
-  http.begin(url);
-  http.setTimeout(10000);
-  int code = http.GET();
-  if (code != HTTP_CODE_OK) {
-    http.end();
-    return forecast;
+// "Thu, 16 Oct 2026 14:00:00 GMT" (RFC 7231 IMF-fixdate) to UTC seconds, 0 if
+// it does not parse.
+static time_t parseHttpDate(const String &text) {
+  static const char *MONTHS = "JanFebMarAprMayJunJulAugSepOctNovDec";
+  char month[4] = "";
+  int d, y, h, mi, sec;
+  if (sscanf(text.c_str(), "%*3s, %2d %3s %4d %2d:%2d:%2d", &d, month, &y, &h, &mi, &sec) != 6) return 0;
+  const char *found = strstr(MONTHS, month);
+  if (!found || strlen(month) != 3) return 0;
+  int mo = (found - MONTHS) / 3 + 1;
+  return (time_t)(daysFromCivil(y, mo, d) * 86400L + h * 3600L + mi * 60L + sec);
+}
+
+// How long a response stays fresh per its Cache-Control max-age (less Age) or
+// Expires minus Date, in ms. 0 when the headers say nothing usable.
+static uint32_t freshnessFromHeaders(HTTPClient &http) {
+  String cacheControl = http.header("Cache-Control");
+  cacheControl.toLowerCase();
+  if (cacheControl.indexOf("no-cache") >= 0 || cacheControl.indexOf("no-store") >= 0) return 0;
+  int maxAge = cacheControl.indexOf("max-age=");
+  if (maxAge >= 0) {
+    long seconds = cacheControl.substring(maxAge + 8).toInt() - http.header("Age").toInt();
+    return seconds > 0 ? (uint32_t)seconds * 1000UL : 0;
   }
+  time_t expires = parseHttpDate(http.header("Expires"));
+  time_t date = parseHttpDate(http.header("Date"));
+  if (expires != 0 && date != 0 && expires > date) return (uint32_t)(expires - date) * 1000UL;
+  return 0;
+}
 
-  DynamicJsonDocument doc(8 * 1024);
-  String payload = http.getString();
-  http.end();
-  if (deserializeJson(doc, payload)) return forecast;
+// Interpolate between two bearings along the shorter arc.
+static float lerpDegrees(float a, float b, float frac) {
+  float delta = fmodf(b - a + 540.0f, 360.0f) - 180.0f;
+  return fmodf(a + delta * frac + 360.0f, 360.0f);
+}
 
-  JsonArray times = doc["hourly"]["time"];
-  JsonArray heights = doc["hourly"]["wave_height"];
-  JsonArray periods = doc["hourly"]["wave_period"];
-  JsonArray directions = doc["hourly"]["wave_direction"];
-  if (times.isNull() || heights.isNull() || periods.isNull() || directions.isNull() || times.size() == 0) {
-    return forecast;
-  }
-
-  // Find the entry for the current UTC hour; fall back to index 0 if NTP not synced or no match
-  time_t waveNow = time(nullptr);
-  const struct tm *utcTm = gmtime(&waveNow);
-  int waveHour = (utcTm && waveNow >= 1000000000) ? utcTm->tm_hour : 0;
-  int bestIdx = 0;
-  for (int i = 0; i < (int)times.size(); i++) {
-    const char *tStr = times[i].as<const char *>();
-    if (!tStr) continue;
-    String t = String(tStr);
-    if (t.length() >= 13 && t.substring(11, 13).toInt() == waveHour) {
-      bestIdx = i;
-      break;
-    }
+// True if the series still reaches past now (NTP synced).
+static bool seriesCovers(const ForecastSeries &series, time_t now) {
+  return series.valid && now >= 1000000000 && now >= series.start &&
+         now < series.start + (time_t)(series.count - 1) * 3600;
+}
+
+// Set the wave and wind fields for a UTC time from the hourly series.
+// Returns false if the series does not cover that time.
+static bool sampleForecastSeries(SurfForecast &forecast, time_t t) {
+  const ForecastSeries &series = forecast.series;
+  if (!series.valid || t < series.start) return false;
+  float pos = (t - series.start) / 3600.0f;
+  if (pos > series.count - 1) return false;
+  int i = (int)pos;
+  int j = i + 1 < series.count ? i + 1 : i;
+  float frac = pos - i;
+
+  forecast.waveHeight = (series.waveHeightCm[i] + (series.waveHeightCm[j] - series.waveHeightCm[i]) * frac) / 100.0f;
+  forecast.wavePeriod = (series.wavePeriodDs[i] + (series.wavePeriodDs[j] - series.wavePeriodDs[i]) * frac) / 10.0f;
+  forecast.waveDirection = lerpDegrees(series.waveDirectionDeg[i], series.waveDirectionDeg[j], frac);
+  if (series.hasWind) {
+    forecast.windSpeed = (series.windSpeedX10[i] + (series.windSpeedX10[j] - series.windSpeedX10[i]) * frac) / 10.0f;
+    forecast.windDirection = lerpDegrees(series.windDirectionDeg[i], series.windDirectionDeg[j], frac);
   }
-  forecast.timeLabel   = String(times[bestIdx].as<const char *>());
-  forecast.waveHeight  = heights[bestIdx]    | 0.0f;
-  forecast.wavePeriod  = periods[bestIdx]    | 0.0f;
-  forecast.waveDirection = directions[bestIdx] | 0.0f;
 
-  // Free wave payload before next HTTPS call
-  payload = "";
-  doc.clear();
+  time_t hourStart = series.start + (time_t)i * 3600;
+  struct tm utc;
+  gmtime_r(&hourStart, &utc);
+  char label[20];
+  strftime(label, sizeof(label), "%Y-%m-%dT%H:%M", &utc);
+  forecast.timeLabel = label;
+  return true;
+}
 
-  // ── 2. Tide data from NOAA (do this BEFORE wind to reduce SSL heap pressure)
-  // The marine API SSL context has been freed; only one prior HTTPS session here.
-  if (cachedStationId.isEmpty() || abs(latitude - cachedStationLat) > 0.5f || abs(longitude - cachedStationLon) > 0.5f) {
-    logInfo("Finding nearest NOAA tide station for lat=" + String(latitude, 6) + ", lon=" + String(longitude, 6));
-    cachedStationId = findNearestTideStation(latitude, longitude);
-    cachedStationLat = latitude;
-    cachedStationLon = longitude;
+// NWS forecast periods (typically 12 h each) from the last 200 response,
+// parsed once and kept with its validators so a 304 can refill the wind.
+struct WindPeriod {
+  time_t end;
+  uint16_t speedX10;
+  uint16_t directionDeg;
+};
+static const int WIND_PERIODS_MAX = 16;
+static WindPeriod cachedWindPeriods[WIND_PERIODS_MAX];
+static int cachedWindPeriodCount = 0;
+static String cachedWindPeriodsUrl = "";
+static HttpValidators windValidators;
+
+static void cacheWindPeriods(const String &url, JsonArray periods) {
+  cachedWindPeriodCount = 0;
+  for (JsonVariant period : periods) {
+    if (cachedWindPeriodCount >= WIND_PERIODS_MAX) break;
+    WindPeriod &wp = cachedWindPeriods[cachedWindPeriodCount++];
+    String speedStr = period["windSpeed"] | "";
+    String dirStr = period["windDirection"] | "";
+    wp.end = parseIsoTime(period["endTime"] | "");
+    wp.speedX10 = (uint16_t)lroundf(parseNOAAWindSpeed(speedStr) * 10.0f);
+    wp.directionDeg = (uint16_t)lroundf(cardinalToDegrees(dirStr)) % 360;
+  }
+  cachedWindPeriodsUrl = cachedWindPeriodCount > 0 ? url : String("");
+}
+
+// Spread the cached NWS periods over the hourly series.
+// Hours before the first period take its values; hours past the last, the last.
+static void fillSeriesWind(ForecastSeries &series) {
+  if (!series.valid || cachedWindPeriodCount == 0) return;
+  int p = 0;
+  int last = cachedWindPeriodCount - 1;
+  for (int i = 0; i < series.count; i++) {
+    time_t hour = series.start + (time_t)i * 3600;
+    while (p < last && cachedWindPeriods[p].end <= hour) p++;
+    series.windSpeedX10[i] = cachedWindPeriods[p].speedX10;
+    series.windDirectionDeg[i] = cachedWindPeriods[p].directionDeg;
+  }
+  series.hasWind = true;
+}
+
+// Tide height, rate and daily range at the current time for a location,
+// blended across the nearest stations. After the first refresh for a spot this
+// runs from cached harmonics and series; crossCheck also compares against the
+// NOAA series, which may fetch the new day's predictions.
+static void fillTide(SurfForecast &forecast, float latitude, float longitude, bool crossCheck) {
+  forecast.tideHeight = 0.0f;
+  forecast.tideRate = 0.0f;
+  forecast.minTide = 0.0f;
+  forecast.maxTide = 0.0f;
+  LocationCell &cell = locationCellFor(latitude, longitude);
+  if (!cell.stationsResolved) {
+    LOG_INFO("Finding nearest NOAA tide station for lat=%.6f, lon=%.6f", latitude, longitude);
+    findNearestTideStation(latitude, longitude);
+    cell.stationCount = (uint8_t)min(cachedCandidateCount, LOCATION_CELL_STATIONS);
+    for (int i = 0; i < cell.stationCount; i++) {
+      memcpy(cell.stationId[i], cachedCandidates[i].id, sizeof(cell.stationId[i]));
+      cell.stationDistKm[i] = cachedCandidates[i].distKm;
+    }
+    cell.stationsResolved = true;
+    storeLocationCell(cell);
   } else {
-    logInfo("Using cached NOAA station: " + cachedStationId + " (lat=" + String(latitude, 6) + ", lon=" + String(longitude, 6) + ")");
+    cachedCandidateCount = cell.stationCount;
+    for (int i = 0; i < cell.stationCount; i++) {
+      memcpy(cachedCandidates[i].id, cell.stationId[i], sizeof(cachedCandidates[i].id));
+      cachedCandidates[i].distKm = cell.stationDistKm[i];
+    }
+    LOG_INFO("Using cached NOAA station: %s (lat=%.6f, lon=%.6f)", cell.stationCount ? cell.stationId[0] : "none", latitude, longitude);
   }
+  String stationId = cachedCandidateCount > 0 ? String(cachedCandidates[0].id) : String("");
 
-  if (!cachedStationId.isEmpty()) {
-    forecast.tideHeight = fetchNOAATideHeight(cachedStationId, forecast.minTide, forecast.maxTide);
-    Serial.printf("[TIDE] forecast: height=%.3fm, min=%.3fm, max=%.3fm\n", forecast.tideHeight, forecast.minTide, forecast.maxTide);
+  if (!stationId.isEmpty()) {
+    // Harmonic prediction is the main source; NOAA's published series is the
+    // fallback and, when it is already cached or WiFi is up, a cross-check.
+    time_t tideNow = time(nullptr);
+    const TideHarmonics *harmonics = tideNow >= 1000000000 ? tideHarmonicsFor(stationId) : nullptr;
+    if (harmonics) {
+      forecast.tideHeight = predictTideHeight(*harmonics, tideNow);
+      forecast.tideRate = predictTideRate(*harmonics, tideNow);
+      predictTideDay(*harmonics, tideNow, nullptr, 0, forecast.minTide, forecast.maxTide);
+      float refMin = 0.0f, refMax = 0.0f;
+      float reference = crossCheck ? fetchNOAATideHeight(stationId, refMin, refMax) : 0.0f;
+      if (refMin != 0.0f || refMax != 0.0f) {
+        float diff = forecast.tideHeight - reference;
+        if (fabsf(diff) > TIDE_CROSSCHECK_TOLERANCE_M) {
+          LOG_ERROR("[TIDE] Harmonic prediction differs from NOAA by %.3f m at %s", diff, stationId);
+        } else {
+          LOG_INFO("[TIDE] Harmonic prediction within %.3f m of NOAA", fabsf(diff));
+        }
+      }
+    } else {
+      forecast.tideHeight = fetchNOAATideHeight(stationId, forecast.minTide, forecast.maxTide, &forecast.tideRate);
+    }
+    LOG_DEBUG("[TIDE] forecast: height=%.3fm, rate=%.3fm/h, min=%.3fm, max=%.3fm",
+              forecast.tideHeight, forecast.tideRate, forecast.minTide, forecast.maxTide);
 
     if (cachedCandidateCount > 1) {
-      time_t blendNow = time(nullptr);
-      const struct tm *ti = gmtime(&blendNow);
       const float MIN_DIST_KM = 5.0f;
       float d0 = cachedCandidates[0].distKm < MIN_DIST_KM ? MIN_DIST_KM : cachedCandidates[0].distKm;
       float w0 = 1.0f / (d0 * d0);
       float heightSum = forecast.tideHeight * w0;
+      float rateSum = forecast.tideRate * w0;
       float weightSum = w0;
 
       for (int i = 1; i < cachedCandidateCount; i++) {
-        float h = fetchTideHeightOnly(String(cachedCandidates[i].id), ti);
-        if (h > -999.0f) {
+        float h = 0.0f, r = 0.0f;
+        if (tideAtStation(String(cachedCandidates[i].id), tideNow, h, r)) {
           float di = cachedCandidates[i].distKm < MIN_DIST_KM ? MIN_DIST_KM : cachedCandidates[i].distKm;
           float wi = 1.0f / (di * di);
           heightSum += h * wi;
+          rateSum += r * wi;
           weightSum += wi;
-          logInfo("[TIDE] blend[" + String(i) + "] station=" + String(cachedCandidates[i].id) +
-                  " dist=" + String(cachedCandidates[i].distKm, 1) + "km h=" + String(h, 3) + "m");
+          LOG_INFO("[TIDE] blend[%d] station=%s dist=%.1fkm h=%.3fm", i, cachedCandidates[i].id, cachedCandidates[i].distKm, h);
         }
       }
 
       float blended = heightSum / weightSum;
-      logInfo("[TIDE] Blended height=" + String(blended, 3) + "m from " +
-              String(cachedCandidateCount) + " stations (primary=" + String(forecast.tideHeight, 3) + "m)");
+      LOG_INFO("[TIDE] Blended height=%.3fm from %d stations (primary=%.3fm)", blended, cachedCandidateCount, forecast.tideHeight);
       forecast.tideHeight = blended;
+      forecast.tideRate = rateSum / weightSum;
     }
 
     // If primary station failed to provide min/max bounds, fall back to a secondary station.
@@ -958,85 +1451,445 @@ SurfForecast fetchSurfForecast(float latitude, float longitude) {
         if (secMin != 0.0f || secMax != 0.0f) {
           forecast.minTide = secMin;
           forecast.maxTide = secMax;
-          logInfo("[TIDE] min/max fallback from secondary station " + String(cachedCandidates[i].id));
+          LOG_INFO("[TIDE] min/max fallback from secondary station %s", cachedCandidates[i].id);
           break;
         }
       }
     }
   } else {
-    logError("No NOAA tide station found, tide unavailable");
+    LOG_ERROR("No NOAA tide station found, tide unavailable");
     forecast.tideHeight = 0.0f;
     forecast.minTide = 0.0f;
     forecast.maxTide = 0.0f;
   }
+}
+
+// ── 1. Wave data from Marine API ────────────────────────────────────────
+// Fills the wave fields of a new series starting at the current UTC hour.
+// forecast_days=2 (~10 KB) rather than 7 days: enough for a 24-hour series
+// from the current hour onwards (today alone runs out late in the UTC day).
+// The body is parsed straight off the socket through a filter, so the only
+// allocation is the ~4 KB filtered document (no payload String alongside it).
+// cached, if given, is the series parsed from the last response for this spot;
+// it is revalidated, and a 304 keeps it as is.
+static String marineValidatedUrl = "";
+static HttpValidators marineValidators;
+
+static bool fetchMarineSeries(float latitude, float longitude, ForecastSeries &series, const ForecastSeries *cached) {
+  HTTPClient http;
+  String url = String(MARINE_URL) + "?latitude=" + String(latitude, 4) + "&longitude=" + String(longitude, 4) +
+               "&hourly=wave_height,wave_period,wave_direction&timezone=UTC&forecast_days=2";
+  if (!endpointAvailable(url)) return false;
+  bool conditional = cached && cached->valid && url == marineValidatedUrl;
+  beginHttpGet(http, url, 10000, "marine");
+  if (conditional) sendValidators(http, marineValidators);
+  int code = timedGet(http);
+  recordEndpointResult(url, code);
+  if (code == HTTP_CODE_NOT_MODIFIED && conditional) {
+    markSourceFetched(SOURCE_MARINE, freshnessFromHeaders(http));
+    http.end();
+    series = *cached;
+    LOG_INFO("Marine forecast not modified, keeping cached series");
+    return true;
+  }
+  if (code != HTTP_CODE_OK) {
+    endHttpDiscard(http);
+    return false;
+  }
+  uint32_t freshForMs = freshnessFromHeaders(http);
+  marineValidatedUrl = storeValidators(http, marineValidators) ? url : String("");
+
+  StaticJsonDocument<128> waveFilter;
+  waveFilter["hourly"]["time"] = true;
+  waveFilter["hourly"]["wave_height"] = true;
+  waveFilter["hourly"]["wave_period"] = true;
+  waveFilter["hourly"]["wave_direction"] = true;
+  DynamicJsonDocument doc(5 * 1024);
+  DeserializationError waveErr = parseJsonStream(http, doc, waveFilter);
+  http.end();
+  if (waveErr) {
+    LOG_ERROR("Marine API JSON parse failed: %s", waveErr.c_str());
+    return false;
+  }
+
+  JsonArray times = doc["hourly"]["time"];
+  JsonArray heights = doc["hourly"]["wave_height"];
+  JsonArray periods = doc["hourly"]["wave_period"];
+  JsonArray directions = doc["hourly"]["wave_direction"];
+  if (times.isNull() || heights.isNull() || periods.isNull() || directions.isNull() || times.size() == 0) {
+    return false;
+  }
+
+  // Start at the current hour; at the first sample if NTP is not synced
+  time_t now = time(nullptr);
+  time_t firstTime = parseIsoTime(times[0].as<const char *>());
+  if (firstTime == 0) return false;
+  int first = 0;
+  if (now >= 1000000000 && now > firstTime) {
+    first = min((int)((now - firstTime) / 3600), (int)times.size() - 1);
+  }
+  series = ForecastSeries();
+  series.start = firstTime + (time_t)first * 3600;
+  for (int i = first; i < (int)times.size() && series.count < FORECAST_SERIES_HOURS; i++) {
+    float h = heights[i] | 0.0f;
+    float p = periods[i] | 0.0f;
+    float d = directions[i] | 0.0f;
+    series.waveHeightCm[series.count] = (uint16_t)lroundf(max(h, 0.0f) * 100.0f);
+    series.wavePeriodDs[series.count] = (uint16_t)lroundf(max(p, 0.0f) * 10.0f);
+    series.waveDirectionDeg[series.count] = (uint16_t)lroundf(d) % 360;
+    series.count++;
+  }
+  series.valid = true;
+  markSourceFetched(SOURCE_MARINE, freshForMs);
+  return true;
+}
 
-  // ── 3. Wind data from NWS (non-hourly forecast — 14 periods, ~20 KB response)
-  // Using the compact /forecast endpoint instead of /forecast/hourly (156 periods, ~80 KB).
-  // Step 3a: Resolve the NWS grid URL for this location (cached per location).
-  if (cachedNoaaGridUrl.isEmpty() || abs(latitude - cachedNoaaWindLat) > 0.5f || abs(longitude - cachedNoaaWindLon) > 0.5f) {
-    String pointUrl = "https://api.weather.gov/points/" + String(latitude, 4) + "," + String(longitude, 4);
-    http.begin(pointUrl);
-    http.setTimeout(10000);
+// ── 3. Wind data from NWS (non-hourly forecast — 14 periods, ~20 KB response)
+// Using the compact /forecast endpoint instead of /forecast/hourly (156 periods, ~80 KB).
+// Spreads the periods over the series' hours.
+static bool fetchWindPeriods(float latitude, float longitude, ForecastSeries &series) {
+  HTTPClient http;
+  int code = 0;
+  // Step 3a: Resolve the NWS grid URL for this location (cached per grid cell).
+  // Points outside the US answer 404; the endpoint breaker keeps that from
+  // being asked again every refresh.
+  LocationCell &cell = locationCellFor(latitude, longitude);
+  String gridUrl = cell.nwsForecastUrl;
+  String pointEndpoint = "nws-points:" + String(latitude, 2) + "," + String(longitude, 2);
+  String pointUrl = "https://api.weather.gov/points/" + String(latitude, 4) + "," + String(longitude, 4);
+  if (gridUrl.isEmpty() && endpointAvailable(pointUrl, pointEndpoint)) {
+    beginHttpGet(http, pointUrl, 10000, "nws-points");
     http.addHeader("User-Agent", "(SurfCYD, ESP32)");
     http.addHeader("Accept", "application/geo+json");
-    code = http.GET();
+    code = timedGet(http);
+    recordEndpointResult(pointUrl, code, pointEndpoint);
     if (code == HTTP_CODE_OK) {
-      payload = http.getString();
-      http.end();
       StaticJsonDocument<64> pointFilter;
       pointFilter["properties"]["forecast"] = true;
       DynamicJsonDocument pointDoc(512);
-      if (deserializeJson(pointDoc, payload, DeserializationOption::Filter(pointFilter)) == DeserializationError::Ok) {
+      DeserializationError pointErr = parseJsonStream(http, pointDoc, pointFilter);
+      http.end();
+      if (pointErr == DeserializationError::Ok) {
         // Use compact /forecast (14 periods, ~20 KB) instead of /forecast/hourly (156 periods, ~80 KB)
         const char *forecastUrl = pointDoc["properties"]["forecast"];
         if (forecastUrl) {
-          cachedNoaaGridUrl = String(forecastUrl);
-          cachedNoaaWindLat = latitude;
-          cachedNoaaWindLon = longitude;
-          logInfo("NOAA NWS forecast URL cached: " + cachedNoaaGridUrl);
+          gridUrl = String(forecastUrl);
+          if (gridUrl.length() < sizeof(cell.nwsForecastUrl)) {
+            strcpy(cell.nwsForecastUrl, forecastUrl);
+            storeLocationCell(cell);
+          }
+          LOG_INFO("NOAA NWS forecast URL cached: %s", gridUrl);
         }
       }
     } else {
-      logError("NOAA NWS points API failed: HTTP " + String(code));
-      http.end();
+      LOG_ERROR("NOAA NWS points API failed: HTTP %d", code);
+      endHttpDiscard(http);
     }
   }
 
-  // Step 3b: Fetch wind from the compact NWS forecast endpoint.
-  if (!cachedNoaaGridUrl.isEmpty()) {
-    http.begin(cachedNoaaGridUrl);
-    http.setTimeout(10000);
-    http.addHeader("User-Agent", "(SurfCYD, ESP32)");
-    http.addHeader("Accept", "application/geo+json");
-    code = http.GET();
-    if (code == HTTP_CODE_OK) {
-      payload = http.getString();
-      http.end();
-      StaticJsonDocument<128> windFilter;
-      windFilter["properties"]["periods"][0]["windSpeed"] = true;
-      windFilter["properties"]["periods"][0]["windDirection"] = true;
-      DynamicJsonDocument windDoc(2 * 1024);
-      if (deserializeJson(windDoc, payload, DeserializationOption::Filter(windFilter)) == DeserializationError::Ok) {
-        JsonArray wperiods = windDoc["properties"]["periods"];
-        if (!wperiods.isNull() && wperiods.size() > 0) {
-          String speedStr = wperiods[0]["windSpeed"]    | "";
-          String dirStr   = wperiods[0]["windDirection"] | "";
-          forecast.windSpeed     = parseNOAAWindSpeed(speedStr);
-          forecast.windDirection = cardinalToDegrees(dirStr);
-          logInfo("NOAA wind: " + speedStr + " from " + dirStr +
-                  " (" + String(forecast.windDirection, 0) + "deg)");
-        } else {
-          logError("NOAA NWS wind: no periods in response");
-        }
-      } else {
-        logError("NOAA NWS wind JSON parse failed");
-      }
+  // Step 3b: Fetch wind from the compact NWS forecast endpoint. The periods
+  // change a few times a day; in between NWS answers a revalidation with 304
+  // and the periods parsed last time are reused.
+  if (gridUrl.isEmpty() || !endpointAvailable(gridUrl)) return false;
+  bool conditional = cachedWindPeriodsUrl == gridUrl;
+  beginHttpGet(http, gridUrl, 10000, "nws-forecast");
+  http.addHeader("User-Agent", "(SurfCYD, ESP32)");
+  http.addHeader("Accept", "application/geo+json");
+  if (conditional) sendValidators(http, windValidators);
+  code = timedGet(http);
+  recordEndpointResult(gridUrl, code);
+  if (code == HTTP_CODE_NOT_MODIFIED && conditional) {
+    markSourceFetched(SOURCE_WIND, freshnessFromHeaders(http));
+    http.end();
+    LOG_INFO("NOAA NWS forecast not modified, reusing %d periods", cachedWindPeriodCount);
+    fillSeriesWind(series);
+    return true;
+  }
+  if (code != HTTP_CODE_OK) {
+    LOG_ERROR("NOAA NWS forecast failed: HTTP %d", code);
+    endHttpDiscard(http);
+    return false;
+  }
+  uint32_t freshForMs = freshnessFromHeaders(http);
+  HttpValidators validators;
+  bool validated = storeValidators(http, validators);
+
+  StaticJsonDocument<192> windFilter;
+  windFilter["properties"]["periods"][0]["startTime"] = true;
+  windFilter["properties"]["periods"][0]["endTime"] = true;
+  windFilter["properties"]["periods"][0]["windSpeed"] = true;
+  windFilter["properties"]["periods"][0]["windDirection"] = true;
+  DynamicJsonDocument windDoc(3 * 1024);
+  DeserializationError windErr = parseJsonStream(http, windDoc, windFilter);
+  http.end();
+  if (windErr != DeserializationError::Ok) {
+    LOG_ERROR("NOAA NWS wind JSON parse failed");
+    return false;
+  }
+  JsonArray wperiods = windDoc["properties"]["periods"];
+  if (wperiods.isNull() || wperiods.size() == 0) {
+    LOG_ERROR("NOAA NWS wind: no periods in response");
+    return false;
+  }
+  String speedStr = wperiods[0]["windSpeed"]    | "";
+  String dirStr   = wperiods[0]["windDirection"] | "";
+  LOG_INFO("NOAA wind: %s from %s", speedStr, dirStr);
+  cacheWindPeriods(gridUrl, wperiods);
+  windValidators = validators;
+  if (!validated) cachedWindPeriodsUrl = "";
+  fillSeriesWind(series);
+  markSourceFetched(SOURCE_WIND, freshForMs);
+  return true;
+}
+
+static bool fetchWindSeries(float latitude, float longitude, ForecastSeries &series) {
+  StageTimer timer("nws", STAGE_TOTAL);
+  bool ok = fetchWindPeriods(latitude, longitude, series);
+  timer.finish(ok ? 0 : -1);
+  return ok;
+}
+
+// Keep wind from an older series when only the marine series was refetched:
+// re-align it to the new start hour, holding the last value past its end.
+static void carrySeriesWind(const ForecastSeries &from, ForecastSeries &to) {
+  if (!from.valid || !from.hasWind || !to.valid || from.count == 0) return;
+  long shift = (long)((to.start - from.start) / 3600);
+  for (int i = 0; i < to.count; i++) {
+    long src = i + shift;
+    if (src < 0) src = 0;
+    if (src > from.count - 1) src = from.count - 1;
+    to.windSpeedX10[i] = from.windSpeedX10[src];
+    to.windDirectionDeg[i] = from.windDirectionDeg[src];
+  }
+  to.hasWind = true;
+}
+
+// Rebuild a forecast for now: refetch whichever sources are due, re-index the
+// hourly series and recompute the tide. base may be empty (first fetch).
+static SurfForecast updateSurfForecastOnPool(const SurfForecast &base, float latitude, float longitude) {
+  SurfForecast forecast = base;
+  forecast.valid = false;
+  time_t now = time(nullptr);
+  bool synced = now >= 1000000000;
+  bool online = WiFi.status() == WL_CONNECTED;
+
+  bool covered = seriesCovers(base.series, now);
+  if (online && (!covered || sourceStale(SOURCE_MARINE))) {
+    ForecastSeries fresh;
+    if (fetchMarineSeries(latitude, longitude, fresh, covered ? &base.series : nullptr)) {
+      carrySeriesWind(base.series, fresh);
+      forecast.series = fresh;
     } else {
-      logError("NOAA NWS forecast failed: HTTP " + String(code));
-      http.end();
+      markSourceFailed(SOURCE_MARINE);
     }
   }
+  if (!forecast.series.valid) return SurfForecast();
+
+  // ── 2. Tide data from NOAA (do this BEFORE wind to reduce SSL heap pressure)
+  // The marine API SSL context has been freed; only one prior HTTPS session here.
+  bool tideDue = online && sourceStale(SOURCE_TIDE);
+  fillTide(forecast, latitude, longitude, tideDue);
+  if (tideDue) markSourceFetched(SOURCE_TIDE, 0);
+
+  if (online && (!forecast.series.hasWind || sourceStale(SOURCE_WIND))) {
+    if (!fetchWindSeries(latitude, longitude, forecast.series)) markSourceFailed(SOURCE_WIND);
+  }
 
+  // Anything still due could not be fetched (e.g. offline); retry it after a
+  // pause rather than on every pass
+  for (int i = 0; i < SOURCE_COUNT; i++) {
+    if (sourceStale((ForecastSource)i)) markSourceFailed((ForecastSource)i);
+  }
+
+  // Current hour, interpolated; the first sample if NTP is not synced
+  if (!sampleForecastSeries(forecast, synced ? now : forecast.series.start)) return SurfForecast();
   forecast.valid = true;
+  LocationCell &cell = locationCellFor(latitude, longitude);
+  cell.series = forecast.series;
+  storeLocationCell(cell);
+  logRefreshSchedule();
   return forecast;
 }
+
+SurfForecast updateSurfForecast(const SurfForecast &base, float latitude, float longitude) {
+  NetworkLock lock;
+  StageTimer timer("refresh", STAGE_TOTAL);
+  SurfForecast forecast = updateSurfForecastOnPool(base, latitude, longitude);
+  // Release the TLS sessions held open for this refresh; DNS results are kept.
+  closeHttpConnections();
+  flushLocationCache();
+  timer.finish(forecast.valid ? 0 : -1);
+  return forecast;
+}
+
+SurfForecast fetchSurfForecast(float latitude, float longitude) {
+  NetworkLock lock;
+  markAllSourcesStale();
+  // A series cached for this cell that still covers now stands in if the
+  // marine API fails, and keeps its wind if NWS does
+  SurfForecast base;
+  const LocationCell &cell = locationCellFor(latitude, longitude);
+  if (seriesCovers(cell.series, time(nullptr))) {
+    base.series = cell.series;
+    LOG_INFO("Starting from the cached series for this grid cell");
+  }
+  return updateSurfForecast(base, latitude, longitude);
+}
+
+// ── Multi-spot overview ─────────────────────────────────────────────────────
+// Every spot's wave series comes from one marine request carrying all the
+// coordinates, and each NOAA station's tide is evaluated once and shared by the
+// spots that map to it. Between marine refetches a rebuild only re-indexes the
+// cached series and re-evaluates the tide curves (locally, from harmonics), so
+// the cost grows with the number of distinct stations rather than spots.
+static const int SPOT_SERIES_HOURS = 12;                          // keeps the batch document small
+static const uint32_t SPOT_MARINE_DEFAULT_FRESH_MS = 60UL * 60UL * 1000UL;
+static uint32_t spotMarineFetchedAt = 0;   // millis()
+static uint32_t spotMarineFreshMs = 0;     // 0 = not fetched yet
+
+// Wave series for spots[indices] from a single request. timeformat=unixtime
+// spares a time string per sample; forecast_hours limits the answer to the
+// hours an overview uses before its next refetch.
+static bool fetchSpotMarineBatch(std::vector<SpotForecast> &spots, const std::vector<size_t> &indices) {
+  size_t count = indices.size();
+  String lats, lons;
+  for (size_t k = 0; k < count; k++) {
+    if (k > 0) {
+      lats += ",";
+      lons += ",";
+    }
+    lats += String(spots[indices[k]].latitude, 4);
+    lons += String(spots[indices[k]].longitude, 4);
+  }
+
+  HTTPClient http;
+  String url = String(MARINE_URL) + "?latitude=" + lats + "&longitude=" + lons +
+               "&hourly=wave_height,wave_period,wave_direction&timezone=UTC&timeformat=unixtime&forecast_hours=" +
+               String(SPOT_SERIES_HOURS);
+  if (!endpointAvailable(url)) return false;
+  beginHttpGet(http, url, 10000, "spot-marine");
+  int code = timedGet(http);
+  recordEndpointResult(url, code);
+  if (code != HTTP_CODE_OK) {
+    LOG_ERROR("Spot overview: marine batch failed: HTTP %d", code);
+    endHttpDiscard(http);
+    return false;
+  }
+  uint32_t freshForMs = freshnessFromHeaders(http);
+
+  // A single coordinate returns an object, several return an array of them
+  StaticJsonDocument<192> filter;
+  JsonObject hourlyFilter =
+      count > 1 ? filter.createNestedObject().createNestedObject("hourly") : filter.createNestedObject("hourly");
+  hourlyFilter["time"] = true;
+  hourlyFilter["wave_height"] = true;
+  hourlyFilter["wave_period"] = true;
+  hourlyFilter["wave_direction"] = true;
+  DynamicJsonDocument doc(1024 * count + 256);
+  DeserializationError err = parseJsonStream(http, doc, filter);
+  http.end();
+  if (err) {
+    LOG_ERROR("Spot overview: marine batch parse failed: %s", err.c_str());
+    return false;
+  }
+
+  time_t now = time(nullptr);
+  int filled = 0;
+  for (size_t k = 0; k < count; k++) {
+    JsonVariant hourly = count > 1 ? doc[k]["hourly"].as<JsonVariant>() : doc["hourly"].as<JsonVariant>();
+    JsonArray times = hourly["time"];
+    JsonArray heights = hourly["wave_height"];
+    JsonArray periods = hourly["wave_period"];
+    JsonArray directions = hourly["wave_direction"];
+    if (times.isNull() || heights.isNull() || periods.isNull() || directions.isNull() || times.size() == 0) continue;
+
+    time_t firstTime = (time_t)(times[0] | 0L);
+    int first = 0;
+    if (now >= 1000000000 && now > firstTime) first = min((int)((now - firstTime) / 3600), (int)times.size() - 1);
+    ForecastSeries series;
+    series.start = firstTime + (time_t)first * 3600;
+    for (int i = first; i < (int)times.size() && series.count < FORECAST_SERIES_HOURS; i++) {
+      float h = heights[i] | 0.0f;
+      float p = periods[i] | 0.0f;
+      float d = directions[i] | 0.0f;
+      series.waveHeightCm[series.count] = (uint16_t)lroundf(max(h, 0.0f) * 100.0f);
+      series.wavePeriodDs[series.count] = (uint16_t)lroundf(max(p, 0.0f) * 10.0f);
+      series.waveDirectionDeg[series.count] = (uint16_t)lroundf(d) % 360;
+      series.count++;
+    }
+    series.valid = series.count > 0;
+    spots[indices[k]].series = series;
+    filled++;
+  }
+  spotMarineFetchedAt = millis();
+  spotMarineFreshMs = max(freshForMs > 0 ? freshForMs : SPOT_MARINE_DEFAULT_FRESH_MS, FORECAST_REINDEX_INTERVAL_MS);
+  LOG_INFO("Spot overview: marine series for %d/%d spots in one request", filled, count);
+  return filled > 0;
+}
+
+// Nearest station for a spot, once: the gazetteer's precomputed match for a
+// catalogued break, else the local station table.
+static void assignSpotStation(SpotForecast &spot) {
+  if (spot.stationId[0]) return;
+  TideStationMatch match;
+  int found = surfSpotTideStations(spot.latitude, spot.longitude, &match, 1);
+  if (found < 0) found = findNearestTideStations(spot.latitude, spot.longitude, MAX_STATION_DISTANCE_KM, &match, 1);
+  if (found > 0) strncpy(spot.stationId, match.id, sizeof(spot.stationId) - 1);
+}
+
+bool updateSpotForecasts(std::vector<SpotForecast> &spots) {
+  NetworkLock lock;
+  StageTimer timer("overview", STAGE_TOTAL);
+  if (spots.size() > (size_t)MAX_OVERVIEW_SPOTS) spots.resize(MAX_OVERVIEW_SPOTS);
+  time_t now = time(nullptr);
+  bool synced = now >= 1000000000;
+
+  bool marineStale = spotMarineFreshMs == 0 || millis() - spotMarineFetchedAt >= spotMarineFreshMs;
+  std::vector<size_t> missing;
+  for (size_t i = 0; i < spots.size(); i++) {
+    if (marineStale || !synced || !seriesCovers(spots[i].series, now)) missing.push_back(i);
+  }
+  if (!missing.empty() && WiFi.status() == WL_CONNECTED) fetchSpotMarineBatch(spots, missing);
+
+  struct StationTide {
+    const char *id;
+    float height;
+    float rate;
+    bool ok;
+  };
+  StationTide tides[MAX_OVERVIEW_SPOTS];
+  int stationCount = 0;
+  int ready = 0;
+  for (SpotForecast &spot : spots) {
+    assignSpotStation(spot);
+    spot.hasTide = false;
+    if (synced && spot.stationId[0]) {
+      int t = 0;
+      while (t < stationCount && strcmp(tides[t].id, spot.stationId) != 0) t++;
+      if (t == stationCount) {
+        tides[t].id = spot.stationId;
+        tides[t].ok = tideAtStation(String(spot.stationId), now, tides[t].height, tides[t].rate);
+        stationCount++;
+      }
+      if (tides[t].ok) {
+        spot.tideHeight = tides[t].height;
+        spot.tideRate = tides[t].rate;
+        spot.hasTide = true;
+      }
+    }
+
+    SurfForecast sampled;
+    sampled.series = spot.series;
+    spot.valid = sampleForecastSeries(sampled, synced ? now : spot.series.start);
+    if (spot.valid) {
+      spot.waveHeight = sampled.waveHeight;
+      spot.wavePeriod = sampled.wavePeriod;
+      spot.waveDirection = sampled.waveDirection;
+      ready++;
+    }
+  }
+  closeHttpConnections();
+  timer.finish(ready > 0 ? 0 : -1);
+  LOG_INFO("Spot overview: %d/%u spots ready, %d tide stations", ready, spots.size(), stationCount);
+  return ready > 0;
+}
@@ -0,0 +1,115 @@
+#include "RefreshScheduler.h"
+#include "Config.h"
+#include "Storage.h"
+#include "Log.h"
+#include <time.h>
+
+// Per-source freshness, in millis() so it works before NTP sync. Written by
+// whichever context fetches forecasts and read by the UI loop; each field is a
+// single aligned word, so a reader at worst sees the previous schedule.
+struct SourceState {
+  uint32_t fetchedAt;    // millis() of the last success or failure
+  uint32_t freshForMs;   // 0 = stale
+};
+
+static SourceState sources[SOURCE_COUNT];
+
+static const uint32_t MIN_FRESH_MS = 5UL * 60UL * 1000UL;
+static const uint32_t MAX_FRESH_MS = 12UL * 60UL * 60UL * 1000UL;
+static const uint32_t FAILED_RETRY_MS = 5UL * 60UL * 1000UL;
+
+// Open-Meteo's marine models (GFS-Wave, ECMWF WAM) run four times a day and
+// land a few hours after each cycle; new data is expected around these UTC
+// times. NWS grid forecasts are reissued at irregular times, about hourly.
+static const uint8_t MARINE_UPDATE_HOURS_UTC[] = {4, 10, 16, 22};
+static const uint32_t MARINE_UPDATE_MINUTE = 30;
+static const uint32_t WIND_UPDATE_MINUTE = 10;
+static const uint32_t DEFAULT_FRESH_MS = 60UL * 60UL * 1000UL;  // before NTP sync
+
+const char *forecastSourceName(ForecastSource source) {
+  switch (source) {
+    case SOURCE_MARINE: return "marine";
+    case SOURCE_WIND:   return "wind";
+    case SOURCE_TIDE:   return "tide";
+    default:            return "?";
+  }
+}
+
+// Seconds from now until the next of the given UTC hours at minute past.
+static uint32_t secondsUntilUtcHour(const struct tm &utc, const uint8_t *hours, int count, uint32_t minute) {
+  uint32_t nowS = utc.tm_hour * 3600UL + utc.tm_min * 60UL + utc.tm_sec;
+  uint32_t best = 86400UL;
+  for (int i = 0; i < count; i++) {
+    uint32_t at = hours[i] * 3600UL + minute * 60UL;
+    uint32_t wait = at > nowS ? at - nowS : at + 86400UL - nowS;
+    if (wait < best) best = wait;
+  }
+  return best;
+}
+
+// Freshness from known upstream update times, when headers gave none.
+static uint32_t scheduledFreshMs(ForecastSource source) {
+  time_t now = time(nullptr);
+  if (now < 1000000000) return DEFAULT_FRESH_MS;
+  struct tm utc;
+  gmtime_r(&now, &utc);
+  switch (source) {
+    case SOURCE_MARINE:
+      return secondsUntilUtcHour(utc, MARINE_UPDATE_HOURS_UTC, sizeof(MARINE_UPDATE_HOURS_UTC), MARINE_UPDATE_MINUTE) * 1000UL;
+    case SOURCE_WIND: {
+      uint32_t nowS = utc.tm_min * 60UL + utc.tm_sec;
+      uint32_t at = WIND_UPDATE_MINUTE * 60UL;
+      return (at > nowS ? at - nowS : at + 3600UL - nowS) * 1000UL;
+    }
+    case SOURCE_TIDE:
+      // Predictions are fixed for the UTC day
+      return (86400UL - (utc.tm_hour * 3600UL + utc.tm_min * 60UL + utc.tm_sec)) * 1000UL;
+    default:
+      return DEFAULT_FRESH_MS;
+  }
+}
+
+void markSourceFetched(ForecastSource source, uint32_t freshForMs) {
+  if (source >= SOURCE_COUNT) return;
+  if (freshForMs == 0) freshForMs = scheduledFreshMs(source);
+  if (freshForMs < MIN_FRESH_MS) freshForMs = MIN_FRESH_MS;
+  if (freshForMs > MAX_FRESH_MS) freshForMs = MAX_FRESH_MS;
+  sources[source].fetchedAt = millis();
+  sources[source].freshForMs = freshForMs;
+}
+
+void markSourceFailed(ForecastSource source) {
+  if (source >= SOURCE_COUNT) return;
+  sources[source].fetchedAt = millis();
+  sources[source].freshForMs = FAILED_RETRY_MS;
+}
+
+void markAllSourcesStale() {
+  for (int i = 0; i < SOURCE_COUNT; i++) sources[i].freshForMs = 0;
+}
+
+uint32_t sourceDueInMs(ForecastSource source) {
+  if (source >= SOURCE_COUNT) return 0;
+  const SourceState &s = sources[source];
+  uint32_t age = millis() - s.fetchedAt;
+  return age >= s.freshForMs ? 0 : s.freshForMs - age;
+}
+
+bool sourceStale(ForecastSource source) {
+  return sourceDueInMs(source) == 0;
+}
+
+uint32_t nextForecastUpdateMs() {
+  uint32_t next = FORECAST_REINDEX_INTERVAL_MS;
+  for (int i = 0; i < SOURCE_COUNT; i++) {
+    uint32_t due = sourceDueInMs((ForecastSource)i);
+    if (due < next) next = due;
+  }
+  return next;
+}
+
+void logRefreshSchedule() {
+  LOG_INFO("Refresh schedule: %s in %lum %s in %lum %s in %lum", forecastSourceName(SOURCE_MARINE),
+           sourceDueInMs(SOURCE_MARINE) / 60000UL, forecastSourceName(SOURCE_WIND), sourceDueInMs(SOURCE_WIND) / 60000UL,
+           forecastSourceName(SOURCE_TIDE), sourceDueInMs(SOURCE_TIDE) / 60000UL);
+}
@@ -0,0 +1,285 @@
+#include "SearchCache.h"
+#include "Config.h"
+#include "Storage.h"
+#include "Log.h"
+#include <time.h>
+
+// Both caches live in RAM once loaded, most recently used first, and are
+// rewritten to flash when entries are stored (probe verdicts once per batch).
+// Hits reorder the RAM copy only, so lookups never cost a flash write; the
+// order reaches flash with the next store.
+
+static const uint32_t GEOCODE_CACHE_MAGIC = 0x314F4547;  // "GEO1"
+static const uint32_t PROBE_CACHE_MAGIC = 0x31424F50;    // "POB1"
+static const size_t GEOCODE_CACHE_ENTRIES = 16;
+static const size_t PROBE_CACHE_ENTRIES = 128;
+
+static const uint32_t DAY_S = 24UL * 60UL * 60UL;
+static const uint32_t GEOCODE_TTL_S = 30 * DAY_S;
+static const uint32_t GEOCODE_EMPTY_TTL_S = 3 * DAY_S;   // a place may be added upstream
+static const uint32_t PROBE_HAS_DATA_TTL_S = 30 * DAY_S;
+static const uint32_t PROBE_NO_DATA_TTL_S = 7 * DAY_S;
+
+struct GeocodeEntry {
+  String query;
+  uint32_t storedAt;
+  uint8_t requested;
+  std::vector<LocationInfo> results;
+};
+
+struct ProbeRecord {
+  int16_t lat100;
+  int16_t lon100;
+  uint32_t storedAt;
+  uint8_t hasData;
+  uint8_t reserved[3];
+};
+
+static std::vector<GeocodeEntry> geocodeEntries;
+static bool geocodeLoaded = false;
+static std::vector<ProbeRecord> probeRecords;
+static bool probeLoaded = false;
+static bool probeDirty = false;
+
+// Wall-clock seconds, or 0 before NTP sync (entries then never expire and are
+// stored with unknown age).
+static uint32_t cacheNow() {
+  time_t now = time(nullptr);
+  return now >= 1000000000 ? (uint32_t)now : 0;
+}
+
+static bool expired(uint32_t storedAt, uint32_t ttl) {
+  uint32_t now = cacheNow();
+  if (now == 0) return false;
+  return storedAt == 0 || now - storedAt > ttl;
+}
+
+static String normalizeQuery(const String &query) {
+  String normalized;
+  bool pendingSpace = false;
+  for (unsigned int i = 0; i < query.length(); i++) {
+    char c = query.charAt(i);
+    if (c == ' ' || c == '\t') {
+      pendingSpace = !normalized.isEmpty();
+      continue;
+    }
+    if (pendingSpace) normalized += ' ';
+    pendingSpace = false;
+    normalized += (char)tolower((unsigned char)c);
+  }
+  return normalized;
+}
+
+static bool readBytes(File &f, void *buf, size_t len) {
+  return f.read((uint8_t *)buf, len) == len;
+}
+
+static bool readShortString(File &f, String &out) {
+  uint8_t len = 0;
+  if (!readBytes(f, &len, 1)) return false;
+  char buf[256];
+  if (len > 0 && !readBytes(f, buf, len)) return false;
+  buf[len] = '\0';
+  out = buf;
+  return true;
+}
+
+static void writeShortString(File &f, const String &s) {
+  uint8_t len = (uint8_t)min((unsigned int)s.length(), 255U);
+  f.write(&len, 1);
+  f.write((const uint8_t *)s.c_str(), len);
+}
+
+static void loadGeocodeCache() {
+  geocodeLoaded = true;
+  geocodeEntries.clear();
+  if (!STORAGE_FS.exists(GEOCODE_CACHE_FILE)) return;
+  File f = STORAGE_FS.open(GEOCODE_CACHE_FILE, FILE_READ);
+  if (!f) return;
+
+  uint32_t magic = 0;
+  uint8_t count = 0;
+  if (!readBytes(f, &magic, sizeof(magic)) || magic != GEOCODE_CACHE_MAGIC || !readBytes(f, &count, 1)) {
+    LOG_ERROR("Geocode cache file has unknown format, ignoring.");
+    f.close();
+    return;
+  }
+  for (uint8_t i = 0; i < count && geocodeEntries.size() < GEOCODE_CACHE_ENTRIES; i++) {
+    GeocodeEntry entry;
+    uint8_t resultCount = 0;
+    if (!readShortString(f, entry.query) || !readBytes(f, &entry.storedAt, sizeof(entry.storedAt)) ||
+        !readBytes(f, &entry.requested, 1) || !readBytes(f, &resultCount, 1)) {
+      break;
+    }
+    bool ok = true;
+    for (uint8_t r = 0; r < resultCount && ok; r++) {
+      LocationInfo info;
+      ok = readBytes(f, &info.latitude, sizeof(info.latitude)) &&
+           readBytes(f, &info.longitude, sizeof(info.longitude)) &&
+           readShortString(f, info.displayName);
+      info.valid = ok;
+      if (ok) entry.results.push_back(info);
+    }
+    if (!ok) break;
+    geocodeEntries.push_back(entry);
+  }
+  f.close();
+}
+
+static void saveGeocodeCache() {
+  File f = openReplace(GEOCODE_CACHE_FILE);
+  if (!f) {
+    LOG_ERROR("Failed to open geocode cache file for write.");
+    return;
+  }
+  uint8_t count = (uint8_t)geocodeEntries.size();
+  f.write((const uint8_t *)&GEOCODE_CACHE_MAGIC, sizeof(GEOCODE_CACHE_MAGIC));
+  f.write(&count, 1);
+  for (const GeocodeEntry &entry : geocodeEntries) {
+    uint8_t resultCount = (uint8_t)entry.results.size();
+    writeShortString(f, entry.query);
+    f.write((const uint8_t *)&entry.storedAt, sizeof(entry.storedAt));
+    f.write(&entry.requested, 1);
+    f.write(&resultCount, 1);
+    for (const LocationInfo &info : entry.results) {
+      f.write((const uint8_t *)&info.latitude, sizeof(info.latitude));
+      f.write((const uint8_t *)&info.longitude, sizeof(info.longitude));
+      writeShortString(f, info.displayName);
+    }
+  }
+  commitReplace(f, GEOCODE_CACHE_FILE);
+}
+
+bool lookupGeocodeCache(const String &query, int maxResults, std::vector<LocationInfo> &results) {
+  if (!geocodeLoaded) loadGeocodeCache();
+  String key = normalizeQuery(query);
+  for (size_t i = 0; i < geocodeEntries.size(); i++) {
+    GeocodeEntry &entry = geocodeEntries[i];
+    if (entry.query != key) continue;
+    uint32_t ttl = entry.results.empty() ? GEOCODE_EMPTY_TTL_S : GEOCODE_TTL_S;
+    if (expired(entry.storedAt, ttl)) return false;
+    // A narrower lookup that came back full may have missed results
+    if (entry.requested < maxResults && (int)entry.results.size() >= entry.requested) return false;
+
+    results.assign(entry.results.begin(), entry.results.begin() + min((int)entry.results.size(), maxResults));
+    if (i > 0) {
+      GeocodeEntry hit = entry;
+      geocodeEntries.erase(geocodeEntries.begin() + i);
+      geocodeEntries.insert(geocodeEntries.begin(), hit);
+    }
+    LOG_INFO("Geocode cache hit: \"%s\" (%u results)", key, results.size());
+    return true;
+  }
+  return false;
+}
+
+void storeGeocodeCache(const String &query, int maxResults, const std::vector<LocationInfo> &results) {
+  if (!geocodeLoaded) loadGeocodeCache();
+  GeocodeEntry entry;
+  entry.query = normalizeQuery(query);
+  if (entry.query.isEmpty()) return;
+  entry.storedAt = cacheNow();
+  entry.requested = (uint8_t)min(maxResults, 255);
+  entry.results = results;
+
+  for (size_t i = 0; i < geocodeEntries.size(); i++) {
+    if (geocodeEntries[i].query == entry.query) {
+      geocodeEntries.erase(geocodeEntries.begin() + i);
+      break;
+    }
+  }
+  geocodeEntries.insert(geocodeEntries.begin(), entry);
+  if (geocodeEntries.size() > GEOCODE_CACHE_ENTRIES) geocodeEntries.resize(GEOCODE_CACHE_ENTRIES);
+  saveGeocodeCache();
+}
+
+static void loadProbeCache() {
+  probeLoaded = true;
+  probeRecords.clear();
+  if (!STORAGE_FS.exists(PROBE_CACHE_FILE)) return;
+  File f = STORAGE_FS.open(PROBE_CACHE_FILE, FILE_READ);
+  if (!f) return;
+  uint32_t magic = 0;
+  if (readBytes(f, &magic, sizeof(magic)) && magic == PROBE_CACHE_MAGIC) {
+    ProbeRecord record;
+    while (probeRecords.size() < PROBE_CACHE_ENTRIES && readBytes(f, &record, sizeof(record))) {
+      probeRecords.push_back(record);
+    }
+  } else {
+    LOG_ERROR("Probe cache file has unknown format, ignoring.");
+  }
+  f.close();
+}
+
+static void saveProbeCache() {
+  File f = openReplace(PROBE_CACHE_FILE);
+  if (!f) {
+    LOG_ERROR("Failed to open probe cache file for write.");
+    return;
+  }
+  bool ok = f.write((const uint8_t *)&PROBE_CACHE_MAGIC, sizeof(PROBE_CACHE_MAGIC)) == sizeof(PROBE_CACHE_MAGIC);
+  if (ok && !probeRecords.empty()) {
+    size_t bytes = sizeof(ProbeRecord) * probeRecords.size();
+    ok = f.write((const uint8_t *)probeRecords.data(), bytes) == bytes;
+  }
+  if (!ok) LOG_ERROR("Failed to write probe cache file.");
+  commitReplace(f, PROBE_CACHE_FILE, ok);
+}
+
+static int16_t roundCoord(float value) {
+  return (int16_t)lroundf(value * 100.0f);
+}
+
+int lookupProbeCache(float latitude, float longitude) {
+  if (!probeLoaded) loadProbeCache();
+  int16_t lat100 = roundCoord(latitude);
+  int16_t lon100 = roundCoord(longitude);
+  for (size_t i = 0; i < probeRecords.size(); i++) {
+    const ProbeRecord &r = probeRecords[i];
+    if (r.lat100 != lat100 || r.lon100 != lon100) continue;
+    if (expired(r.storedAt, r.hasData ? PROBE_HAS_DATA_TTL_S : PROBE_NO_DATA_TTL_S)) return -1;
+    ProbeRecord hit = r;
+    if (i > 0) {
+      probeRecords.erase(probeRecords.begin() + i);
+      probeRecords.insert(probeRecords.begin(), hit);
+    }
+    return hit.hasData ? 1 : 0;
+  }
+  return -1;
+}
+
+void storeProbeCache(float latitude, float longitude, bool hasData) {
+  if (!probeLoaded) loadProbeCache();
+  ProbeRecord record = {};
+  record.lat100 = roundCoord(latitude);
+  record.lon100 = roundCoord(longitude);
+  record.storedAt = cacheNow();
+  record.hasData = hasData ? 1 : 0;
+
+  for (size_t i = 0; i < probeRecords.size(); i++) {
+    if (probeRecords[i].lat100 == record.lat100 && probeRecords[i].lon100 == record.lon100) {
+      probeRecords.erase(probeRecords.begin() + i);
+      break;
+    }
+  }
+  probeRecords.insert(probeRecords.begin(), record);
+  if (probeRecords.size() > PROBE_CACHE_ENTRIES) probeRecords.resize(PROBE_CACHE_ENTRIES);
+  probeDirty = true;
+}
+
+void flushProbeCache() {
+  if (!probeDirty) return;
+  saveProbeCache();
+  probeDirty = false;
+}
+
+void clearSearchCache() {
+  geocodeEntries.clear();
+  probeRecords.clear();
+  geocodeLoaded = true;
+  probeLoaded = true;
+  probeDirty = false;
+  if (STORAGE_FS.exists(GEOCODE_CACHE_FILE)) STORAGE_FS.remove(GEOCODE_CACHE_FILE);
+  if (STORAGE_FS.exists(PROBE_CACHE_FILE)) STORAGE_FS.remove(PROBE_CACHE_FILE);
+  LOG_INFO("Cleared location search cache.");
+}
@@ -1,495 +1,913 @@
 #include "Storage.h"
 #include "Config.h"
+#include "Log.h"
 #include <Arduino.h>
-#include <SPIFFS.h>
+#include <SPIFFS.h>  // to move files left by SPIFFS firmware
 #include <ArduinoJson.h>
+#include <algorithm>
+#include <math.h>
+#include <stddef.h>
 #include <time.h>
 #include <vector>
 
-void logInfo(const String &message) { 
-  Serial.printf("[INFO  %10lu ms] %s\n", millis(), message.c_str()); 
+// Every whole-file save goes through openReplace()/commitReplace(): the new
+// contents are written to "<path>.tmp" and renamed over the old file only once
+// they are complete. LittleFS renames over an existing file atomically; SPIFFS
+// has to remove the old file first, so on SPIFFS builds beginStorage() also
+// finishes a replacement cut short between the remove and the rename.
+static const char *REPLACE_SUFFIX = ".tmp";
+static const size_t STORAGE_PATH_MAX = 32;  // SPIFFS name limit, terminator included
+
+// The SPIFFS to LittleFS move holds the old files in RAM across the format
+static const size_t MIGRATE_MAX_BYTES = 96 * 1024;
+static const size_t MIGRATE_HEAP_RESERVE = 32 * 1024;
+
+static bool tempPathFor(const char *path, char *out, size_t size) {
+  int n = snprintf(out, size, "%s%s", path, REPLACE_SUFFIX);
+  return n > 0 && (size_t)n < size;
 }
 
-void logError(const String &message) { 
-  Serial.printf("[ERROR %10lu ms] %s\n", millis(), message.c_str()); 
+static bool isTempPath(const String &path) {
+  return path.endsWith(REPLACE_SUFFIX) && path.length() > strlen(REPLACE_SUFFIX);
 }
 
-bool saveWifiCredentials(const WifiCredentials &creds) {
-  DynamicJsonDocument doc(512);
-  doc["ssid"] = creds.ssid;
-  doc["password"] = creds.password;
+File openReplace(const char *path) {
+  char temp[STORAGE_PATH_MAX];
+  if (!tempPathFor(path, temp, sizeof(temp))) {
+    LOG_ERROR("Path %s is too long to replace.", path);
+    return File();
+  }
+  return STORAGE_FS.open(temp, FILE_WRITE);
+}
 
-  File f = SPIFFS.open(WIFI_FILE, FILE_WRITE);
-  if (!f) {
-    logError("Failed to open wifi file for write.");
+bool commitReplace(File &f, const char *path, bool ok) {
+  char temp[STORAGE_PATH_MAX];
+  if (!tempPathFor(path, temp, sizeof(temp))) return false;
+  f.close();
+  if (!ok) {
+    STORAGE_FS.remove(temp);
     return false;
   }
-  if (serializeJson(doc, f) == 0) {
-    logError("Failed to write wifi file.");
-    f.close();
+#ifdef STORAGE_SPIFFS
+  // Between this remove and the rename the temp file is the only copy
+  if (STORAGE_FS.exists(path)) STORAGE_FS.remove(path);
+#endif
+  if (!STORAGE_FS.rename(temp, path)) {
+    LOG_ERROR("Failed to replace %s.", path);
     return false;
   }
-  f.close();
-  logInfo("Saved Wi-Fi credentials to SPIFFS.");
   return true;
 }
 
-WifiCredentials loadWifiCredentials() {
-  WifiCredentials creds;
-  if (!SPIFFS.exists(WIFI_FILE)) {
-    logInfo("No saved Wi-Fi credentials file.");
-    return creds;
+static std::vector<String> listStorageFiles() {
+  std::vector<String> paths;
+  File root = STORAGE_FS.open("/");
+  if (!root) return paths;
+  for (File f = root.openNextFile(); f; f = root.openNextFile()) {
+    paths.push_back(String(f.path()));
+    f.close();
   }
+  root.close();
+  return paths;
+}
 
-  File f = SPIFFS.open(WIFI_FILE, FILE_READ);
-  if (!f) {
-    logError("Failed to open wifi file for read.");
-    return creds;
+// A temp file left at boot is a replacement that never reached its rename.
+// The old file stands, unless SPIFFS had already removed it: then the temp
+// file was complete and takes its place.
+static void finishReplacements() {
+  for (const String &path : listStorageFiles()) {
+    if (!isTempPath(path)) continue;
+    String target = path.substring(0, path.length() - strlen(REPLACE_SUFFIX));
+#ifdef STORAGE_SPIFFS
+    if (!STORAGE_FS.exists(target) && STORAGE_FS.rename(path, target)) {
+      LOG_INFO("Finished interrupted write of %s.", target);
+      continue;
+    }
+#endif
+    STORAGE_FS.remove(path);
+    LOG_INFO("Dropped interrupted write of %s.", target);
   }
+}
 
-  DynamicJsonDocument doc(512);
-  DeserializationError err = deserializeJson(doc, f);
-  f.close();
-  if (err) {
-    logError("Failed to parse wifi file.");
-    return creds;
+#ifndef STORAGE_SPIFFS
+// Firmware before LittleFS formatted the same partition as SPIFFS. The two
+// cannot share it, so the old files are read into RAM, the partition is
+// formatted as LittleFS and they are written back. Smallest files go first, so
+// if the budget runs out it is history or a cache that is left behind, not the
+// preferences. Returns true once LittleFS is mounted with the files on it.
+static bool migrateFromSpiffs() {
+  if (!SPIFFS.begin(false)) return false;
+
+  struct Entry {
+    String path;
+    size_t size;
+    std::vector<uint8_t> data;
+    bool loaded;
+  };
+  std::vector<Entry> entries;
+  File root = SPIFFS.open("/");
+  for (File f = root.openNextFile(); f; f = root.openNextFile()) {
+    entries.push_back({String(f.path()), (size_t)f.size(), {}, false});
+    f.close();
   }
+  root.close();
+  std::sort(entries.begin(), entries.end(), [](const Entry &a, const Entry &b) { return a.size < b.size; });
 
-  creds.ssid = doc["ssid"] | "";
-  creds.password = doc["password"] | "";
-  creds.valid = !creds.ssid.isEmpty();
-  if (creds.valid) logInfo("Loaded saved Wi-Fi credentials.");
-  return creds;
+  size_t total = 0;
+  for (Entry &e : entries) {
+    if (isTempPath(e.path)) continue;
+    if (total + e.size > MIGRATE_MAX_BYTES || ESP.getMaxAllocHeap() < e.size + MIGRATE_HEAP_RESERVE) {
+      LOG_ERROR("Not migrating %s (%u bytes), out of room.", e.path, e.size);
+      continue;
+    }
+    File f = SPIFFS.open(e.path, FILE_READ);
+    if (!f) continue;
+    e.data.resize(e.size);
+    e.loaded = f.read(e.data.data(), e.size) == e.size;
+    f.close();
+    if (e.loaded) total += e.size;
+    else e.data.clear();
+  }
+  SPIFFS.end();
+
+  if (!LittleFS.begin(true)) return false;
+  int moved = 0;
+  for (const Entry &e : entries) {
+    if (!e.loaded) continue;
+    File f = LittleFS.open(e.path, FILE_WRITE);
+    if (!f) continue;
+    if (f.write(e.data.data(), e.size) == e.size) moved++;
+    f.close();
+  }
+  LOG_INFO("Moved %d of %u files (%u bytes) from SPIFFS to LittleFS.", moved, entries.size(), total);
+  return true;
+}
+#endif
+
+bool beginStorage() {
+#ifdef STORAGE_SPIFFS
+  if (!STORAGE_FS.begin(true)) return false;
+#else
+  if (!LittleFS.begin(false)) {
+    // Not LittleFS yet: move the SPIFFS files over, or format a blank one
+    if (!migrateFromSpiffs() && !LittleFS.begin(true)) return false;
+  }
+#endif
+  finishReplacements();
+  return true;
 }
 
-void deleteWifiCredentials() {
-  if (SPIFFS.exists(WIFI_FILE)) {
-    SPIFFS.remove(WIFI_FILE);
-    logInfo("Deleted saved Wi-Fi credentials.");
-  }
+// Preferences live in one fixed-size binary record. It is read once, on first
+// use, and kept in RAM, so every load*() below is a memory read. A save
+// rewrites the whole record (under 1 KB) to a temp file and renames it into
+// place, so a power cut leaves either the old record or the new one.
+static const uint32_t SETTINGS_MAGIC = 0x31544553;  // "SET1"
+static const uint16_t SETTINGS_VERSION = 1;
+static const uint16_t SETTINGS_MAX_BYTES = 4096;
+static const int SETTINGS_MAX_DEFAULTS = 5;
+
+enum SettingsField : uint32_t {
+  SETTING_WIFI = 1 << 0,
+  SETTING_THEME = 1 << 1,
+  SETTING_WAVE = 1 << 2,
+  SETTING_LOCATION = 1 << 3,
+  SETTING_PLAYER = 1 << 4,
+  SETTING_DEFAULTS = 1 << 5,
+  SETTING_OVERVIEW = 1 << 6,
+};
+
+struct SettingsLocation {
+  char name[64];
+  float latitude;
+  float longitude;
+};
+
+// Fields are only ever appended (with a version bump). A shorter record from
+// older firmware loads with the missing tail zeroed; a longer one from newer
+// firmware loads its known prefix.
+struct SettingsRecord {
+  uint32_t magic;
+  uint16_t version;
+  uint16_t size;    // bytes written, header included
+  uint32_t crc;     // CRC-32 of the size - header bytes that follow
+  uint32_t fields;  // SettingsField bits that hold a saved value
+  char ssid[33];
+  char password[65];
+  uint8_t darkMode;
+  uint8_t overview;
+  float waveThreshold;
+  SettingsLocation location;
+  char playerName[32];
+  uint8_t defaultCount;
+  uint8_t reserved[3];
+  SettingsLocation defaults[SETTINGS_MAX_DEFAULTS];
+};
+
+static const size_t SETTINGS_HEADER_BYTES = offsetof(SettingsRecord, fields);
+
+static SettingsRecord settings;
+static bool settingsLoaded = false;
+
+static uint32_t crc32Update(uint32_t crc, const uint8_t *data, size_t len) {
+  crc = ~crc;
+  while (len--) {
+    crc ^= *data++;
+    for (int bit = 0; bit < 8; bit++) crc = (crc >> 1) ^ (0xEDB88320UL & (0UL - (crc & 1)));
+  }
+  return ~crc;
 }
 
-bool saveThemePreference(bool isDark) {
-  DynamicJsonDocument doc(256);
-  doc["darkMode"] = isDark;
+static void copyField(char *dst, size_t size, const char *src) {
+  strncpy(dst, src ? src : "", size - 1);
+  dst[size - 1] = '\0';
+}
 
-  File f = SPIFFS.open(THEME_FILE, FILE_WRITE);
-  if (!f) {
-    logError("Failed to open theme file for write.");
-    return false;
+static void copyLocation(SettingsLocation &dst, const LocationInfo &src) {
+  copyField(dst.name, sizeof(dst.name), src.displayName.c_str());
+  dst.latitude = src.latitude;
+  dst.longitude = src.longitude;
+}
+
+static LocationInfo toLocationInfo(const SettingsLocation &src) {
+  LocationInfo info;
+  info.displayName = src.name;
+  info.latitude = src.latitude;
+  info.longitude = src.longitude;
+  return info;
+}
+
+static bool readSettingsFile(const char *path, SettingsRecord &out) {
+  if (!STORAGE_FS.exists(path)) return false;
+  File f = STORAGE_FS.open(path, FILE_READ);
+  if (!f) return false;
+
+  SettingsRecord r;
+  memset(&r, 0, sizeof(r));
+  bool ok = f.read((uint8_t *)&r, SETTINGS_HEADER_BYTES) == SETTINGS_HEADER_BYTES && r.magic == SETTINGS_MAGIC &&
+            r.size > SETTINGS_HEADER_BYTES && r.size <= SETTINGS_MAX_BYTES;
+  if (ok) {
+    uint8_t *body = (uint8_t *)&r + SETTINGS_HEADER_BYTES;
+    size_t known = min((size_t)r.size, sizeof(r)) - SETTINGS_HEADER_BYTES;
+    ok = f.read(body, known) == known;
+    uint32_t crc = crc32Update(0, body, known);
+    // Fields this firmware does not know still count towards the CRC
+    uint8_t chunk[32];
+    for (size_t left = r.size - SETTINGS_HEADER_BYTES - known; ok && left > 0;) {
+      size_t n = min(left, sizeof(chunk));
+      ok = f.read(chunk, n) == n;
+      crc = crc32Update(crc, chunk, n);
+      left -= n;
+    }
+    ok = ok && crc == r.crc;
   }
-  if (serializeJson(doc, f) == 0) {
-    logError("Failed to write theme file.");
-    f.close();
+  f.close();
+  if (!ok) {
+    LOG_ERROR("Settings file %s is damaged, ignoring.", path);
     return false;
   }
-  f.close();
-  logInfo("Saved theme preference to SPIFFS.");
+  out = r;
   return true;
 }
 
-bool loadThemePreference() {
-  if (!SPIFFS.exists(THEME_FILE)) {
-    logInfo("No saved theme preference.");
-    return true;  // Default to dark mode
-  }
+static bool writeSettings() {
+  settings.magic = SETTINGS_MAGIC;
+  settings.version = SETTINGS_VERSION;
+  settings.size = sizeof(SettingsRecord);
+  settings.crc = crc32Update(0, (const uint8_t *)&settings + SETTINGS_HEADER_BYTES,
+                             sizeof(SettingsRecord) - SETTINGS_HEADER_BYTES);
 
-  File f = SPIFFS.open(THEME_FILE, FILE_READ);
+  File f = openReplace(SETTINGS_FILE);
   if (!f) {
-    logError("Failed to open theme file for read.");
-    return true;
+    LOG_ERROR("Failed to open settings file for write.");
+    return false;
   }
+  bool ok = f.write((const uint8_t *)&settings, sizeof(settings)) == sizeof(settings);
+  if (!ok) LOG_ERROR("Failed to write settings file.");
+  return commitReplace(f, SETTINGS_FILE, ok);
+}
 
-  DynamicJsonDocument doc(256);
+static bool readLegacyJson(const char *path, JsonDocument &doc) {
+  if (!STORAGE_FS.exists(path)) return false;
+  File f = STORAGE_FS.open(path, FILE_READ);
+  if (!f) return false;
   DeserializationError err = deserializeJson(doc, f);
   f.close();
-  if (err) {
-    logError("Failed to parse theme file.");
-    return true;
+  if (err) LOG_ERROR("Failed to parse %s, not migrating it.", path);
+  return !err;
+}
+
+// Older firmware kept one small JSON file per preference. Copies whichever
+// exist into the RAM record; they are removed once the record is written.
+static void migrateLegacySettings() {
+  DynamicJsonDocument doc(1024);
+  if (readLegacyJson(WIFI_FILE, doc)) {
+    copyField(settings.ssid, sizeof(settings.ssid), doc["ssid"] | "");
+    copyField(settings.password, sizeof(settings.password), doc["password"] | "");
+    settings.fields |= SETTING_WIFI;
+  }
+  if (readLegacyJson(THEME_FILE, doc)) {
+    settings.darkMode = (doc["darkMode"] | true) ? 1 : 0;
+    settings.fields |= SETTING_THEME;
+  }
+  if (readLegacyJson(OVERVIEW_FILE, doc)) {
+    settings.overview = (doc["overview"] | false) ? 1 : 0;
+    settings.fields |= SETTING_OVERVIEW;
+  }
+  if (readLegacyJson(WAVE_PREF_FILE, doc)) {
+    settings.waveThreshold = doc["threshold"] | 1.0f;
+    settings.fields |= SETTING_WAVE;
+  }
+  if (readLegacyJson(LOCATION_FILE, doc)) {
+    copyField(settings.location.name, sizeof(settings.location.name), doc["location"] | "");
+    settings.location.latitude = doc["latitude"] | 0.0f;
+    settings.location.longitude = doc["longitude"] | 0.0f;
+    settings.fields |= SETTING_LOCATION;
+  }
+  if (readLegacyJson(PLAYER_NAME_FILE, doc)) {
+    copyField(settings.playerName, sizeof(settings.playerName), doc["name"] | "");
+    settings.fields |= SETTING_PLAYER;
+  }
+  if (readLegacyJson(DEFAULTS_FILE, doc)) {
+    JsonArray arr = doc["defaults"].as<JsonArray>();
+    for (JsonVariant entry : arr) {
+      if (settings.defaultCount >= SETTINGS_MAX_DEFAULTS) break;
+      SettingsLocation &loc = settings.defaults[settings.defaultCount];
+      copyField(loc.name, sizeof(loc.name), entry["name"] | "");
+      loc.latitude = entry["lat"] | 0.0f;
+      loc.longitude = entry["lon"] | 0.0f;
+      if (loc.name[0] != '\0') settings.defaultCount++;
+    }
+    settings.fields |= SETTING_DEFAULTS;
   }
+}
 
-  bool isDark = doc["darkMode"] | true;
-  logInfo(String("Loaded theme: ") + (isDark ? "dark" : "light"));
-  return isDark;
+static void removeLegacySettings() {
+  const char *paths[] = {WIFI_FILE, THEME_FILE, OVERVIEW_FILE, WAVE_PREF_FILE,
+                         LOCATION_FILE, PLAYER_NAME_FILE, DEFAULTS_FILE};
+  for (const char *path : paths) {
+    if (STORAGE_FS.exists(path)) STORAGE_FS.remove(path);
+  }
 }
 
-void deleteThemePreference() {
-  if (SPIFFS.exists(THEME_FILE)) {
-    SPIFFS.remove(THEME_FILE);
-    logInfo("Deleted saved theme preference.");
+static void loadSettings() {
+  settingsLoaded = true;
+  if (!readSettingsFile(SETTINGS_FILE, settings)) {
+    memset(&settings, 0, sizeof(settings));
+    migrateLegacySettings();
+    // Written even when empty, so later boots find the record and skip this
+    if (writeSettings()) removeLegacySettings();
+    LOG_INFO("Created settings record (fields 0x%02x from legacy files).", settings.fields);
+    return;
   }
+  LOG_INFO("Loaded settings record v%u (fields 0x%02x).", settings.version, settings.fields);
 }
 
-bool saveWaveHeightPreference(float threshold) {
-  DynamicJsonDocument doc(256);
-  doc["threshold"] = threshold;
+bool haveSavedPreferences() {
+  if (!settingsLoaded) loadSettings();
+  return settings.fields & (SETTING_WIFI | SETTING_LOCATION | SETTING_THEME | SETTING_WAVE);
+}
 
-  File f = SPIFFS.open(WAVE_PREF_FILE, FILE_WRITE);
-  if (!f) {
-    logError("Failed to open wave pref file for write.");
-    return false;
-  }
-  if (serializeJson(doc, f) == 0) {
-    logError("Failed to write wave pref file.");
-    f.close();
-    return false;
-  }
-  f.close();
-  logInfo("Saved wave height preference to SPIFFS.");
+bool saveWifiCredentials(const WifiCredentials &creds) {
+  if (!settingsLoaded) loadSettings();
+  copyField(settings.ssid, sizeof(settings.ssid), creds.ssid.c_str());
+  copyField(settings.password, sizeof(settings.password), creds.password.c_str());
+  settings.fields |= SETTING_WIFI;
+  if (!writeSettings()) return false;
+  LOG_INFO("Saved Wi-Fi credentials.");
   return true;
 }
 
-float loadWaveHeightPreference() {
-  if (!SPIFFS.exists(WAVE_PREF_FILE)) {
-    logInfo("No saved wave height preference.");
-    return 1.0f;  // Default
-  }
+WifiCredentials loadWifiCredentials() {
+  if (!settingsLoaded) loadSettings();
+  WifiCredentials creds;
+  if (!(settings.fields & SETTING_WIFI)) return creds;
+  creds.ssid = settings.ssid;
+  creds.password = settings.password;
+  creds.valid = !creds.ssid.isEmpty();
+  return creds;
+}
 
-  File f = SPIFFS.open(WAVE_PREF_FILE, FILE_READ);
-  if (!f) {
-    logError("Failed to open wave pref file for read.");
-    return 1.0f;
-  }
+void deleteWifiCredentials() {
+  if (!settingsLoaded) loadSettings();
+  if (!(settings.fields & SETTING_WIFI)) return;
+  settings.fields &= ~SETTING_WIFI;
+  memset(settings.ssid, 0, sizeof(settings.ssid));
+  memset(settings.password, 0, sizeof(settings.password));
+  writeSettings();
+  LOG_INFO("Deleted saved Wi-Fi credentials.");
+}
 
-  DynamicJsonDocument doc(256);
-  DeserializationError err = deserializeJson(doc, f);
-  f.close();
-  if (err) {
-    logError("Failed to parse wave pref file.");
-    return 1.0f;
-  }
+bool saveThemePreference(bool isDark) {
+  if (!settingsLoaded) loadSettings();
+  if ((settings.fields & SETTING_THEME) && settings.darkMode == isDark) return true;
+  settings.darkMode = isDark ? 1 : 0;
+  settings.fields |= SETTING_THEME;
+  if (!writeSettings()) return false;
+  LOG_INFO("Saved theme preference: %s", isDark ? "dark" : "light");
+  return true;
+}
 
-  float threshold = doc["threshold"] | 1.0f;
-  logInfo(String("Loaded wave threshold: ") + String(threshold, 1));
-  return threshold;
+bool loadThemePreference() {
+  if (!settingsLoaded) loadSettings();
+  if (!(settings.fields & SETTING_THEME)) return true;  // Default to dark mode
+  return settings.darkMode != 0;
 }
 
-void deleteWaveHeightPreference() {
-  if (SPIFFS.exists(WAVE_PREF_FILE)) {
-    SPIFFS.remove(WAVE_PREF_FILE);
-    logInfo("Deleted saved wave height preference.");
-  }
+void deleteThemePreference() {
+  if (!settingsLoaded) loadSettings();
+  if (!(settings.fields & SETTING_THEME)) return;
+  settings.fields &= ~SETTING_THEME;
+  settings.darkMode = 0;
+  writeSettings();
+  LOG_INFO("Deleted saved theme preference.");
 }
 
-bool saveSurfLocation(const LocationInfo &locInfo) {
-  if (!locInfo.valid) return false;
-  
-  DynamicJsonDocument doc(512);
-  doc["location"] = locInfo.displayName;
-  doc["latitude"] = locInfo.latitude;
-  doc["longitude"] = locInfo.longitude;
+bool saveOverviewPreference(bool enabled) {
+  if (!settingsLoaded) loadSettings();
+  if ((settings.fields & SETTING_OVERVIEW) && settings.overview == enabled) return true;
+  settings.overview = enabled ? 1 : 0;
+  settings.fields |= SETTING_OVERVIEW;
+  if (!writeSettings()) return false;
+  LOG_INFO("Saved overview preference: %s", enabled ? "on" : "off");
+  return true;
+}
 
-  File f = SPIFFS.open(LOCATION_FILE, FILE_WRITE);
-  if (!f) {
-    logError("Failed to open location file for write.");
-    return false;
-  }
-  if (serializeJson(doc, f) == 0) {
-    logError("Failed to write location file.");
-    f.close();
-    return false;
-  }
-  f.close();
-  logInfo("Saved surf location to SPIFFS.");
+bool loadOverviewPreference() {
+  if (!settingsLoaded) loadSettings();
+  return (settings.fields & SETTING_OVERVIEW) && settings.overview;
+}
+
+void deleteOverviewPreference() {
+  if (!settingsLoaded) loadSettings();
+  if (!(settings.fields & SETTING_OVERVIEW)) return;
+  settings.fields &= ~SETTING_OVERVIEW;
+  settings.overview = 0;
+  writeSettings();
+  LOG_INFO("Deleted saved overview preference.");
+}
+
+bool saveWaveHeightPreference(float threshold) {
+  if (!settingsLoaded) loadSettings();
+  if ((settings.fields & SETTING_WAVE) && settings.waveThreshold == threshold) return true;
+  settings.waveThreshold = threshold;
+  settings.fields |= SETTING_WAVE;
+  if (!writeSettings()) return false;
+  LOG_INFO("Saved wave height preference: %.1f", threshold);
   return true;
 }
 
-LocationInfo loadSurfLocationInfo() {
-  LocationInfo info;
-  if (!SPIFFS.exists(LOCATION_FILE)) {
-    logInfo("No saved location file.");
-    return info;
-  }
+float loadWaveHeightPreference() {
+  if (!settingsLoaded) loadSettings();
+  if (!(settings.fields & SETTING_WAVE)) return 1.0f;  // Default
+  return settings.waveThreshold;
+}
 
-  File f = SPIFFS.open(LOCATION_FILE, FILE_READ);
-  if (!f) {
-    logError("Failed to open location file for read.");
-    return info;
-  }
+bool haveWaveHeightPreference() {
+  if (!settingsLoaded) loadSettings();
+  return settings.fields & SETTING_WAVE;
+}
 
-  DynamicJsonDocument doc(512);
-  DeserializationError err = deserializeJson(doc, f);
-  f.close();
-  if (err) {
-    logError("Failed to parse location file.");
-    return info;
-  }
+void deleteWaveHeightPreference() {
+  if (!settingsLoaded) loadSettings();
+  if (!(settings.fields & SETTING_WAVE)) return;
+  settings.fields &= ~SETTING_WAVE;
+  settings.waveThreshold = 0.0f;
+  writeSettings();
+  LOG_INFO("Deleted saved wave height preference.");
+}
 
-  info.displayName = doc["location"] | "";
-  info.latitude = doc["latitude"] | 0.0f;
-  info.longitude = doc["longitude"] | 0.0f;
+bool saveSurfLocation(const LocationInfo &locInfo) {
+  if (!locInfo.valid) return false;
+  if (!settingsLoaded) loadSettings();
+  copyLocation(settings.location, locInfo);
+  settings.fields |= SETTING_LOCATION;
+  if (!writeSettings()) return false;
+  LOG_INFO("Saved surf location: %s", locInfo.displayName);
+  return true;
+}
+
+LocationInfo loadSurfLocationInfo() {
+  if (!settingsLoaded) loadSettings();
+  if (!(settings.fields & SETTING_LOCATION)) return LocationInfo();
+  LocationInfo info = toLocationInfo(settings.location);
   info.valid = !info.displayName.isEmpty() && (info.latitude != 0.0f || info.longitude != 0.0f);
-  
-  if (info.valid) {
-    logInfo("Loaded location: " + info.displayName);
-  }
   return info;
 }
 
 void deleteSurfLocation() {
-  if (SPIFFS.exists(LOCATION_FILE)) {
-    SPIFFS.remove(LOCATION_FILE);
-    logInfo("Deleted saved surf location.");
-  }
+  if (!settingsLoaded) loadSettings();
+  if (!(settings.fields & SETTING_LOCATION)) return;
+  settings.fields &= ~SETTING_LOCATION;
+  memset(&settings.location, 0, sizeof(settings.location));
+  writeSettings();
+  LOG_INFO("Deleted saved surf location.");
 }
 
-bool saveTideDirection(float tideHeightOneHourAgo, time_t tideDirectionTimestamp, int currentTideDirection) {
-  DynamicJsonDocument doc(512);
-  doc["tideHeightOneHourAgo"] = tideHeightOneHourAgo;
-  doc["tideDirectionTimestamp"] = (long)tideDirectionTimestamp;
-  
-  // Add human-readable timestamp
-  char timeStr[64];
-  struct tm *timeinfo = localtime(&tideDirectionTimestamp);
-  if (timeinfo != nullptr) {
-    strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", timeinfo);
-    doc["timestampReadable"] = String(timeStr);
-  }
-  
-  doc["currentTideDirection"] = currentTideDirection;
+// The forecast snapshot changes with every refresh but is only read back at
+// boot, where it fills the screen (tide direction and bounds included) until
+// the first fetch. A save updates a pending copy in RAM; flushStateFiles()
+// writes it once its oldest unwritten change is STATE_FLUSH_INTERVAL_MS old,
+// and a shutdown hook writes whatever is left before esp_restart(). Unplugging
+// skips the hook, so the first save after boot and any material change are
+// written at once; only a newer fetch time with the same values waits for the
+// interval. A save that matches what is already pending or on flash costs
+// nothing. Everything here runs on the main loop.
+static const uint32_t STATE_FLUSH_INTERVAL_MS = 2UL * 60UL * 60UL * 1000UL;
+
+struct StateSlot {
+  bool dirty;
+  bool flashed;           // lastSnapshot holds what the file contains
+  bool urgent;            // write at the next flush, not after the interval
+  uint32_t dirtySinceMs;
+  uint32_t saves;
+  uint32_t writes;
+};
+
+struct SnapshotState {
+  LocationInfo location;
+  SurfForecast forecast;
+  time_t fetchedAt;
+};
+
+static StateSlot snapshotSlot;
+static SnapshotState pendingSnapshot, lastSnapshot;
+static bool shutdownHookRegistered = false;
+
+static void flushStateFilesOnShutdown() {
+  flushStateFiles(true);
+}
 
-  File f = SPIFFS.open(TIDE_DIRECTION_FILE, FILE_WRITE);
-  if (!f) {
-    logError("Failed to open tide direction file for write.");
-    return false;
+static bool writeSnapshotFile(const SnapshotState &state);
+
+void flushStateFiles(bool force) {
+  if (!shutdownHookRegistered) {
+    shutdownHookRegistered = true;
+    esp_register_shutdown_handler(flushStateFilesOnShutdown);
   }
-  if (serializeJson(doc, f) == 0) {
-    logError("Failed to write tide direction file.");
-    f.close();
-    return false;
+  StateSlot &slot = snapshotSlot;
+  if (!slot.dirty || (!force && !slot.urgent && millis() - slot.dirtySinceMs < STATE_FLUSH_INTERVAL_MS)) return;
+  slot.urgent = false;
+  if (!writeSnapshotFile(pendingSnapshot)) {
+    // Retry after another interval
+    slot.dirtySinceMs = millis();
+    return;
   }
-  f.close();
-  logInfo("Saved tide direction to SPIFFS.");
-  return true;
+  lastSnapshot = pendingSnapshot;
+  slot.dirty = false;
+  slot.flashed = true;
+  slot.writes++;
+  LOG_INFO("Flushed forecast snapshot.");
 }
 
-void loadTideDirection(float &tideHeightOneHourAgo, time_t &tideDirectionTimestamp, int &currentTideDirection) {
-  tideHeightOneHourAgo = 0.0f;
-  tideDirectionTimestamp = 0;
-  currentTideDirection = 0;
+int copyStateFileStats(StateFileStats *out, int max) {
+  if (max < 1) return 0;
+  out[0].path = FORECAST_SNAPSHOT_FILE;
+  out[0].saves = snapshotSlot.saves;
+  out[0].writes = snapshotSlot.writes;
+  out[0].dirty = snapshotSlot.dirty;
+  return 1;
+}
 
-  if (!SPIFFS.exists(TIDE_DIRECTION_FILE)) {
-    logInfo("No saved tide direction.");
-    return;
+// Tide direction and bounds now come from the prediction curve and the
+// snapshot; this only clears the files older firmware kept for them.
+void deleteLegacyTideFiles() {
+  const char *paths[] = {TIDE_DIRECTION_FILE, TIDE_BOUNDS_FILE, TIDE_HOURLY_FILE};
+  for (const char *path : paths) {
+    if (!STORAGE_FS.exists(path)) continue;
+    STORAGE_FS.remove(path);
+    LOG_INFO("Deleted legacy tide file %s", path);
   }
+}
 
-  File f = SPIFFS.open(TIDE_DIRECTION_FILE, FILE_READ);
-  if (!f) {
-    logError("Failed to open tide direction file for read.");
-    return;
+// Tide prediction series: fixed-size binary records so a refresh can read the
+// week's highs and lows without any JSON parsing. Holds the current blend stations.
+static const uint32_t TIDE_SERIES_MAGIC = 0x32525354;  // "TSR2"
+static const int TIDE_SERIES_SLOTS = 3;
+
+struct TideSeriesRecord {
+  char stationId[10];
+  uint32_t start;
+  uint8_t count;
+  uint8_t reserved;
+  uint16_t minute[TIDE_SERIES_EVENTS];
+  int16_t heightMm[TIDE_SERIES_EVENTS];
+};
+
+static int readTideSeriesRecords(TideSeriesRecord records[TIDE_SERIES_SLOTS]) {
+  if (!STORAGE_FS.exists(TIDE_SERIES_FILE)) return 0;
+  File f = STORAGE_FS.open(TIDE_SERIES_FILE, FILE_READ);
+  if (!f) return 0;
+  uint32_t magic = 0;
+  int n = 0;
+  if (f.read((uint8_t *)&magic, sizeof(magic)) == sizeof(magic) && magic == TIDE_SERIES_MAGIC) {
+    while (n < TIDE_SERIES_SLOTS &&
+           f.read((uint8_t *)&records[n], sizeof(TideSeriesRecord)) == sizeof(TideSeriesRecord)) {
+      n++;
+    }
+  } else {
+    LOG_ERROR("Tide series file has unknown format, ignoring.");
   }
-
-  DynamicJsonDocument doc(512);
-  DeserializationError err = deserializeJson(doc, f);
   f.close();
-  if (err) {
-    logError("Failed to parse tide direction file.");
-    return;
-  }
-
-  tideHeightOneHourAgo = doc["tideHeightOneHourAgo"] | 0.0f;
-  tideDirectionTimestamp = doc["tideDirectionTimestamp"] | 0L;
-  currentTideDirection = doc["currentTideDirection"] | 0;
-  
-  // Log with human-readable timestamp if available
-  String readableTime = doc["timestampReadable"] | String("unknown");
-  logInfo(String("Loaded tide direction: ") + String(currentTideDirection) + " (last update: " + readableTime + ")");
+  return n;
 }
 
-void deleteTideDirection() {
-  if (SPIFFS.exists(TIDE_DIRECTION_FILE)) {
-    SPIFFS.remove(TIDE_DIRECTION_FILE);
-    logInfo("Deleted saved tide direction.");
+bool saveTideSeries(const TideSeries &series) {
+  TideSeriesRecord records[TIDE_SERIES_SLOTS];
+  int n = readTideSeriesRecords(records);
+
+  // Replace this station's record, else fill a free slot, else the oldest day
+  int slot = -1;
+  for (int i = 0; i < n; i++) {
+    if (strncmp(records[i].stationId, series.stationId, sizeof(records[i].stationId)) == 0) { slot = i; break; }
+  }
+  if (slot < 0 && n < TIDE_SERIES_SLOTS) slot = n++;
+  if (slot < 0) {
+    slot = 0;
+    for (int i = 1; i < n; i++) if (records[i].start < records[slot].start) slot = i;
   }
-}
 
-// Tide bounds storage (daily min/max)
-bool saveTideBounds(float minTide, float maxTide, const String &date) {
-  DynamicJsonDocument doc(512);
-  doc["minTide"] = minTide;
-  doc["maxTide"] = maxTide;
-  doc["date"] = date;
+  TideSeriesRecord &r = records[slot];
+  memset(&r, 0, sizeof(r));
+  strncpy(r.stationId, series.stationId, sizeof(r.stationId) - 1);
+  r.start = series.start;
+  r.count = series.count;
+  memcpy(r.minute, series.minute, sizeof(r.minute));
+  memcpy(r.heightMm, series.heightMm, sizeof(r.heightMm));
 
-  File f = SPIFFS.open(TIDE_BOUNDS_FILE, FILE_WRITE);
+  File f = openReplace(TIDE_SERIES_FILE);
   if (!f) {
-    logError("Failed to open tide bounds file for write.");
+    LOG_ERROR("Failed to open tide series file for write.");
     return false;
   }
-  if (serializeJson(doc, f) == 0) {
-    logError("Failed to write tide bounds file.");
-    f.close();
-    return false;
+  bool ok = f.write((const uint8_t *)&TIDE_SERIES_MAGIC, sizeof(TIDE_SERIES_MAGIC)) == sizeof(TIDE_SERIES_MAGIC) &&
+            f.write((const uint8_t *)records, sizeof(TideSeriesRecord) * n) == sizeof(TideSeriesRecord) * n;
+  if (!ok) LOG_ERROR("Failed to write tide series file.");
+  if (!commitReplace(f, TIDE_SERIES_FILE, ok)) return false;
+  LOG_INFO("Saved tide series for station %s (%d highs and lows)", series.stationId, series.count);
+  return true;
+}
+
+bool loadTideSeries(const char *stationId, TideSeries &series) {
+  series = TideSeries();
+  TideSeriesRecord records[TIDE_SERIES_SLOTS];
+  int n = readTideSeriesRecords(records);
+  for (int i = 0; i < n; i++) {
+    if (strncmp(records[i].stationId, stationId, sizeof(records[i].stationId)) != 0) continue;
+    strncpy(series.stationId, records[i].stationId, sizeof(series.stationId) - 1);
+    series.start = records[i].start;
+    series.count = min((int)records[i].count, TIDE_SERIES_EVENTS);
+    memcpy(series.minute, records[i].minute, sizeof(series.minute));
+    memcpy(series.heightMm, records[i].heightMm, sizeof(series.heightMm));
+    series.valid = series.count >= 2;
+    return series.valid;
+  }
+  return false;
+}
+
+void deleteTideSeries() {
+  if (STORAGE_FS.exists(TIDE_SERIES_FILE)) {
+    STORAGE_FS.remove(TIDE_SERIES_FILE);
+    LOG_INFO("Deleted saved tide series.");
+  }
+}
+
+// Tide harmonic constants: provisioned once per station and kept indefinitely,
+// so the predictor can run offline. Oldest-written station is evicted first.
+static const uint32_t TIDE_HARMONICS_MAGIC = 0x31434854;  // "THC1"
+static const int TIDE_HARMONICS_SLOTS = 6;
+
+struct TideHarmonicsRecord {
+  char stationId[10];
+  int16_t mslMm;
+  uint8_t count;
+  uint8_t reserved;
+  TideConstituent constituents[TIDE_MAX_CONSTITUENTS];
+};
+
+static int readTideHarmonicsRecords(TideHarmonicsRecord records[TIDE_HARMONICS_SLOTS]) {
+  if (!STORAGE_FS.exists(TIDE_HARMONICS_FILE)) return 0;
+  File f = STORAGE_FS.open(TIDE_HARMONICS_FILE, FILE_READ);
+  if (!f) return 0;
+  uint32_t magic = 0;
+  int n = 0;
+  if (f.read((uint8_t *)&magic, sizeof(magic)) == sizeof(magic) && magic == TIDE_HARMONICS_MAGIC) {
+    while (n < TIDE_HARMONICS_SLOTS &&
+           f.read((uint8_t *)&records[n], sizeof(TideHarmonicsRecord)) == sizeof(TideHarmonicsRecord)) {
+      n++;
+    }
+  } else {
+    LOG_ERROR("Tide harmonics file has unknown format, ignoring.");
   }
   f.close();
-  logInfo("Saved tide bounds: min=" + String(minTide, 2) + "m, max=" + String(maxTide, 2) + "m, date=" + date);
-  return true;
+  return n;
 }
 
-bool loadTideBounds(float &minTide, float &maxTide, String &date) {
-  minTide = 0.0f;
-  maxTide = 0.0f;
-  date = "";
+bool saveTideHarmonics(const TideHarmonics &harmonics) {
+  TideHarmonicsRecord records[TIDE_HARMONICS_SLOTS];
+  int n = readTideHarmonicsRecords(records);
 
-  if (!SPIFFS.exists(TIDE_BOUNDS_FILE)) {
-    logInfo("No saved tide bounds.");
-    return false;
+  int slot = -1;
+  for (int i = 0; i < n; i++) {
+    if (strncmp(records[i].stationId, harmonics.stationId, sizeof(records[i].stationId)) == 0) { slot = i; break; }
   }
+  if (slot < 0 && n < TIDE_HARMONICS_SLOTS) slot = n++;
+  if (slot < 0) {
+    memmove(&records[0], &records[1], sizeof(TideHarmonicsRecord) * (TIDE_HARMONICS_SLOTS - 1));
+    slot = TIDE_HARMONICS_SLOTS - 1;
+  }
+
+  TideHarmonicsRecord &r = records[slot];
+  r = TideHarmonicsRecord();
+  strncpy(r.stationId, harmonics.stationId, sizeof(r.stationId) - 1);
+  r.mslMm = harmonics.mslMm;
+  r.count = harmonics.count;
+  memcpy(r.constituents, harmonics.constituents, sizeof(r.constituents));
 
-  File f = SPIFFS.open(TIDE_BOUNDS_FILE, FILE_READ);
+  File f = openReplace(TIDE_HARMONICS_FILE);
   if (!f) {
-    logError("Failed to open tide bounds file for read.");
+    LOG_ERROR("Failed to open tide harmonics file for write.");
     return false;
   }
+  bool ok = f.write((const uint8_t *)&TIDE_HARMONICS_MAGIC, sizeof(TIDE_HARMONICS_MAGIC)) == sizeof(TIDE_HARMONICS_MAGIC) &&
+            f.write((const uint8_t *)records, sizeof(TideHarmonicsRecord) * n) == sizeof(TideHarmonicsRecord) * n;
+  if (!ok) LOG_ERROR("Failed to write tide harmonics file.");
+  if (!commitReplace(f, TIDE_HARMONICS_FILE, ok)) return false;
+  LOG_INFO("Saved tide harmonics for station %s (%d constituents)", harmonics.stationId, harmonics.count);
+  return true;
+}
 
-  DynamicJsonDocument doc(512);
-  DeserializationError err = deserializeJson(doc, f);
-  f.close();
-  if (err) {
-    logError("Failed to parse tide bounds file.");
-    return false;
+bool loadTideHarmonics(const char *stationId, TideHarmonics &harmonics) {
+  harmonics = TideHarmonics();
+  TideHarmonicsRecord records[TIDE_HARMONICS_SLOTS];
+  int n = readTideHarmonicsRecords(records);
+  for (int i = 0; i < n; i++) {
+    if (strncmp(records[i].stationId, stationId, sizeof(records[i].stationId)) != 0) continue;
+    strncpy(harmonics.stationId, records[i].stationId, sizeof(harmonics.stationId) - 1);
+    harmonics.mslMm = records[i].mslMm;
+    harmonics.count = min((int)records[i].count, TIDE_MAX_CONSTITUENTS);
+    memcpy(harmonics.constituents, records[i].constituents, sizeof(harmonics.constituents));
+    harmonics.valid = true;
+    return true;
   }
-
-  minTide = doc["minTide"] | 0.0f;
-  maxTide = doc["maxTide"] | 0.0f;
-  date = doc["date"] | String("");
-  
-  logInfo("Loaded tide bounds: min=" + String(minTide, 2) + "m, max=" + String(maxTide, 2) + "m, date=" + date);
-  return true;
+  return false;
 }
 
-void deleteTideBounds() {
-  if (SPIFFS.exists(TIDE_BOUNDS_FILE)) {
-    SPIFFS.remove(TIDE_BOUNDS_FILE);
-    logInfo("Deleted saved tide bounds.");
+void deleteTideHarmonics() {
+  if (STORAGE_FS.exists(TIDE_HARMONICS_FILE)) {
+    STORAGE_FS.remove(TIDE_HARMONICS_FILE);
+    LOG_INFO("Deleted saved tide harmonics.");
   }
 }
 
-// Hourly tide tracking storage
-bool saveTideHourlyCheck(float startHeight, time_t startTime, int hour) {
-  DynamicJsonDocument doc(512);
-  doc["startHeight"] = startHeight;
-  doc["startTime"] = (long)startTime;
-  doc["hour"] = hour;
+// Whether the boot screen would show something noticeably different. The tide
+// moves steadily, so it counts past 10 cm; the fetch time never counts alone.
+static bool snapshotChanged(const SnapshotState &a, const LocationInfo &location, const SurfForecast &forecast) {
+  const SurfForecast &f = a.forecast;
+  return a.location.displayName != location.displayName || a.location.latitude != location.latitude ||
+         a.location.longitude != location.longitude || fabsf(f.waveHeight - forecast.waveHeight) >= 0.1f ||
+         fabsf(f.wavePeriod - forecast.wavePeriod) >= 1.0f || fabsf(f.waveDirection - forecast.waveDirection) >= 10.0f ||
+         fabsf(f.windSpeed - forecast.windSpeed) >= 1.0f || fabsf(f.windDirection - forecast.windDirection) >= 10.0f ||
+         fabsf(f.tideHeight - forecast.tideHeight) >= 0.1f || fabsf(f.minTide - forecast.minTide) >= 0.1f ||
+         fabsf(f.maxTide - forecast.maxTide) >= 0.1f;
+}
 
-  char timeStr[64];
-  struct tm *timeinfo = localtime(&startTime);
-  if (timeinfo != nullptr) {
-    strftime(timeStr, sizeof(timeStr), "%Y-%m-%d %H:%M:%S", timeinfo);
-    doc["timeReadable"] = String(timeStr);
-  }
+bool saveForecastSnapshot(const LocationInfo &location, const SurfForecast &forecast, time_t fetchedAt) {
+  if (!location.valid || !forecast.valid) return false;
+  StateSlot &slot = snapshotSlot;
+  bool urgent = !slot.flashed || snapshotChanged(lastSnapshot, location, forecast);
+  bool unchanged = slot.flashed && !urgent && fetchedAt == lastSnapshot.fetchedAt;
+
+  pendingSnapshot.location = location;
+  pendingSnapshot.forecast = forecast;
+  pendingSnapshot.fetchedAt = fetchedAt;
+  slot.saves++;
+  if (unchanged) return true;
+  if (!slot.dirty) slot.dirtySinceMs = millis();
+  slot.dirty = true;
+  slot.urgent = slot.urgent || urgent;
+  return true;
+}
 
-  File f = SPIFFS.open(TIDE_HOURLY_FILE, FILE_WRITE);
+static bool writeSnapshotFile(const SnapshotState &state) {
+  const LocationInfo &location = state.location;
+  const SurfForecast &forecast = state.forecast;
+  DynamicJsonDocument doc(768);
+  doc["location"] = location.displayName;
+  doc["latitude"] = location.latitude;
+  doc["longitude"] = location.longitude;
+  doc["fetchedAt"] = (uint32_t)state.fetchedAt;
+  doc["waveHeight"] = forecast.waveHeight;
+  doc["wavePeriod"] = forecast.wavePeriod;
+  doc["waveDirection"] = forecast.waveDirection;
+  doc["windSpeed"] = forecast.windSpeed;
+  doc["windDirection"] = forecast.windDirection;
+  doc["tideHeight"] = forecast.tideHeight;
+  doc["tideRate"] = forecast.tideRate;
+  doc["minTide"] = forecast.minTide;
+  doc["maxTide"] = forecast.maxTide;
+  doc["timeLabel"] = forecast.timeLabel;
+
+  File f = openReplace(FORECAST_SNAPSHOT_FILE);
   if (!f) {
-    logError("Failed to open tide hourly file for write.");
+    LOG_ERROR("Failed to open forecast snapshot file for write.");
     return false;
   }
   if (serializeJson(doc, f) == 0) {
-    logError("Failed to write tide hourly file.");
-    f.close();
+    LOG_ERROR("Failed to write forecast snapshot file.");
+    commitReplace(f, FORECAST_SNAPSHOT_FILE, false);
     return false;
   }
-  f.close();
-  logInfo("Saved tide hourly check to SPIFFS.");
-  return true;
+  return commitReplace(f, FORECAST_SNAPSHOT_FILE);
 }
 
-bool loadTideHourlyCheck(float &startHeight, time_t &startTime, int &hour) {
-  startHeight = 0.0f;
-  startTime = 0;
-  hour = -1;
-
-  if (!SPIFFS.exists(TIDE_HOURLY_FILE)) {
-    logInfo("No saved tide hourly check.");
-    return false;
+bool loadForecastSnapshot(LocationInfo &location, SurfForecast &forecast, time_t &fetchedAt) {
+  location = LocationInfo();
+  forecast = SurfForecast();
+  fetchedAt = 0;
+  if (snapshotSlot.dirty) {
+    location = pendingSnapshot.location;
+    forecast = pendingSnapshot.forecast;
+    fetchedAt = pendingSnapshot.fetchedAt;
+    return true;
   }
+  if (!STORAGE_FS.exists(FORECAST_SNAPSHOT_FILE)) return false;
 
-  File f = SPIFFS.open(TIDE_HOURLY_FILE, FILE_READ);
+  File f = STORAGE_FS.open(FORECAST_SNAPSHOT_FILE, FILE_READ);
   if (!f) {
-    logError("Failed to open tide hourly file for read.");
+    LOG_ERROR("Failed to open forecast snapshot file for read.");
     return false;
   }
-
-  DynamicJsonDocument doc(512);
+  DynamicJsonDocument doc(768);
   DeserializationError err = deserializeJson(doc, f);
   f.close();
   if (err) {
-    logError("Failed to parse tide hourly file.");
+    LOG_ERROR("Failed to parse forecast snapshot file.");
     return false;
   }
 
-  startHeight = doc["startHeight"] | 0.0f;
-  startTime = doc["startTime"] | 0L;
-  hour = doc["hour"] | -1;
-
-  String readableTime = doc["timeReadable"] | String("unknown");
-  logInfo("Loaded tide hourly check: hour=" + String(hour) + ", height=" + String(startHeight, 2) + " (at: " + readableTime + ")");
-  return true;
+  location.displayName = doc["location"] | "";
+  location.latitude = doc["latitude"] | 0.0f;
+  location.longitude = doc["longitude"] | 0.0f;
+  location.valid = !location.displayName.isEmpty() && (location.latitude != 0.0f || location.longitude != 0.0f);
+  fetchedAt = (time_t)(doc["fetchedAt"] | (uint32_t)0);
+  forecast.waveHeight = doc["waveHeight"] | 0.0f;
+  forecast.wavePeriod = doc["wavePeriod"] | 0.0f;
+  forecast.waveDirection = doc["waveDirection"] | 0.0f;
+  forecast.windSpeed = doc["windSpeed"] | 0.0f;
+  forecast.windDirection = doc["windDirection"] | 0.0f;
+  forecast.tideHeight = doc["tideHeight"] | 0.0f;
+  forecast.tideRate = doc["tideRate"] | 0.0f;
+  forecast.minTide = doc["minTide"] | 0.0f;
+  forecast.maxTide = doc["maxTide"] | 0.0f;
+  forecast.timeLabel = doc["timeLabel"] | "";
+  forecast.valid = location.valid;
+  if (forecast.valid) LOG_INFO("Loaded forecast snapshot for %s", location.displayName);
+  return forecast.valid;
 }
 
-void deleteTideHourlyCheck() {
-  if (SPIFFS.exists(TIDE_HOURLY_FILE)) {
-    SPIFFS.remove(TIDE_HOURLY_FILE);
-    logInfo("Deleted saved tide hourly check.");
+void deleteForecastSnapshot() {
+  snapshotSlot.dirty = false;
+  snapshotSlot.flashed = false;
+  snapshotSlot.urgent = false;
+  if (STORAGE_FS.exists(FORECAST_SNAPSHOT_FILE)) {
+    STORAGE_FS.remove(FORECAST_SNAPSHOT_FILE);
+    LOG_INFO("Deleted saved forecast snapshot.");
   }
 }
 
 bool savePlayerName(const String &name) {
-  DynamicJsonDocument doc(128);
-  doc["name"] = name;
-
-  File f = SPIFFS.open(PLAYER_NAME_FILE, FILE_WRITE);
-  if (!f) {
-    logError("Failed to open player name file for write.");
-    return false;
-  }
-  if (serializeJson(doc, f) == 0) {
-    logError("Failed to write player name file.");
-    f.close();
-    return false;
-  }
-  f.close();
-  logInfo("Saved player name: " + name);
+  if (!settingsLoaded) loadSettings();
+  copyField(settings.playerName, sizeof(settings.playerName), name.c_str());
+  settings.fields |= SETTING_PLAYER;
+  if (!writeSettings()) return false;
+  LOG_INFO("Saved player name: %s", name);
   return true;
 }
 
 String loadPlayerName() {
-  if (!SPIFFS.exists(PLAYER_NAME_FILE)) return "";
-
-  File f = SPIFFS.open(PLAYER_NAME_FILE, FILE_READ);
-  if (!f) return "";
-
-  DynamicJsonDocument doc(128);
-  DeserializationError err = deserializeJson(doc, f);
-  f.close();
-  if (err) return "";
-
-  String name = doc["name"] | "";
-  logInfo("Loaded player name: " + name);
-  return name;
+  if (!settingsLoaded) loadSettings();
+  if (!(settings.fields & SETTING_PLAYER)) return "";
+  return String(settings.playerName);
 }
 
 bool saveDefaultLocations(const std::vector<LocationInfo> &defaults) {
-  DynamicJsonDocument doc(1024);
-  JsonArray arr = doc.createNestedArray("defaults");
+  if (!settingsLoaded) loadSettings();
+  memset(settings.defaults, 0, sizeof(settings.defaults));
+  settings.defaultCount = 0;
   for (const auto &loc : defaults) {
-    JsonObject obj = arr.createNestedObject();
-    obj["name"] = loc.displayName;
-    obj["lat"]  = loc.latitude;
-    obj["lon"]  = loc.longitude;
+    if (settings.defaultCount >= SETTINGS_MAX_DEFAULTS) break;
+    copyLocation(settings.defaults[settings.defaultCount++], loc);
   }
-  File f = SPIFFS.open(DEFAULTS_FILE, FILE_WRITE);
-  if (!f) { logError("Failed to open defaults file for write."); return false; }
-  if (serializeJson(doc, f) == 0) {
-    logError("Failed to write defaults file."); f.close(); return false;
-  }
-  f.close();
-  logInfo("Saved " + String(defaults.size()) + " default locations.");
+  settings.fields |= SETTING_DEFAULTS;
+  if (!writeSettings()) return false;
+  LOG_INFO("Saved %u default locations.", settings.defaultCount);
   return true;
 }
 
 std::vector<LocationInfo> loadDefaultLocations() {
+  if (!settingsLoaded) loadSettings();
   std::vector<LocationInfo> defaults;
-  if (!SPIFFS.exists(DEFAULTS_FILE)) {
+  if (!(settings.fields & SETTING_DEFAULTS)) {
     // Seed from hardcoded defaults (treated as oldest)
     LocationInfo loc1; loc1.displayName = DEFAULT_LOCATION_1_NAME;
     loc1.latitude = DEFAULT_LOCATION_1_LAT; loc1.longitude = DEFAULT_LOCATION_1_LON; loc1.valid = true;
@@ -498,28 +916,14 @@ std::vector<LocationInfo> loadDefaultLocations() {
     defaults.push_back(loc1);
     defaults.push_back(loc2);
     saveDefaultLocations(defaults);
-    logInfo("Seeded default locations from hardcoded values.");
+    LOG_INFO("Seeded default locations from hardcoded values.");
     return defaults;
   }
-  File f = SPIFFS.open(DEFAULTS_FILE, FILE_READ);
-  if (!f) { logError("Failed to open defaults file for read."); return defaults; }
-  DynamicJsonDocument doc(1024);
-  DeserializationError err = deserializeJson(doc, f);
-  f.close();
-  if (err) { logError("Failed to parse defaults file."); return defaults; }
-  JsonArray arr = doc["defaults"].as<JsonArray>();
-  if (!arr.isNull()) {
-    for (JsonVariant entry : arr) {
-      if (defaults.size() >= 5) break;
-      LocationInfo loc;
-      loc.displayName = entry["name"] | "";
-      loc.latitude    = entry["lat"]  | 0.0f;
-      loc.longitude   = entry["lon"]  | 0.0f;
-      loc.valid = !loc.displayName.isEmpty();
-      if (loc.valid) defaults.push_back(loc);
-    }
+  for (int i = 0; i < settings.defaultCount && i < SETTINGS_MAX_DEFAULTS; i++) {
+    LocationInfo loc = toLocationInfo(settings.defaults[i]);
+    loc.valid = !loc.displayName.isEmpty();
+    if (loc.valid) defaults.push_back(loc);
   }
-  logInfo("Loaded " + String(defaults.size()) + " default locations.");
   return defaults;
 }
 
@@ -528,19 +932,22 @@ void addToDefaultLocations(const LocationInfo &loc) {
   std::vector<LocationInfo> defaults = loadDefaultLocations();
   for (const auto &d : defaults) {
     if (d.displayName == loc.displayName) {
-      logInfo("Default already exists: " + loc.displayName);
+      LOG_INFO("Default already exists: %s", loc.displayName);
       return;
     }
   }
   if (defaults.size() >= 5) defaults.erase(defaults.begin());
   defaults.push_back(loc);
   saveDefaultLocations(defaults);
-  logInfo("Added to defaults: " + loc.displayName);
+  LOG_INFO("Added to defaults: %s", loc.displayName);
 }
 
 void deleteDefaultLocations() {
-  if (SPIFFS.exists(DEFAULTS_FILE)) {
-    SPIFFS.remove(DEFAULTS_FILE);
-    logInfo("Deleted default locations file.");
-  }
+  if (!settingsLoaded) loadSettings();
+  if (!(settings.fields & SETTING_DEFAULTS)) return;
+  settings.fields &= ~SETTING_DEFAULTS;
+  settings.defaultCount = 0;
+  memset(settings.defaults, 0, sizeof(settings.defaults));
+  writeSettings();
+  LOG_INFO("Deleted default locations.");
 }
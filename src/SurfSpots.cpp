@@ -0,0 +1,339 @@
+#include "SurfSpots.h"
+#include <algorithm>
+#include <ctype.h>
+#include <string.h>
+#include <math.h>
+
+// Catalog of well-known breaks, kept in rodata (flash) and sorted by name.
+//
+// stations/distDeciKm are precomputed against TIDE_STATION_POINTS with the
+// same rules findNearestTideStation() applies at runtime: up to three distinct
+// stations within 400 km, secondaries within 3x the nearest distance. Entries
+// refer to the point table by index, so regenerate them whenever either table
+// changes. Spots outside NOAA coverage have stationCount 0.
+
+struct SurfSpot {
+  const char *name;
+  float lat;
+  float lon;
+  uint8_t stationCount;
+  uint16_t stations[3];     // indices into TIDE_STATION_POINTS
+  uint16_t distDeciKm[3];   // distance to each station, 0.1 km
+};
+
+static const SurfSpot SURF_SPOTS[] = {
+  {"Agate Beach, Oregon",                     44.6650f, -124.0600f, 1, {231,   0,   0}, {   45,     0,     0}},
+  {"Ala Moana Bowls, Hawaii",                 21.2870f, -157.8530f, 1, { 36,   0,   0}, {   27,     0,     0}},
+  {"Anchor Point, Morocco",                   30.5450f,   -9.7250f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Banyans, Hawaii",                         19.6030f, -155.9770f, 2, { 27,  29,   0}, {  168,   494,     0}},
+  {"Bells Beach, Australia",                 -38.3710f,  144.2820f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Belmar, New Jersey",                      40.1780f,  -74.0140f, 1, {162,   0,   0}, {   40,     0,     0}},
+  {"Biarritz, France",                        43.4830f,   -1.5600f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Blacks Beach, California",                32.8890f, -117.2530f, 1, { 99,   0,   0}, {   25,     0,     0}},
+  {"Bondi Beach, Australia",                 -33.8910f,  151.2770f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Bundoran, Ireland",                       54.4780f,   -8.2830f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Burleigh Heads, Australia",              -28.0890f,  153.4550f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"C Street, California",                    34.2740f, -119.3000f, 3, {109, 112, 113}, {  351,   386,   690}},
+  {"Cape Hatteras Lighthouse, North Carolina",   35.2500f,  -75.5260f, 1, {119,   0,   0}, {  163,     0,     0}},
+  {"Casino Pier, New Jersey",                 39.9430f,  -74.0700f, 1, {160,   0,   0}, {   15,     0,     0}},
+  {"Chicama, Peru",                           -7.7010f,  -79.4470f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Cloud 9, Philippines",                     9.8040f,  126.1670f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Cloudbreak, Fiji",                       -17.8970f,  177.1880f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Coast Guard Beach, Massachusetts",        41.8320f,  -69.9480f, 3, {189, 185, 172}, {  352,   564,   622}},
+  {"Cocoa Beach Pier, Florida",               28.3680f,  -80.6010f, 1, { 59,   0,   0}, {  104,     0,     0}},
+  {"Cox Bay, Canada",                         49.1000f, -125.8800f, 3, {256, 253, 255}, { 1232,  1610,  2097}},
+  {"Ditch Plains, New York",                  41.0400f,  -71.9150f, 1, {169,   0,   0}, {   51,     0,     0}},
+  {"Domes, Puerto Rico",                      18.3660f,  -67.2700f, 2, { 21,  16,   0}, {  140,   206,     0}},
+  {"El Porto, California",                    33.9000f, -118.4210f, 2, {108, 110,   0}, {   68,   139,     0}},
+  {"Ericeira, Portugal",                      38.9880f,   -9.4200f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Fernandina Beach, Florida",               30.6700f,  -81.4300f, 1, { 92,   0,   0}, {   34,     0,     0}},
+  {"Fistral Beach, England",                  50.4170f,   -5.1000f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Flagler Beach Pier, Florida",             29.4800f,  -81.1250f, 2, { 63,  78,   0}, {  297,   443,     0}},
+  {"Folly Beach Washout, South Carolina",     32.6680f,  -79.9130f, 1, { 98,   0,   0}, {  127,     0,     0}},
+  {"G-Land, Indonesia",                       -8.7300f,  114.3500f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Galveston Seawall, Texas",                29.2700f,  -94.8300f, 2, { 65,  66,   0}, {   43,   107,     0}},
+  {"Haleiwa, Hawaii",                         21.5970f, -158.1080f, 2, { 38,  37,   0}, {  158,   391,     0}},
+  {"Hampton Beach, New Hampshire",            42.9080f,  -70.8110f, 3, {205, 202, 207}, {   80,   115,   199}},
+  {"Hanalei Bay, Hawaii",                     22.2120f, -159.5000f, 1, { 40,   0,   0}, {  323,     0,     0}},
+  {"Hermosa Beach Pier, California",          33.8620f, -118.4020f, 3, {108, 110, 106}, {  112,   184,   198}},
+  {"Higgins Beach, Maine",                    43.5600f,  -70.2760f, 2, {215, 217,   0}, {  110,   323,     0}},
+  {"Honolua Bay, Hawaii",                     21.0140f, -156.6380f, 3, { 32,  33,  34}, {  146,   213,   413}},
+  {"Hookipa, Hawaii",                         20.9340f, -156.3570f, 2, { 33,  32,   0}, {  132,   342,     0}},
+  {"Hossegor, France",                        43.6700f,   -1.4460f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Huntington Beach Pier, California",       33.6550f, -118.0030f, 1, {104,   0,   0}, {   75,     0,     0}},
+  {"Jalama Beach, California",                34.5110f, -120.5020f, 3, {113, 116, 112}, {  448,   452,   755}},
+  {"Jaws, Hawaii",                            20.9420f, -156.2980f, 2, { 33,  32,   0}, {  193,   404,     0}},
+  {"Jax Beach Pier, Florida",                 30.3268f,  -81.3836f, 1, { 89,   0,   0}, {   89,     0,     0}},
+  {"Jeffreys Bay, South Africa",             -34.0500f,   24.9300f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Joaquina, Brazil",                       -27.6280f,  -48.4490f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Jobos, Puerto Rico",                      18.5150f,  -67.0760f, 3, { 21,  16,  24}, {  128,   346,   377}},
+  {"Jupiter Inlet, Florida",                  26.9440f,  -80.0710f, 3, { 51,  46,  44}, {  813,   909,  1302}},
+  {"La Push, Washington",                     47.9000f, -124.6300f, 1, {253,   0,   0}, {   11,     0,     0}},
+  {"Linda Mar, California",                   37.5960f, -122.5030f, 3, {137, 133, 136}, {  236,   279,   313}},
+  {"Long Beach, New York",                    40.5860f,  -73.6580f, 3, {164, 163, 166}, {  252,   325,   326}},
+  {"Makaha, Hawaii",                          21.4760f, -158.2210f, 1, { 38,   0,   0}, {   26,     0,     0}},
+  {"Malibu Surfrider, California",            34.0350f, -118.6780f, 2, {110, 108,   0}, {  169,   249,     0}},
+  {"Manasquan Inlet, New Jersey",             40.1030f,  -74.0340f, 2, {162, 160,   0}, {  125,   178,     0}},
+  {"Margaret River, Australia",              -33.9760f,  114.9850f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Mavericks, California",                   37.4920f, -122.5010f, 3, {133, 137, 136}, {  251,   351,   395}},
+  {"Mayport Poles, Florida",                  30.3970f,  -81.4276f, 1, { 89,   0,   0}, {    0,     0,     0}},
+  {"Morro Bay, California",                   35.3700f, -120.8680f, 3, {118, 120, 116}, {  236,   406,   639}},
+  {"Mundaka, Spain",                          43.4070f,   -2.6980f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Nags Head, North Carolina",               35.9570f,  -75.6240f, 2, {121, 123,   0}, {  196,   275,     0}},
+  {"Narragansett Town Beach, Rhode Island",   41.4310f,  -71.4550f, 3, {175, 180, 183}, {  135,   167,   348}},
+  {"Nauset Beach, Massachusetts",             41.8600f,  -69.9500f, 3, {189, 185, 179}, {  326,   568,   648}},
+  {"Navarre Beach, Florida",                  30.3780f,  -86.8640f, 2, { 91,  87,   0}, {  334,   650,     0}},
+  {"Nazare, Portugal",                        39.6050f,   -9.0850f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"New Smyrna Beach, Florida",               29.0300f,  -80.8950f, 2, { 63,  59,   0}, {  253,   720,     0}},
+  {"Ocean Beach San Francisco, California",   37.7600f, -122.5110f, 1, {137,   0,   0}, {   65,     0,     0}},
+  {"Ocean Beach, California",                 32.7500f, -117.2550f, 1, { 97,   0,   0}, {   86,     0,     0}},
+  {"Ocean City Inlet, Maryland",              38.3270f,  -75.0850f, 1, {146,   0,   0}, {    3,     0,     0}},
+  {"Oceanside Pier, California",              33.1930f, -117.3870f, 1, {100,   0,   0}, {   38,     0,     0}},
+  {"Otter Rock, Oregon",                      44.7490f, -124.0630f, 1, {231,   0,   0}, {  138,     0,     0}},
+  {"Pavones, Costa Rica",                      8.3900f,  -83.1400f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Pensacola Beach Pier, Florida",           30.3280f,  -87.1420f, 1, { 91,   0,   0}, {  107,     0,     0}},
+  {"Pipeline, Hawaii",                        21.6650f, -158.0530f, 2, { 38,  37,   0}, {  252,   399,     0}},
+  {"Pismo Beach Pier, California",            35.1380f, -120.6430f, 2, {118, 116,   0}, {  111,   310,     0}},
+  {"Playa Hermosa, Costa Rica",                9.5600f,  -84.5800f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Pleasure Point, California",              36.9580f, -121.9720f, 1, {128,   0,   0}, {   41,     0,     0}},
+  {"Point Judith, Rhode Island",              41.3610f,  -71.4810f, 3, {175, 180, 183}, {  205,   248,   429}},
+  {"Poipu, Hawaii",                           21.8730f, -159.4580f, 1, { 40,   0,   0}, {  139,     0,     0}},
+  {"Ponce Inlet, Florida",                    29.0760f,  -80.9170f, 1, { 63,   0,   0}, {  198,     0,     0}},
+  {"Port Aransas, Texas",                     27.8270f,  -97.0500f, 1, { 54,   0,   0}, {    9,     0,     0}},
+  {"Puerto Escondido, Mexico",                15.8520f,  -97.0580f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Punta de Lobos, Chile",                  -34.4260f,  -72.0440f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Punta Roca, El Salvador",                 13.4900f,  -89.3800f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Queens Waikiki, Hawaii",                  21.2720f, -157.8260f, 2, { 36,  37,   0}, {   58,   140,     0}},
+  {"Raglan, New Zealand",                    -37.8060f,  174.8180f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Rincon, California",                      34.3730f, -119.4760f, 3, {112, 109, 113}, {  198,   413,   506}},
+  {"Rockaway Beach, New York",                40.5830f,  -73.8150f, 3, {164, 163, 166}, {  124,   209,   212}},
+  {"Rodanthe Pier, North Carolina",           35.5940f,  -75.4630f, 2, {121, 119,   0}, {  233,   461,     0}},
+  {"Santa Teresa, Costa Rica",                 9.6400f,  -85.1700f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Seaside Cove, Oregon",                    45.9870f, -123.9300f, 2, {239, 244,   0}, {  276,   749,     0}},
+  {"Sebastian Inlet, Florida",                27.8600f,  -80.4450f, 2, { 51,  59,   0}, {  302,   670,     0}},
+  {"Short Sands, Oregon",                     45.7590f, -123.9610f, 3, {239, 244, 237}, {  521,  1003,  1026}},
+  {"Snapper Rocks, Australia",               -28.1630f,  153.5500f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Soup Bowl, Barbados",                     13.2140f,  -59.5220f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"South Padre Island, Texas",               26.1000f,  -97.1600f, 1, { 45,   0,   0}, {   69,     0,     0}},
+  {"St. Augustine Pier, Florida",             29.8560f,  -81.2650f, 1, { 78,   0,   0}, {    3,     0,     0}},
+  {"Steamer Lane, California",                36.9510f, -122.0260f, 1, {128,   0,   0}, {   18,     0,     0}},
+  {"Sunset Beach, Hawaii",                    21.6790f, -158.0410f, 2, { 38,  37,   0}, {  272,   403,     0}},
+  {"Supertubos, Portugal",                    39.3450f,   -9.3620f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Swamis, California",                      33.0340f, -117.2930f, 1, {100,   0,   0}, {  165,     0,     0}},
+  {"Tamarindo, Costa Rica",                   10.3000f,  -85.8400f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Teahupoo, Tahiti",                       -17.8680f, -149.2570f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"The Wedge, California",                   33.5930f, -117.8820f, 1, {104,   0,   0}, {   58,     0,     0}},
+  {"Thurso East, Scotland",                   58.5960f,   -3.5060f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Tres Palmas, Puerto Rico",                18.3490f,  -67.2680f, 2, { 21,  16,   0}, {  148,   189,     0}},
+  {"Trestles, California",                    33.3820f, -117.5890f, 2, {103, 100,   0}, {  147,   310,     0}},
+  {"Tybee Island Pier, Georgia",              31.9930f,  -80.8450f, 1, { 95,   0,   0}, {  113,     0,     0}},
+  {"Uluwatu, Indonesia",                      -8.8150f,  115.0880f, 0, {  0,   0,   0}, {    0,     0,     0}},
+  {"Venice Breakwater, California",           33.9880f, -118.4780f, 2, {110, 108,   0}, {   28,    59,     0}},
+  {"Vilano Beach, Florida",                   29.9180f,  -81.2890f, 1, { 78,   0,   0}, {   70,     0,     0}},
+  {"Virginia Beach 1st Street Jetty, Virginia",   36.8300f,  -75.9710f, 3, {129, 125, 127}, {  210,   237,   345}},
+  {"Waimea Bay, Hawaii",                      21.6420f, -158.0660f, 2, { 38,  37,   0}, {  224,   390,     0}},
+  {"Westport Jetty, Washington",              46.9050f, -124.1200f, 1, {247,   0,   0}, {   73,     0,     0}},
+  {"Wilderness, Puerto Rico",                 18.4990f,  -67.1670f, 1, { 21,   0,   0}, {   81,     0,     0}},
+  {"Windansea, California",                   32.8300f, -117.2810f, 1, { 99,   0,   0}, {   46,     0,     0}},
+  {"Wrightsville Beach, North Carolina",      34.2100f,  -77.7950f, 2, {111, 107,   0}, {  147,   381,     0}},
+  {"Zuma Beach, California",                  34.0150f, -118.8220f, 3, {110, 108, 106}, {  299,   373,   605}},
+};
+static const int SURF_SPOT_COUNT = sizeof(SURF_SPOTS) / sizeof(SURF_SPOTS[0]);
+
+// Coordinates stored by a catalog selection round-trip through float exactly;
+// the tolerance only absorbs values that went through JSON text.
+static const float SPOT_MATCH_DEG = 0.0005f;
+
+// ── Trigram index ───────────────────────────────────────────────────────────
+// Names are normalized to lowercase words separated by single spaces, with a
+// leading space so word starts form their own trigrams (" pi", "pip"). A
+// prefix query therefore shares every trigram with the names it starts a word
+// of, and a typo only costs the few trigrams that span it.
+//
+// Postings are (trigram << 8 | spot) sorted ascending, built on first search.
+// Trigrams pack 5 bits per character; digits share codes, which can only
+// widen the candidate set slightly.
+
+static std::vector<uint32_t> trigramPostings;
+
+static String normalizeName(const String &s) {
+  String out = " ";
+  for (unsigned int i = 0; i < s.length(); i++) {
+    char c = (char)tolower((unsigned char)s.charAt(i));
+    if (isalnum((unsigned char)c)) {
+      out += c;
+    } else if (out.charAt(out.length() - 1) != ' ') {
+      out += ' ';
+    }
+  }
+  if (out.length() > 1 && out.charAt(out.length() - 1) == ' ') out.remove(out.length() - 1);
+  return out;
+}
+
+static uint32_t charCode(char c) {
+  if (c >= 'a' && c <= 'z') return (uint32_t)(c - 'a' + 1);
+  if (c >= '0' && c <= '9') return 27 + (uint32_t)(c - '0') % 5;
+  return 0;
+}
+
+static uint32_t trigramAt(const String &s, unsigned int i) {
+  return (charCode(s.charAt(i)) << 10) | (charCode(s.charAt(i + 1)) << 5) | charCode(s.charAt(i + 2));
+}
+
+static void trigramsOf(const String &normalized, std::vector<uint32_t> &out) {
+  out.clear();
+  for (unsigned int i = 0; i + 2 < normalized.length(); i++) {
+    uint32_t t = trigramAt(normalized, i);
+    if (std::find(out.begin(), out.end(), t) == out.end()) out.push_back(t);
+  }
+}
+
+static void buildTrigramIndex() {
+  std::vector<uint32_t> trigrams;
+  trigramPostings.reserve(SURF_SPOT_COUNT * 24);
+  for (int i = 0; i < SURF_SPOT_COUNT; i++) {
+    trigramsOf(normalizeName(SURF_SPOTS[i].name), trigrams);
+    for (uint32_t t : trigrams) trigramPostings.push_back((t << 8) | (uint32_t)i);
+  }
+  std::sort(trigramPostings.begin(), trigramPostings.end());
+  trigramPostings.shrink_to_fit();
+}
+
+static LocationInfo spotLocation(const SurfSpot &spot) {
+  LocationInfo info;
+  info.latitude = spot.lat;
+  info.longitude = spot.lon;
+  info.displayName = spot.name;
+  info.valid = true;
+  return info;
+}
+
+static bool sameCoordinates(float lat1, float lon1, float lat2, float lon2) {
+  return fabsf(lat1 - lat2) < SPOT_MATCH_DEG && fabsf(lon1 - lon2) < SPOT_MATCH_DEG;
+}
+
+// True if the normalized query starts any word of the normalized name.
+static bool startsWord(const String &name, const String &query) {
+  return name.indexOf(query) >= 0;  // both carry a leading space
+}
+
+struct SpotScore {
+  uint8_t spot;
+  uint8_t shared;
+  uint8_t prefix;    // 2 = starts the name, 1 = starts a word
+};
+
+static void scoreSpots(const String &query, std::vector<SpotScore> &ranked) {
+  ranked.clear();
+  if (query.length() < 2) return;
+  if (trigramPostings.empty()) buildTrigramIndex();
+
+  uint8_t shared[SURF_SPOT_COUNT] = {};
+  int queryTrigrams = 0;
+  if (query.length() >= 3) {
+    std::vector<uint32_t> trigrams;
+    trigramsOf(query, trigrams);
+    queryTrigrams = (int)trigrams.size();
+    for (uint32_t t : trigrams) {
+      auto it = std::lower_bound(trigramPostings.begin(), trigramPostings.end(), t << 8);
+      for (; it != trigramPostings.end() && (*it >> 8) == t; ++it) shared[*it & 0xFF]++;
+    }
+  }
+
+  // A single-letter query has no trigram; every spot is a prefix candidate.
+  // Longer queries need half their trigrams, which survives one mistyped
+  // character (it spoils up to three).
+  int needed = queryTrigrams <= 2 ? queryTrigrams : (queryTrigrams + 1) / 2;
+  for (int i = 0; i < SURF_SPOT_COUNT; i++) {
+    if (shared[i] < needed) continue;
+    SpotScore s;
+    s.spot = (uint8_t)i;
+    s.shared = shared[i];
+    s.prefix = 0;
+    if (queryTrigrams == 0 || shared[i] == queryTrigrams) {
+      String name = normalizeName(SURF_SPOTS[i].name);
+      if (name.startsWith(query)) s.prefix = 2;
+      else if (startsWord(name, query)) s.prefix = 1;
+    }
+    if (queryTrigrams == 0 && s.prefix == 0) continue;
+    ranked.push_back(s);
+  }
+
+  std::sort(ranked.begin(), ranked.end(), [](const SpotScore &a, const SpotScore &b) {
+    if (a.shared != b.shared) return a.shared > b.shared;
+    if (a.prefix != b.prefix) return a.prefix > b.prefix;
+    return a.spot < b.spot;
+  });
+}
+
+std::vector<LocationInfo> suggestLocations(const String &query, const std::vector<LocationInfo> &saved, int maxResults) {
+  std::vector<LocationInfo> results;
+  String q = normalizeName(query);
+  if (q.length() < 2 || maxResults <= 0) return results;
+
+  for (const LocationInfo &loc : saved) {
+    if ((int)results.size() >= maxResults) return results;
+    if (loc.valid && startsWord(normalizeName(loc.displayName), q)) results.push_back(loc);
+  }
+
+  std::vector<SpotScore> ranked;
+  scoreSpots(q, ranked);
+  for (const SpotScore &s : ranked) {
+    if ((int)results.size() >= maxResults) break;
+    const SurfSpot &spot = SURF_SPOTS[s.spot];
+    bool duplicate = false;
+    for (const LocationInfo &r : results) {
+      if (sameCoordinates(r.latitude, r.longitude, spot.lat, spot.lon)) { duplicate = true; break; }
+    }
+    if (!duplicate) results.push_back(spotLocation(spot));
+  }
+  return results;
+}
+
+bool resolveLocalLocation(const String &query, const std::vector<LocationInfo> &saved, LocationInfo &result) {
+  String q = normalizeName(query);
+  if (q.length() < 2) return false;
+
+  for (const LocationInfo &loc : saved) {
+    if (loc.valid && normalizeName(loc.displayName) == q) {
+      result = loc;
+      return true;
+    }
+  }
+
+  // Full "Spot, Region" names (what a tapped suggestion returns), or a bare
+  // spot name only one entry carries ("pipeline" but not "ocean beach")
+  int nameMatch = -1;
+  int shortMatches = 0;
+  for (int i = 0; i < SURF_SPOT_COUNT; i++) {
+    String name = normalizeName(SURF_SPOTS[i].name);
+    if (name == q) {
+      result = spotLocation(SURF_SPOTS[i]);
+      return true;
+    }
+    const char *comma = strchr(SURF_SPOTS[i].name, ',');
+    String shortName = comma ? String(SURF_SPOTS[i].name).substring(0, comma - SURF_SPOTS[i].name) : String(SURF_SPOTS[i].name);
+    if (normalizeName(shortName) == q) {
+      nameMatch = i;
+      shortMatches++;
+    }
+  }
+  if (shortMatches != 1) return false;
+  result = spotLocation(SURF_SPOTS[nameMatch]);
+  return true;
+}
+
+int surfSpotTideStations(float latitude, float longitude, TideStationMatch *matches, int maxMatches) {
+  for (int i = 0; i < SURF_SPOT_COUNT; i++) {
+    const SurfSpot &spot = SURF_SPOTS[i];
+    if (!sameCoordinates(latitude, longitude, spot.lat, spot.lon)) continue;
+    int found = 0;
+    for (int s = 0; s < spot.stationCount && found < maxMatches; s++) {
+      if (!tideStationAtPoint(spot.stations[s], matches[found])) continue;
+      matches[found].distKm = spot.distDeciKm[s] / 10.0f;
+      found++;
+    }
+    return found;
+  }
+  return -1;
+}
@@ -0,0 +1,219 @@
+#include "TidePredictor.h"
+#include <math.h>
+#include <string.h>
+
+// Harmonic tide prediction after Schureman (1958):
+//   h(t) = MSL + sum f * A * cos(V(t) + u - kappa)
+// A and kappa are the station's NOAA constants (Greenwich epoch), V is the
+// equilibrium argument from the mean astronomical longitudes and f/u are the
+// 18.6-year nodal corrections.
+
+enum NodalType : uint8_t { NODAL_NONE, NODAL_M2, NODAL_O1, NODAL_K1, NODAL_K2, NODAL_MF, NODAL_MM, NODAL_M2_SQ, NODAL_M2_CUBE };
+
+// V = T*iT + s*is + h*ih + p*ip + p1*ip1 + offset. Kept in rodata (flash).
+struct ConstituentDef {
+  char name[5];
+  int8_t iT, is, ih, ip, ip1;
+  int16_t offsetDeg;
+  NodalType nodal;
+};
+
+static const ConstituentDef CONSTITUENTS[] = {
+  {"M2",   2, -2,  2,  0, 0,   0, NODAL_M2},
+  {"S2",   2,  0,  0,  0, 0,   0, NODAL_NONE},
+  {"N2",   2, -3,  2,  1, 0,   0, NODAL_M2},
+  {"K1",   1,  0,  1,  0, 0, -90, NODAL_K1},
+  {"M4",   4, -4,  4,  0, 0,   0, NODAL_M2_SQ},
+  {"O1",   1, -2,  1,  0, 0,  90, NODAL_O1},
+  {"M6",   6, -6,  6,  0, 0,   0, NODAL_M2_CUBE},
+  {"MK3",  3, -2,  3,  0, 0, -90, NODAL_M2},      // nodal approximated by M2
+  {"S4",   4,  0,  0,  0, 0,   0, NODAL_NONE},
+  {"MN4",  4, -5,  4,  1, 0,   0, NODAL_M2_SQ},
+  {"NU2",  2, -3,  4, -1, 0,   0, NODAL_M2},
+  {"S6",   6,  0,  0,  0, 0,   0, NODAL_NONE},
+  {"MU2",  2, -4,  4,  0, 0,   0, NODAL_M2},
+  {"2N2",  2, -4,  2,  2, 0,   0, NODAL_M2},
+  {"OO1",  1,  2,  1,  0, 0, -90, NODAL_K2},      // nodal approximated by K2
+  {"LAM2", 2, -1,  0,  1, 0, 180, NODAL_M2},
+  {"S1",   1,  0,  0,  0, 0, 180, NODAL_NONE},
+  {"M1",   1, -1,  1,  1, 0, -90, NODAL_O1},      // nodal approximated by O1
+  {"J1",   1,  1,  1, -1, 0, -90, NODAL_K1},      // nodal approximated by K1
+  {"MM",   0,  1,  0, -1, 0,   0, NODAL_MM},
+  {"SSA",  0,  0,  2,  0, 0,   0, NODAL_NONE},
+  {"SA",   0,  0,  1,  0, 0,   0, NODAL_NONE},
+  {"MSF",  0,  2, -2,  0, 0,   0, NODAL_M2},
+  {"MF",   0,  2,  0,  0, 0,   0, NODAL_MF},
+  {"RHO",  1, -3,  3, -1, 0,  90, NODAL_O1},
+  {"Q1",   1, -3,  1,  1, 0,  90, NODAL_O1},
+  {"T2",   2,  0, -1,  0, 1,   0, NODAL_NONE},
+  {"R2",   2,  0,  1,  0,-1, 180, NODAL_NONE},
+  {"2Q1",  1, -4,  1,  2, 0,  90, NODAL_O1},
+  {"P1",   1,  0, -1,  0, 0,  90, NODAL_NONE},
+  {"2SM2", 2,  2, -2,  0, 0,   0, NODAL_M2},
+  {"M3",   3, -3,  3,  0, 0,   0, NODAL_M2},      // nodal approximated by M2
+  {"L2",   2, -1,  2, -1, 0, 180, NODAL_M2},      // nodal approximated by M2
+  {"2MK3", 3, -4,  3,  0, 0,  90, NODAL_M2_SQ},
+  {"K2",   2,  0,  2,  0, 0,   0, NODAL_K2},
+  {"M8",   8, -8,  8,  0, 0,   0, NODAL_M2_SQ},   // f^4 approximated by f^2
+  {"MS4",  4, -2,  2,  0, 0,   0, NODAL_M2},
+};
+static const int CONSTITUENT_COUNT = sizeof(CONSTITUENTS) / sizeof(CONSTITUENTS[0]);
+
+// Rates of the astronomical arguments in degrees per mean solar hour
+static const double SPEED_T = 15.0;
+static const double SPEED_S = 0.5490165;
+static const double SPEED_H = 0.0410686;
+static const double SPEED_P = 0.0046418;
+static const double SPEED_P1 = 0.0000020;
+
+static const double DEG = M_PI / 180.0;
+
+struct AstroArgs {
+  double T, s, h, p, N, p1;  // degrees
+};
+
+// Mean longitudes at a UTC time (Meeus polynomials, linear terms).
+static void astronomicalArguments(time_t t, AstroArgs &a) {
+  double days = (double)(t - 946728000) / 86400.0;  // since J2000.0 (2000-01-01 12:00 UTC)
+  double c = days / 36525.0;
+  a.s = 218.3164477 + 481267.88123421 * c;
+  a.h = 280.46646 + 36000.76983 * c;
+  a.p = 83.3532465 + 4069.0137287 * c;
+  a.N = 125.04452 - 1934.136261 * c;
+  a.p1 = 282.93735 + 1.71946 * c;
+  long secondsOfDay = (long)(t % 86400);
+  if (secondsOfDay < 0) secondsOfDay += 86400;
+  a.T = 180.0 + secondsOfDay / 240.0;
+}
+
+// Nodal amplitude factor f and phase correction u (degrees), Pugh (1987) table 4.3.
+static void nodalCorrection(NodalType type, double N, float &f, float &u) {
+  double n = N * DEG;
+  double fm2 = 1.0004 - 0.0373 * cos(n) + 0.0002 * cos(2 * n);
+  double um2 = -2.14 * sin(n);
+  switch (type) {
+    case NODAL_M2:      f = fm2; u = um2; break;
+    case NODAL_M2_SQ:   f = fm2 * fm2; u = 2 * um2; break;
+    case NODAL_M2_CUBE: f = fm2 * fm2 * fm2; u = 3 * um2; break;
+    case NODAL_O1:
+      f = 1.0089 + 0.1871 * cos(n) - 0.0147 * cos(2 * n) + 0.0014 * cos(3 * n);
+      u = 10.80 * sin(n) - 1.34 * sin(2 * n) + 0.19 * sin(3 * n);
+      break;
+    case NODAL_K1:
+      f = 1.0060 + 0.1150 * cos(n) - 0.0088 * cos(2 * n) + 0.0006 * cos(3 * n);
+      u = -8.86 * sin(n) + 0.68 * sin(2 * n) - 0.07 * sin(3 * n);
+      break;
+    case NODAL_K2:
+      f = 1.0241 + 0.2863 * cos(n) + 0.0083 * cos(2 * n) - 0.0015 * cos(3 * n);
+      u = -17.74 * sin(n) + 0.68 * sin(2 * n) - 0.04 * sin(3 * n);
+      break;
+    case NODAL_MF:
+      f = 1.043 + 0.414 * cos(n);
+      u = -23.74 * sin(n) + 2.68 * sin(2 * n) - 0.38 * sin(3 * n);
+      break;
+    case NODAL_MM:
+      f = 1.000 - 0.130 * cos(n);
+      u = 0.0f;
+      break;
+    default:
+      f = 1.0f;
+      u = 0.0f;
+      break;
+  }
+}
+
+// Constituents reduced to amplitude * cos(phase0 + speed * hours) about an epoch.
+struct PreparedTerm {
+  float amplitude;   // f * A, metres
+  float phaseRad;    // V(epoch) + u - kappa
+  float speedRad;    // radians per hour
+};
+
+static int prepareTerms(const TideHarmonics &harmonics, time_t epoch, PreparedTerm terms[TIDE_MAX_CONSTITUENTS]) {
+  AstroArgs a;
+  astronomicalArguments(epoch, a);
+  int n = 0;
+  for (int i = 0; i < harmonics.count && i < TIDE_MAX_CONSTITUENTS; i++) {
+    const TideConstituent &c = harmonics.constituents[i];
+    if (c.index >= CONSTITUENT_COUNT) continue;
+    const ConstituentDef &d = CONSTITUENTS[c.index];
+    double v = d.iT * a.T + d.is * a.s + d.ih * a.h + d.ip * a.p + d.ip1 * a.p1 + d.offsetDeg;
+    double speed = d.iT * SPEED_T + d.is * SPEED_S + d.ih * SPEED_H + d.ip * SPEED_P + d.ip1 * SPEED_P1;
+    float f, u;
+    nodalCorrection(d.nodal, a.N, f, u);
+    terms[n].amplitude = f * c.amplitudeMm / 1000.0f;
+    terms[n].phaseRad = (float)(fmod(v + u - c.phaseCentiDeg / 100.0, 360.0) * DEG);
+    terms[n].speedRad = (float)(speed * DEG);
+    n++;
+  }
+  return n;
+}
+
+static float evaluateTerms(const PreparedTerm *terms, int n, float hours, float *rate) {
+  float height = 0.0f;
+  float slope = 0.0f;
+  for (int i = 0; i < n; i++) {
+    float arg = terms[i].phaseRad + terms[i].speedRad * hours;
+    height += terms[i].amplitude * cosf(arg);
+    if (rate) slope -= terms[i].amplitude * terms[i].speedRad * sinf(arg);
+  }
+  if (rate) *rate = slope;
+  return height;
+}
+
+int tideConstituentIndex(const char *name) {
+  if (!name) return -1;
+  for (int i = 0; i < CONSTITUENT_COUNT; i++) {
+    if (strcmp(CONSTITUENTS[i].name, name) == 0) return i;
+  }
+  return -1;
+}
+
+float predictTideHeight(const TideHarmonics &harmonics, time_t t) {
+  PreparedTerm terms[TIDE_MAX_CONSTITUENTS];
+  int n = prepareTerms(harmonics, t, terms);
+  return harmonics.mslMm / 1000.0f + evaluateTerms(terms, n, 0.0f, nullptr);
+}
+
+float predictTideRate(const TideHarmonics &harmonics, time_t t) {
+  PreparedTerm terms[TIDE_MAX_CONSTITUENTS];
+  int n = prepareTerms(harmonics, t, terms);
+  float rate = 0.0f;
+  evaluateTerms(terms, n, 0.0f, &rate);
+  return rate;
+}
+
+int predictTideDay(const TideHarmonics &harmonics, time_t t, TideEvent *events, int maxEvents,
+                   float &minTide, float &maxTide) {
+  const int STEP_MIN = 6;
+  const int STEPS = 24 * 60 / STEP_MIN;
+  time_t dayStart = t - (t % 86400);
+
+  PreparedTerm terms[TIDE_MAX_CONSTITUENTS];
+  int n = prepareTerms(harmonics, dayStart, terms);
+  float msl = harmonics.mslMm / 1000.0f;
+
+  int found = 0;
+  float prevRate = 0.0f;
+  for (int i = 0; i <= STEPS; i++) {
+    float hours = i * STEP_MIN / 60.0f;
+    float rate = 0.0f;
+    float height = msl + evaluateTerms(terms, n, hours, &rate);
+    if (i == 0 || height < minTide) minTide = height;
+    if (i == 0 || height > maxTide) maxTide = height;
+
+    // A sign change in the slope brackets a turning point within the last step
+    if (i > 0 && ((prevRate > 0.0f && rate <= 0.0f) || (prevRate < 0.0f && rate >= 0.0f))) {
+      float frac = prevRate / (prevRate - rate);
+      float eventHours = hours - STEP_MIN / 60.0f * (1.0f - frac);
+      if (events && found < maxEvents) {
+        events[found].time = dayStart + (time_t)(eventHours * 3600.0f);
+        events[found].height = msl + evaluateTerms(terms, n, eventHours, nullptr);
+        events[found].high = prevRate > 0.0f;
+      }
+      found++;
+    }
+    prevRate = rate;
+  }
+  return (events && found > maxEvents) ? maxEvents : found;
+}
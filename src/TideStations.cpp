@@ -0,0 +1,454 @@
+#include "TideStations.h"
+#include <math.h>
+
+// NOAA tide stations covering US East/Gulf/West coasts, Alaska, Hawaii, Puerto
+// Rico, USVI, the Great Lakes and Pacific territories.
+//
+// Each station ID is stored once in TIDE_STATION_IDS (sorted); points refer to
+// it by index, so several points may map a stretch of coast to one station.
+// TIDE_STATION_POINTS must stay sorted by latitude — the band index depends on it.
+
+struct TideStationPoint {
+  float lat;
+  float lon;
+  uint16_t station;   // index into TIDE_STATION_IDS
+  const char *name;
+};
+
+static const char *const TIDE_STATION_IDS[] = {
+  "1611400", "1612340", "1613198", "1615093", "1615680", "1617433",
+  "1617760", "1619910", "1622670", "1630000", "1631428", "1632200",
+  "1770000", "8410140", "8411060", "8413320", "8414131", "8414250",
+  "8415490", "8416121", "8417177", "8418150", "8419317", "8419363",
+  "8423898", "8425453", "8441501", "8442150", "8443970", "8446166",
+  "8447386", "8447435", "8447505", "8447930", "8449130", "8452660",
+  "8452944", "8454049", "8461490", "8465705", "8467150", "8510560",
+  "8516945", "8517741", "8518750", "8519483", "8530973", "8531680",
+  "8533085", "8534720", "8535951", "8536110", "8551762", "8556762",
+  "8557380", "8570283", "8571773", "8571892", "8574680", "8577330",
+  "8578240", "8594900", "8632200", "8632837", "8637689", "8638610",
+  "8639348", "8651370", "8652587", "8654467", "8655875", "8656483",
+  "8658120", "8659084", "8661070", "8662245", "8665530", "8669289",
+  "8670870", "8677344", "8720030", "8720218", "8720587", "8721604",
+  "8722669", "8722670", "8722956", "8723170", "8723214", "8724580",
+  "8725110", "8725520", "8726384", "8726520", "8726607", "8727235",
+  "8727520", "8728690", "8729108", "8729210", "8729840", "8735180",
+  "8737048", "8741533", "8744117", "8747437", "8760551", "8761724",
+  "8761927", "8764044", "8764227", "8764314", "8767816", "8768094",
+  "8770570", "8770822", "8771341", "8771450", "8772447", "8773037",
+  "8773259", "8773767", "8774770", "8775870", "8776604", "8779770",
+  "9034052", "9063007", "9063012", "9063020", "9063028", "9063053",
+  "9063054", "9076024", "9086080", "9087023", "9087044", "9087057",
+  "9087072", "9087079", "9087096", "9099018", "9099041", "9410079",
+  "9410170", "9410195", "9410230", "9410580", "9410660", "9411081",
+  "9411340", "9411399", "9411541", "9412110", "9412340", "9413450",
+  "9413617", "9413745", "9414290", "9414523", "9414750", "9414795",
+  "9414863", "9415020", "9415095", "9415096", "9416841", "9418767",
+  "9419750", "9431647", "9432780", "9434939", "9435380", "9439040",
+  "9440422", "9440910", "9441102", "9443090", "9444090", "9444900",
+  "9446482", "9446484", "9447130", "9449424", "9449880", "9450460",
+  "9451054", "9451600", "9452210", "9452400", "9453220", "9454050",
+  "9454240", "9455090", "9455500", "9455920", "9457292", "9457804",
+  "9459450", "9459881", "9461710", "9462450", "9462620", "9468333",
+  "9468756", "9491094", "9497645", "9751381", "9751401", "9751639",
+  "9752235", "9752695", "9753216", "9754228", "9755371", "9757809",
+  "9759110", "9759394", "9759938",
+};
+
+static const TideStationPoint TIDE_STATION_POINTS[] = {
+  {  -14.307f,  -170.763f,  12, "Aunu'u, American Samoa" },
+  {  -14.281f,  -170.690f,  12, "Pago Pago, American Samoa" },
+  {  -14.174f,  -170.772f,  12, "Leone, American Samoa" },
+  {   13.444f,   144.655f,  10, "Apra Harbor, Guam" },
+  {   13.474f,   144.718f,  10, "Agana, Guam" },
+  {   14.276f,   145.023f,  11, "Saipan, Northern Mariana Islands" },
+  {   15.215f,   145.761f,  11, "Rota, Northern Mariana Islands" },
+  {   16.745f,   169.523f,   8, "Johnston Atoll" },
+  {   17.746f,   -64.702f, 209, "Christiansted, USVI" },
+  {   17.962f,   -66.151f, 213, "Yabucoa Harbor, PR" },
+  {   17.970f,   -66.614f, 216, "Magueyes Island, PR" },
+  {   17.970f,   -66.400f, 217, "La Parguera, PR" },
+  {   18.000f,   -65.889f, 211, "Esperanza, PR" },
+  {   18.003f,   -66.614f, 216, "Ponce, PR" },
+  {   18.090f,   -65.460f, 213, "Humacao, PR" },
+  {   18.195f,   -65.012f, 210, "Culebra, USVI" },
+  {   18.214f,   -67.159f, 218, "Mayaguez, PR" },
+  {   18.301f,   -64.998f, 207, "Lameshur Bay, USVI" },
+  {   18.335f,   -65.634f, 212, "Fajardo, PR" },
+  {   18.340f,   -64.924f, 208, "Charlotte Amalie, USVI" },
+  {   18.370f,   -65.327f, 212, "Vieques, PR" },
+  {   18.427f,   -67.154f, 216, "Aguadilla, PR" },
+  {   18.461f,   -66.439f, 215, "Manati, PR" },
+  {   18.469f,   -66.117f, 214, "San Juan, PR" },
+  {   18.474f,   -66.721f, 215, "Arecibo, PR" },
+  {   18.912f,  -155.651f,   6, "Punaluu, HI" },
+  {   19.283f,   166.618f,   9, "Wake Island" },
+  {   19.730f,  -156.064f,   5, "Kawaihae, HI" },
+  {   19.730f,  -155.060f,   6, "Hilo, HI" },
+  {   20.026f,  -155.834f,   6, "Kailua-Kona, HI" },
+  {   20.731f,  -156.441f,   4, "Maalaea, HI" },
+  {   20.783f,  -157.038f,   4, "Lanai City, HI" },
+  {   20.890f,  -156.683f,   3, "Kaunakakai, HI" },
+  {   20.895f,  -156.477f,   4, "Kahului, HI" },
+  {   21.100f,  -157.025f,   1, "Laie, HI" },
+  {   21.185f,  -157.083f,   1, "Kaneohe Bay, HI" },
+  {   21.307f,  -157.867f,   1, "Honolulu, HI" },
+  {   21.395f,  -157.799f,   2, "Mokuoloe, HI" },
+  {   21.482f,  -158.197f,   1, "Waianae, HI" },
+  {   21.890f,  -159.602f,   0, "Port Allen, HI" },
+  {   21.954f,  -159.356f,   0, "Nawiliwili, HI" },
+  {   24.555f,   -81.808f,  89, "Key West, FL" },
+  {   24.943f,   -80.537f,  89, "Key Largo, FL" },
+  {   25.521f,   -80.374f,  88, "Virginia Key, FL" },
+  {   25.774f,   -80.130f,  87, "Miami Beach, FL" },
+  {   26.063f,   -97.216f, 125, "Port Isabel, TX" },
+  {   26.127f,   -80.104f,  84, "Lake Worth, FL" },
+  {   26.133f,   -81.795f,  90, "Naples, FL" },
+  {   26.448f,   -82.086f,  91, "Fort Myers, FL" },
+  {   26.960f,   -82.460f,  92, "Port Charlotte, FL" },
+  {   27.427f,   -97.221f, 124, "Baffin Bay, TX" },
+  {   27.660f,   -80.237f,  85, "Lake Worth Pier, FL" },
+  {   27.767f,   -82.630f,  93, "St. Petersburg, FL" },
+  {   27.818f,   -97.398f, 123, "Ingleside, TX" },
+  {   27.834f,   -97.054f, 123, "Corpus Christi, TX" },
+  {   27.920f,   -82.437f,  94, "Old Port Tampa, FL" },
+  {   28.022f,   -97.047f, 122, "Rockport, TX" },
+  {   28.210f,  -177.375f,   7, "Midway Islands, HI" },
+  {   28.444f,   -96.397f, 121, "Port O'Connor, TX" },
+  {   28.454f,   -80.558f,  86, "Port Canaveral, FL" },
+  {   28.929f,   -82.878f,  95, "Cedar Key, FL" },
+  {   28.944f,   -95.323f, 118, "Freeport, TX" },
+  {   29.100f,   -95.580f, 120, "Matagorda Ship Channel, TX" },
+  {   29.228f,   -81.023f,  83, "Daytona Beach, FL" },
+  {   29.263f,   -89.957f, 107, "Grand Isle, LA" },
+  {   29.285f,   -94.789f, 117, "Galveston (Pleasure Pier), TX" },
+  {   29.361f,   -94.793f, 116, "Galveston (Pier 21), TX" },
+  {   29.373f,   -94.897f, 116, "Texas City, TX" },
+  {   29.450f,   -95.022f, 118, "Texas City, TX" },
+  {   29.456f,   -91.327f, 110, "Eugene Island, LA" },
+  {   29.681f,   -95.028f, 119, "Morgans Point, TX" },
+  {   29.690f,   -93.912f, 114, "Sabine Pass North, TX" },
+  {   29.722f,   -94.983f, 115, "Texas Point, TX" },
+  {   29.730f,   -85.028f,  97, "Apalachicola, FL" },
+  {   29.767f,   -91.883f, 111, "Cypremort Point, LA" },
+  {   29.768f,   -93.343f, 113, "Calcasieu Pass, LA" },
+  {   29.780f,   -90.420f, 109, "Berwick, LA" },
+  {   29.782f,   -93.326f, 112, "Lake Charles, LA" },
+  {   29.859f,   -81.265f,  82, "St. Augustine, FL" },
+  {   29.949f,   -90.070f, 108, "New Canal Station, LA" },
+  {   30.072f,   -84.178f,  96, "St. Marks, FL" },
+  {   30.154f,   -85.660f,  98, "Panama City, FL" },
+  {   30.162f,   -85.802f,  98, "Panama City Beach, FL" },
+  {   30.220f,   -89.930f, 106, "South Pass, LA" },
+  {   30.250f,   -88.075f, 101, "Dauphin Island, AL" },
+  {   30.268f,   -89.090f, 103, "Pascagoula, MS" },
+  {   30.325f,   -89.326f, 105, "Bay Waveland, MS" },
+  {   30.348f,   -87.541f,  99, "Navarre Beach, FL" },
+  {   30.396f,   -88.885f, 104, "Biloxi, MS" },
+  {   30.397f,   -81.428f,  81, "Mayport, FL" },
+  {   30.404f,   -87.650f, 100, "Perdido Pass, AL" },
+  {   30.404f,   -87.211f, 100, "Pensacola, FL" },
+  {   30.670f,   -81.466f,  80, "Fernandina Beach, FL" },
+  {   30.691f,   -88.043f, 102, "Mobile State Docks, AL" },
+  {   31.233f,   -81.400f,  79, "Brunswick, GA" },
+  {   32.083f,   -80.900f,  78, "Fort Pulaski, GA" },
+  {   32.457f,   -80.671f,  77, "Hilton Head, SC" },
+  {   32.714f,  -117.174f, 144, "San Diego, CA" },
+  {   32.782f,   -79.926f,  76, "Charleston, SC" },
+  {   32.867f,  -117.258f, 144, "La Jolla, CA" },
+  {   33.159f,  -117.389f, 144, "Oceanside, CA" },
+  {   33.352f,   -79.186f,  75, "Georgetown, SC" },
+  {   33.456f,  -118.489f, 143, "Avalon, CA" },
+  {   33.463f,  -117.714f, 145, "Dana Point, CA" },
+  {   33.629f,  -117.928f, 145, "Newport Beach, CA" },
+  {   33.655f,   -78.918f,  74, "Springmaid Pier, SC" },
+  {   33.720f,  -118.272f, 146, "Cabrillo Beach, CA" },
+  {   33.920f,   -78.015f,  73, "Southport, NC" },
+  {   33.961f,  -118.423f, 148, "Los Angeles, CA" },
+  {   34.002f,  -119.494f, 151, "Port Hueneme, CA" },
+  {   34.007f,  -118.498f, 147, "Santa Monica, CA" },
+  {   34.227f,   -77.953f,  72, "Wilmington, NC" },
+  {   34.408f,  -119.688f, 150, "Santa Barbara, CA" },
+  {   34.460f,  -120.017f, 149, "Gaviota, CA" },
+  {   34.718f,   -76.667f,  71, "Beaufort, NC" },
+  {   34.905f,   -76.680f,  71, "Morehead City, NC" },
+  {   34.914f,  -120.440f, 152, "Vandenberg, CA" },
+  {   35.105f,   -76.843f,  70, "Cherry Branch, NC" },
+  {   35.179f,  -120.754f, 153, "Port San Luis, CA" },
+  {   35.228f,   -75.703f,  69, "Hatteras, NC" },
+  {   35.673f,  -121.119f, 154, "Cayucos, CA" },
+  {   35.792f,   -75.549f,  68, "Oregon Inlet Marina, NC" },
+  {   35.918f,   -76.478f,  67, "Stumpy Point, NC" },
+  {   36.183f,   -75.747f,  67, "Duck, NC" },
+  {   36.605f,  -121.898f, 155, "Monterey, CA" },
+  {   36.620f,   -76.018f,  66, "Chesapeake, VA" },
+  {   36.832f,   -76.298f,  66, "Money Point, VA" },
+  {   36.947f,   -76.330f,  65, "Sewells Point, VA" },
+  {   36.965f,  -122.017f, 157, "Santa Cruz, CA" },
+  {   37.015f,   -76.016f,  62, "Kiptopeke, VA" },
+  {   37.167f,   -76.444f,  64, "Yorktown, VA" },
+  {   37.290f,   -76.502f,  63, "Yorktown, VA" },
+  {   37.334f,  -121.899f, 156, "Alviso Slough, CA" },
+  {   37.491f,  -122.216f, 159, "Redwood City, CA" },
+  {   37.528f,   -76.295f,  62, "Windmill Point, VA" },
+  {   37.596f,  -122.032f, 160, "Newark Slough, CA" },
+  {   37.772f,  -122.225f, 160, "Alameda, CA" },
+  {   37.806f,  -122.465f, 158, "San Francisco, CA" },
+  {   37.902f,  -122.361f, 162, "Richmond, CA" },
+  {   37.928f,  -122.025f, 165, "Martinez, CA" },
+  {   37.930f,  -122.416f, 161, "Crockett, CA" },
+  {   38.062f,  -122.919f, 163, "Point Reyes, CA" },
+  {   38.065f,  -122.122f, 164, "Benicia, CA" },
+  {   38.120f,  -122.935f, 163, "Tomales Bay, CA" },
+  {   38.221f,   -76.070f,  56, "Oxford, MD" },
+  {   38.317f,   -76.451f,  59, "Solomons Island, MD" },
+  {   38.327f,   -75.088f,  55, "Ocean City Inlet, MD" },
+  {   38.330f,  -123.046f, 163, "Bodega Bay, CA" },
+  {   38.417f,   -76.583f,  60, "Bishops Head, MD" },
+  {   38.571f,   -76.068f,  57, "Cambridge, MD" },
+  {   38.687f,   -75.361f,  53, "Rehoboth Beach, DE" },
+  {   38.782f,   -75.119f,  54, "Lewes, DE" },
+  {   38.873f,   -77.021f,  61, "Washington DC" },
+  {   38.955f,  -123.745f, 163, "Point Arena, CA" },
+  {   38.968f,   -74.960f,  51, "Cape May, NJ" },
+  {   38.983f,   -76.483f,  58, "Baltimore, MD" },
+  {   39.087f,   -74.802f,  50, "Ocean City, NJ" },
+  {   39.356f,   -74.418f,  49, "Atlantic City, NJ" },
+  {   39.445f,  -123.807f, 166, "Fort Bragg, CA" },
+  {   39.579f,   -75.588f,  52, "Delaware City, DE" },
+  {   39.944f,   -74.053f,  48, "Barnegat, NJ" },
+  {   40.166f,  -124.181f, 167, "Eureka, CA" },
+  {   40.214f,   -74.012f,  46, "Raritan Bay, NJ" },
+  {   40.466f,   -74.009f,  47, "Sandy Hook, NJ" },
+  {   40.623f,   -73.952f,  43, "Jamaica Bay, NY" },
+  {   40.638f,   -74.065f,  45, "Bergen Point, NY" },
+  {   40.700f,   -74.014f,  44, "The Battery, NY" },
+  {   40.770f,  -124.179f, 167, "Humboldt Bay, CA" },
+  {   40.890f,   -73.369f,  42, "Kings Point, NY" },
+  {   41.071f,   -71.960f,  41, "Montauk, NY" },
+  {   41.174f,   -73.182f,  40, "Bridgeport, CT" },
+  {   41.283f,   -72.928f,  39, "New Haven, CT" },
+  {   41.284f,   -70.099f,  34, "Nantucket, MA" },
+  {   41.356f,   -72.090f,  38, "New London, CT" },
+  {   41.502f,   -81.694f, 128, "Cleveland, OH" },
+  {   41.505f,   -71.327f,  35, "Newport, RI" },
+  {   41.524f,   -82.708f, 131, "Marblehead, OH" },
+  {   41.524f,   -70.672f,  31, "New Bedford, MA" },
+  {   41.524f,   -70.671f,  32, "Chatham, MA" },
+  {   41.553f,   -70.614f,  33, "Woods Hole, MA" },
+  {   41.580f,   -71.427f,  37, "Quonset Point, RI" },
+  {   41.668f,   -71.162f,  31, "Taunton River, MA" },
+  {   41.691f,   -83.472f, 132, "Toledo, OH" },
+  {   41.732f,   -71.340f,  36, "Providence, RI" },
+  {   41.745f,  -124.184f, 168, "Crescent City, CA" },
+  {   41.753f,   -70.620f,  30, "Fall River, MA" },
+  {   41.766f,   -81.278f, 130, "Fairport, OH" },
+  {   41.770f,   -87.532f, 134, "Chicago, IL" },
+  {   42.083f,   -80.090f, 127, "Conneaut, OH" },
+  {   42.085f,   -70.203f,  29, "Plymouth, MA" },
+  {   42.090f,   -70.660f,  29, "Duxbury, MA" },
+  {   42.108f,   -86.458f, 137, "South Haven, MI" },
+  {   42.130f,   -79.974f, 129, "Erie, PA" },
+  {   42.250f,   -83.150f, 126, "Detroit, MI" },
+  {   42.345f,  -124.368f, 169, "Gold Beach, OR" },
+  {   42.350f,   -87.830f, 140, "Waukegan, IL" },
+  {   42.359f,   -71.050f,  28, "Boston, MA" },
+  {   42.360f,   -86.220f, 137, "Holland, MI" },
+  {   42.534f,   -71.164f,  27, "Salem, MA" },
+  {   42.608f,   -70.660f,  26, "Gloucester, MA" },
+  {   42.728f,   -87.795f, 134, "Kenosha, WI" },
+  {   42.744f,  -124.504f, 169, "Port Orford, OR" },
+  {   42.814f,   -70.869f,  25, "Newburyport, MA" },
+  {   42.878f,   -78.882f, 129, "Buffalo, NY" },
+  {   42.880f,   -82.430f, 126, "Port Huron, MI" },
+  {   42.980f,   -70.817f,  24, "Hampton Harbor, NH" },
+  {   43.038f,   -87.880f, 135, "Milwaukee, WI" },
+  {   43.072f,   -70.712f,  22, "Portsmouth, NH" },
+  {   43.133f,   -70.650f,  23, "York Harbor, ME" },
+  {   43.165f,   -77.620f, 129, "Rochester, NY" },
+  {   43.232f,   -86.250f, 137, "Muskegon, MI" },
+  {   43.325f,   -70.560f,  22, "Kennebunk, ME" },
+  {   43.365f,  -124.217f, 170, "Charleston, OR" },
+  {   43.371f,  -124.210f, 170, "Coos Bay, OR" },
+  {   43.456f,   -76.524f, 129, "Oswego, NY" },
+  {   43.657f,   -70.247f,  21, "Portland, ME" },
+  {   43.740f,   -87.700f, 136, "Sheboygan, WI" },
+  {   43.776f,   -70.008f,  20, "Wells, ME" },
+  {   43.789f,   -82.479f, 126, "Port Sanilac, MI" },
+  {   43.800f,   -88.000f, 139, "Manitowoc, WI" },
+  {   43.951f,   -69.657f,  19, "Boothbay Harbor, ME" },
+  {   43.952f,   -76.495f, 129, "Sackets Harbor, NY" },
+  {   44.017f,   -69.117f,  18, "Rockland, ME" },
+  {   44.050f,  -124.112f, 171, "Florence, OR" },
+  {   44.088f,   -87.660f, 138, "Two Rivers, WI" },
+  {   44.106f,   -68.990f,  17, "Penobscot Bay, ME" },
+  {   44.225f,   -68.799f,  16, "Blue Hill, ME" },
+  {   44.350f,   -83.903f, 126, "Oscoda, MI" },
+  {   44.387f,   -68.204f,  15, "Bar Harbor, ME" },
+  {   44.460f,   -87.490f, 139, "Kewaunee, WI" },
+  {   44.545f,   -87.560f, 138, "Green Bay, WI" },
+  {   44.625f,  -124.050f, 172, "Newport, OR" },
+  {   44.646f,   -67.201f,  14, "Cutler Farris Wharf, ME" },
+  {   44.783f,   -85.630f, 136, "Traverse City, MI" },
+  {   44.903f,   -66.990f,  13, "Eastport, ME" },
+  {   45.068f,   -83.431f, 126, "Cheboygan, MI" },
+  {   45.555f,  -122.673f, 175, "Columbia River, WA" },
+  {   45.555f,  -122.673f, 174, "Vancouver, WA" },
+  {   45.777f,   -84.720f, 133, "Mackinaw City, MI" },
+  {   46.208f,  -123.768f, 173, "Astoria, OR" },
+  {   46.357f,   -87.994f, 141, "Marquette, MI" },
+  {   46.473f,   -84.367f, 133, "St. Marys River, MI" },
+  {   46.495f,   -84.349f, 133, "Sault Ste. Marie, MI" },
+  {   46.597f,   -90.887f, 136, "Ashland, WI" },
+  {   46.656f,  -123.822f, 175, "Cape Disappointment, WA" },
+  {   46.721f,   -92.103f, 141, "Superior Entry, WI" },
+  {   46.785f,   -92.093f, 142, "Duluth, MN" },
+  {   46.970f,  -124.105f, 175, "Grays Harbor, WA" },
+  {   47.052f,  -122.905f, 180, "Olympia, WA" },
+  {   47.122f,   -88.568f, 142, "Houghton, MI" },
+  {   47.269f,  -122.415f, 181, "Tacoma, WA" },
+  {   47.520f,  -122.620f, 181, "Bremerton, WA" },
+  {   47.602f,  -122.339f, 182, "Seattle, WA" },
+  {   47.909f,  -124.637f, 176, "Westport, WA" },
+  {   48.113f,  -122.760f, 179, "Port Townsend, WA" },
+  {   48.125f,  -123.438f, 178, "Port Angeles, WA" },
+  {   48.370f,  -124.616f, 177, "Neah Bay, WA" },
+  {   48.584f,  -123.013f, 183, "Friday Harbor, WA" },
+  {   48.940f,  -122.750f, 184, "Bellingham, WA" },
+  {   51.863f,  -176.658f, 200, "Adak Island, AK" },
+  {   52.943f,  -168.876f, 202, "Nikolski, AK" },
+  {   53.880f,  -166.536f, 201, "Unalaska/Dutch Harbor, AK" },
+  {   54.133f,  -165.780f, 201, "Akutan, AK" },
+  {   54.991f,  -163.535f, 199, "King Cove, AK" },
+  {   55.339f,  -160.497f, 198, "Sand Point, AK" },
+  {   55.342f,  -131.626f, 185, "Ketchikan, AK" },
+  {   56.469f,  -132.377f, 186, "Wrangell, AK" },
+  {   56.585f,  -132.956f, 187, "Petersburg, AK" },
+  {   56.902f,  -153.946f, 197, "Alitak, AK" },
+  {   57.050f,  -135.340f, 187, "Sitka, AK" },
+  {   57.537f,  -157.485f, 197, "Egegik, AK" },
+  {   57.731f,  -152.510f, 196, "Kodiak, AK" },
+  {   58.299f,  -134.411f, 188, "Juneau, AK" },
+  {   58.300f,  -162.018f, 199, "Naknek, AK" },
+  {   58.357f,  -134.575f, 188, "Auke Bay, AK" },
+  {   58.388f,  -135.724f, 189, "Skagway, AK" },
+  {   58.960f,  -135.340f, 190, "Gustavus, AK" },
+  {   59.050f,  -158.490f, 198, "Dillingham, AK" },
+  {   59.441f,  -151.716f, 194, "Seldovia, AK" },
+  {   59.546f,  -139.727f, 190, "Yakutat, AK" },
+  {   59.596f,  -151.414f, 195, "Homer, AK" },
+  {   60.120f,  -149.441f, 193, "Seward, AK" },
+  {   60.558f,  -145.756f, 191, "Cordova, AK" },
+  {   60.765f,  -146.353f, 192, "Whittier, AK" },
+  {   61.128f,  -146.361f, 192, "Valdez, AK" },
+  {   61.238f,  -149.891f, 193, "Anchorage, AK" },
+  {   61.577f,  -148.990f, 193, "Wasilla, AK" },
+  {   63.748f,  -171.489f, 204, "St. Lawrence Island, AK" },
+  {   63.881f,  -160.800f, 203, "Unalakleet, AK" },
+  {   64.500f,  -165.427f, 204, "Nome, AK" },
+  {   64.731f,  -163.421f, 203, "Elim, AK" },
+  {   66.897f,  -162.595f, 205, "Red Dog Dock, AK" },
+  {   67.884f,  -164.789f, 205, "Kotzebue, AK" },
+  {   70.411f,  -148.525f, 206, "Prudhoe Bay, AK" },
+  {   71.293f,  -156.789f, 206, "Barrow/Utqiagvik, AK" },
+};
+
+static const int TIDE_STATION_POINT_COUNT = sizeof(TIDE_STATION_POINTS) / sizeof(TIDE_STATION_POINTS[0]);
+static const float KM_PER_DEGREE = 111.195f;
+static const float DEG_TO_RADF = 0.01745329f;
+
+// bandStart[b] = first point with lat >= b - 90, one band per whole degree.
+// Built once from the sorted table; a query only scans the bands it overlaps.
+static const int LAT_BANDS = 181;
+static uint16_t bandStart[LAT_BANDS + 1];
+static bool bandIndexBuilt = false;
+
+static void buildBandIndex() {
+  int p = 0;
+  for (int band = 0; band <= LAT_BANDS; band++) {
+    while (p < TIDE_STATION_POINT_COUNT && TIDE_STATION_POINTS[p].lat < band - 90.0f) p++;
+    bandStart[band] = (uint16_t)p;
+  }
+  bandIndexBuilt = true;
+}
+
+static int bandFor(float lat) {
+  int band = (int)floorf(lat + 90.0f);
+  if (band < 0) return 0;
+  if (band > LAT_BANDS - 1) return LAT_BANDS - 1;
+  return band;
+}
+
+static float haversineKm(float lat1, float lon1, float lat2, float lon2) {
+  const float R = 6371.0f;
+  float dLat = (lat2 - lat1) * DEG_TO_RADF;
+  float dLon = (lon2 - lon1) * DEG_TO_RADF;
+  float a = sinf(dLat / 2) * sinf(dLat / 2) +
+            cosf(lat1 * DEG_TO_RADF) * cosf(lat2 * DEG_TO_RADF) *
+            sinf(dLon / 2) * sinf(dLon / 2);
+  return R * 2.0f * atan2f(sqrtf(a), sqrtf(1.0f - a));
+}
+
+int findNearestTideStations(float latitude, float longitude, float maxKm, TideStationMatch *matches, int maxMatches) {
+  if (maxMatches <= 0) return 0;
+  if (!bandIndexBuilt) buildBandIndex();
+
+  float dLat = maxKm / KM_PER_DEGREE;
+  int first = bandStart[bandFor(latitude - dLat)];
+  int last = bandStart[bandFor(latitude + dLat) + 1];
+
+  // Equirectangular prefilter. Using the cosine at the band's poleward edge
+  // underestimates east-west distance, so no true candidate is rejected.
+  float edgeLat = fabsf(latitude) + dLat;
+  float cosEdge = edgeLat >= 90.0f ? 0.0f : cosf(edgeLat * DEG_TO_RADF);
+  float maxDeg2 = dLat * dLat;
+
+  int found = 0;
+  for (int i = first; i < last; i++) {
+    const TideStationPoint &p = TIDE_STATION_POINTS[i];
+    float dy = p.lat - latitude;
+    float dx = p.lon - longitude;
+    if (dx > 180.0f) dx -= 360.0f;
+    else if (dx < -180.0f) dx += 360.0f;
+    dx *= cosEdge;
+    if (dx * dx + dy * dy > maxDeg2) continue;
+
+    float d = haversineKm(latitude, longitude, p.lat, p.lon);
+    if (d > maxKm) continue;
+
+    // IDs are unique in the table, so the pointer identifies the station
+    const char *id = TIDE_STATION_IDS[p.station];
+    int existing = -1;
+    for (int j = 0; j < found; j++) {
+      if (matches[j].id == id) { existing = j; break; }
+    }
+    if (existing >= 0) {
+      if (d >= matches[existing].distKm) continue;
+      for (int j = existing; j < found - 1; j++) matches[j] = matches[j + 1];
+      found--;
+    } else if (found == maxMatches) {
+      if (d >= matches[found - 1].distKm) continue;
+      found--;
+    }
+
+    int pos = found;
+    while (pos > 0 && matches[pos - 1].distKm > d) {
+      matches[pos] = matches[pos - 1];
+      pos--;
+    }
+    matches[pos].id = id;
+    matches[pos].name = p.name;
+    matches[pos].distKm = d;
+    found++;
+  }
+  return found;
+}
+
+bool tideStationAtPoint(int pointIndex, TideStationMatch &match) {
+  if (pointIndex < 0 || pointIndex >= TIDE_STATION_POINT_COUNT) return false;
+  const TideStationPoint &p = TIDE_STATION_POINTS[pointIndex];
+  match.id = TIDE_STATION_IDS[p.station];
+  match.name = p.name;
+  match.distKm = 0.0f;
+  return true;
+}
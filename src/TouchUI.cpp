@@ -4,7 +4,12 @@
 #include "Display.h"
 #include "Storage.h"
 #include "Network.h"
+#include "SearchCache.h"
+#include "LocationCache.h"
+#include "History.h"
+#include "SurfSpots.h"
 #include "Game.h"
+#include "Log.h"
 #include <WiFi.h>
 #include <SPI.h>
 
@@ -21,7 +26,10 @@ bool pointInRect(int16_t x, int16_t y, const Rect &r) {
   return x >= r.x && y >= r.y && x < (r.x + r.w) && y < (r.y + r.h);
 }
 
+// Every modal screen polls here, so it also prints pending log records; loop()
+// does the same on the main screens.
 TouchPoint getTouchPoint() {
+  logDrain();
   TouchPoint p;
   if (!touch.touched()) return p;
 
@@ -35,12 +43,12 @@ TouchPoint getTouchPoint() {
   p.pressed = true;
   
   // Debug output
-  Serial.printf("Touch: raw(%d,%d) -> mapped(%d,%d)\n", raw.x, raw.y, p.x, p.y);
+  LOG_DEBUG("Touch: raw(%d,%d) -> mapped(%d,%d)", raw.x, raw.y, p.x, p.y);
   
   return p;
 }
 
-String touchKeyboardInput(const String &title, const String &initial, bool secret) {
+String touchKeyboardInput(const String &title, const String &initial, bool secret, bool suggestSpots) {
   String value = initial;
   bool shiftOn = false;
   bool symMode = false;
@@ -52,6 +60,14 @@ String touchKeyboardInput(const String &title, const String &initial, bool secre
   String keyLabels[44];
   int keyCount = 0;
 
+  // Location suggestions, two columns under the action row
+  const int MAX_SUGGESTIONS = 4;
+  Rect suggestionRects[MAX_SUGGESTIONS];
+  LocationInfo suggestions[MAX_SUGGESTIONS];
+  int suggestionCount = 0;
+  std::vector<LocationInfo> savedLocations;
+  if (suggestSpots) savedLocations = loadDefaultLocations();
+
   while (true) {
     gfx->fillScreen(currentTheme.background);
     gfx->setTextColor(currentTheme.textSecondary);
@@ -107,6 +123,21 @@ String touchKeyboardInput(const String &title, const String &initial, bool secre
     drawButton(space, "SPC", currentTheme.buttonSecondary, currentTheme.text, 1);
     drawButton(done,  "OK",  currentTheme.buttonPrimary,   currentTheme.text, 1);
 
+    suggestionCount = 0;
+    if (suggestSpots) {
+      std::vector<LocationInfo> matches = suggestLocations(value, savedLocations, MAX_SUGGESTIONS);
+      int colW = (gfx->width() - 16 - 4) / 2;
+      for (size_t i = 0; i < matches.size(); i++) {
+        Rect sr = {int16_t(8 + (i % 2) * (colW + 4)), int16_t(216 + (i / 2) * 32), int16_t(colW), 28};
+        String label = matches[i].displayName;
+        if (label.length() > 36) label = label.substring(0, 33) + "...";
+        drawButton(sr, label, currentTheme.buttonList, currentTheme.text, 1);
+        suggestionRects[suggestionCount] = sr;
+        suggestions[suggestionCount] = matches[i];
+        suggestionCount++;
+      }
+    }
+
     while (true) {
       TouchPoint p = getTouchPoint();
       if (!p.pressed) {
@@ -151,6 +182,13 @@ String touchKeyboardInput(const String &title, const String &initial, bool secre
         while (touch.touched()) delay(20);
         return value;
       }
+      // A suggestion submits its full name, which the caller resolves locally
+      for (int i = 0; i < suggestionCount; ++i) {
+        if (pointInRect(p.x, p.y, suggestionRects[i])) {
+          while (touch.touched()) delay(20);
+          return suggestions[i].displayName;
+        }
+      }
 
       delay(20);
     }
@@ -492,8 +530,16 @@ String runLocationSetupTouch(LocationInfo &cachedLocation) {
 
     if (pointInRect(p.x, p.y, locationButton)) {
       while (touch.touched()) delay(20);
-      String searchTerm = touchKeyboardInput("Enter surf location", location, false);
-      if (!searchTerm.isEmpty()) {
+      String searchTerm = touchKeyboardInput("Enter surf location", location, false, true);
+
+      // Catalogued spots and saved defaults resolve without any requests
+      LocationInfo localMatch;
+      if (!searchTerm.isEmpty() && resolveLocalLocation(searchTerm, loadDefaultLocations(), localMatch)) {
+        LOG_INFO("Resolved location locally: %s", localMatch.displayName);
+        location = localMatch.displayName;
+        cachedLocation = localMatch;
+        needsRedraw = true;
+      } else if (!searchTerm.isEmpty()) {
         // Show searching message
         gfx->fillScreen(currentTheme.background);
         gfx->setTextColor(currentTheme.textSecondary);
@@ -513,16 +559,11 @@ String runLocationSetupTouch(LocationInfo &cachedLocation) {
         if (!matches.empty()) {
           gfx->setCursor(10, 50);
           gfx->setTextColor(currentTheme.textSecondary);
-          gfx->println("Checking locations...");
+          gfx->println("Checking " + String(matches.size()) + " locations...");
 
+          std::vector<bool> hasData = locationsHaveData(matches);
           for (size_t i = 0; i < matches.size(); i++) {
-            gfx->fillRect(10, 70, gfx->width() - 20, 20, currentTheme.background);
-            gfx->setCursor(10, 70);
-            gfx->setTextColor(currentTheme.textSecondary);
-            gfx->print(String(i + 1) + "/" + String(matches.size()) + ": " + matches[i].displayName.substring(0, 24));
-            if (locationHasData(matches[i].latitude, matches[i].longitude)) {
-              validMatches.push_back(matches[i]);
-            }
+            if (hasData[i]) validMatches.push_back(matches[i]);
           }
         }
 
@@ -628,15 +669,10 @@ String runLocationSetupTouch(LocationInfo &cachedLocation) {
           }
 
           gfx->setCursor(10, 50);
-          gfx->println("Checking locations...");
+          gfx->println("Checking " + String(unchecked.size()) + " locations...");
+          std::vector<bool> hasData = locationsHaveData(unchecked);
           for (size_t i = 0; i < unchecked.size(); i++) {
-            gfx->fillRect(10, 70, gfx->width() - 20, 20, currentTheme.background);
-            gfx->setCursor(10, 70);
-            gfx->setTextColor(currentTheme.textSecondary);
-            gfx->print(String(i + 1) + "/" + String(unchecked.size()) + ": " + unchecked[i].displayName.substring(0, 24));
-            if (locationHasData(unchecked[i].latitude, unchecked[i].longitude)) {
-              validMatches.push_back(unchecked[i]);
-            }
+            if (hasData[i]) validMatches.push_back(unchecked[i]);
             allCheckedNames.push_back(unchecked[i].displayName);
           }
         }
@@ -709,18 +745,16 @@ String runLocationSetupTouch(LocationInfo &cachedLocation) {
           }
 
           gfx->setCursor(10, 50);
-          gfx->println("Checking locations...");
+          gfx->println("Checking " + String(deepCandidates.size()) + " locations...");
+          std::vector<bool> hasData = locationsHaveData(deepCandidates);
           for (size_t i = 0; i < deepCandidates.size(); i++) {
-            gfx->fillRect(10, 70, gfx->width() - 20, 20, currentTheme.background);
-            gfx->setCursor(10, 70);
-            gfx->setTextColor(currentTheme.textSecondary);
-            gfx->print(String(i + 1) + "/" + String(deepCandidates.size()) + ": " + deepCandidates[i].displayName.substring(0, 24));
-            if (locationHasData(deepCandidates[i].latitude, deepCandidates[i].longitude)) {
-              validMatches.push_back(deepCandidates[i]);
-            }
+            if (hasData[i]) validMatches.push_back(deepCandidates[i]);
           }
         }
 
+        // Search is over; release the geocoding/marine sessions it kept open
+        closeHttpConnections();
+
         if (validMatches.empty()) {
           gfx->fillScreen(currentTheme.background);
           gfx->setCursor(10, 50);
@@ -746,11 +780,8 @@ String runLocationSetupTouch(LocationInfo &cachedLocation) {
       while (touch.touched()) delay(20);
       // Ensure we have valid location coordinates before saving
       if (cachedLocation.valid) {
-        // Clear all tide data — new location means stale tide files
-        deleteTideBounds();
-        deleteTideHourlyCheck();
-        deleteTideDirection();
-        clearTideStationCache();
+        // New location - drop tide files older firmware kept for the old one
+        deleteLegacyTideFiles();
         saveSurfLocation(cachedLocation);
         return cachedLocation.displayName;
       } else {
@@ -774,10 +805,7 @@ String runLocationSetupTouch(LocationInfo &cachedLocation) {
       LocationInfo sel = selectDefaultLocation();
       if (sel.valid) {
         cachedLocation = sel;
-        deleteTideBounds();
-        deleteTideHourlyCheck();
-        deleteTideDirection();
-        clearTideStationCache();
+        deleteLegacyTideFiles();
         saveSurfLocation(cachedLocation);
         return cachedLocation.displayName;
       }
@@ -795,7 +823,7 @@ String runLocationSetupTouch(LocationInfo &cachedLocation) {
   }
 }
 
-int handleMainScreenTouch(const Rect &settingsButton, const Rect &badSurfGraphicRect) {
+int handleMainScreenTouch(const Rect &settingsButton, const Rect &badSurfGraphicRect, const Rect &spotTitleRect) {
   TouchPoint p = getTouchPoint();
   if (!p.pressed) return 0;
 
@@ -811,7 +839,12 @@ int handleMainScreenTouch(const Rect &settingsButton, const Rect &badSurfGraphic
       return 6;  // Enter game mode
     }
   }
-  
+
+  if (pointInRect(p.x, p.y, spotTitleRect)) {
+    while (touch.touched()) delay(20);
+    return 8;  // Show all spots
+  }
+
   return 0;
 }
 
@@ -835,10 +868,8 @@ int handleSettingsScreenTouch(const Rect &backButton, const Rect &forgetButton,
   }
   if (pointInRect(p.x, p.y, forgetLocationButton)) {
     deleteSurfLocation();
-    // Delete tide data files since location changes
-    deleteTideBounds();
-    deleteTideDirection();
-    deleteTideHourlyCheck();
+    // Delete legacy tide files since location changes
+    deleteLegacyTideFiles();
     showStatus("Location deleted", "Reconfigure location", currentTheme.buttonWarning);
     delay(1200);
     surfLocation = "";  // Ensure it's cleared
@@ -864,10 +895,15 @@ int handleSettingsScreenTouch(const Rect &backButton, const Rect &forgetButton,
     deleteThemePreference();
     deleteWaveHeightPreference();
     deleteSurfLocation();
-    deleteTideBounds();
-    deleteTideDirection();
-    deleteTideHourlyCheck();
+    deleteLegacyTideFiles();
+    deleteTideSeries();
+    deleteTideHarmonics();
+    deleteForecastSnapshot();
+    clearSearchCache();
+    clearLocationCache();
+    clearHistory();
     deleteDefaultLocations();
+    deleteOverviewPreference();
 
     showStatus("All settings reset", "Device will restart...", currentTheme.buttonWarning);
     delay(2000);
@@ -1,6 +1,5 @@
 #include <Arduino.h>
 #include <WiFi.h>
-#include <SPIFFS.h>
 #include <time.h>
 
 #include "Config.h"
@@ -11,6 +10,10 @@
 #include "Display.h"
 #include "TouchUI.h"
 #include "Game.h"
+#include "ForecastWorker.h"
+#include "RefreshScheduler.h"
+#include "History.h"
+#include "Log.h"
 
 // Global state
 LocationInfo cachedLocation;
@@ -28,16 +31,36 @@ Rect filesButton = {0, 0, 0, 0};
 Rect leaderboardButton = {0, 0, 0, 0};
 Rect badSurfGraphicRect = {0, 0, 0, 0};
 Rect exitButton = {0, 0, 0, 0};
+// "Surf spot" title and spot name; a tap opens the multi-spot overview
+Rect spotTitleRect = {0, 0, 340, 80};
 String surfLocation = "";
-int locationRetryCount = 0;
-int surfRetryCount = 0;
 float waveHeightThreshold = 1.0f;
 int currentTideDirection = 0;
-bool currentHasTideFile = false;
+bool currentHasTideTrend = false;
+int currentWaveTrend = 0;   // wave height against a few hours earlier: 1 up, -1 down
 
-void ensureWifiConnected() {
+// Last good forecast; stays on screen while the background task refreshes it
+SurfForecast forecast;
+bool haveForecast = false;
+bool forecastFromSnapshot = false;   // restored from flash at boot, not yet refreshed
+time_t forecastFetchedAt = 0;
+// Next rebuild: when a source is due (or a local re-index) after a success,
+// backing off after failures
+RetryBackoff refreshBackoff(4000UL, 300000UL);
+// Multi-spot overview of the saved default locations, shown instead of the
+// single spot screen while overviewMode is set
+bool overviewMode = false;
+std::vector<LocationInfo> overviewSpots;
+std::vector<SpotForecast> spotForecasts;
+bool haveSpotForecasts = false;
+RetryBackoff overviewBackoff(4000UL, 300000UL);
+// Geocoding retries for the saved location name; three failures ask for a new one
+RetryBackoff locationBackoff(4000UL, 16000UL);
+
+// quiet: try the saved network without drawing over the screen first
+void ensureWifiConnected(bool quiet = false) {
   wifiCredentials = loadWifiCredentials();
-  if (!wifiCredentials.valid || !connectWifi(wifiCredentials)) {
+  if (!wifiCredentials.valid || !connectWifi(wifiCredentials, !quiet)) {
     while (true) {
       wifiCredentials = runWifiSetupTouch();
       if (connectWifi(wifiCredentials)) break;
@@ -45,13 +68,111 @@ void ensureWifiConnected() {
   }
 }
 
+void showForecastScreen() {
+  drawForecast(cachedLocation, forecast, settingsButton, badSurfGraphicRect, waveHeightThreshold, forecast.minTide, forecast.maxTide, currentTideDirection, currentHasTideTrend, currentWaveTrend);
+  if (forecastFromSnapshot) drawForecastAge(forecastFetchedAt);
+  if (forecastUpdating()) drawUpdatingIndicator(true);
+}
+
+void showOverviewScreen() {
+  drawSpotOverview(overviewSpots, spotForecasts, waveHeightThreshold);
+  if (forecastUpdating()) drawUpdatingIndicator(true);
+}
+
+void enterOverviewMode() {
+  overviewMode = true;
+  saveOverviewPreference(true);
+  overviewSpots = loadDefaultLocations();
+  haveSpotForecasts = false;
+  spotForecasts.clear();
+  showStatus("Fetching spots", String(overviewSpots.size()) + " saved locations", currentTheme.textSecondary);
+  backoffReset(overviewBackoff, 0);
+}
+
+void leaveOverviewMode() {
+  overviewMode = false;
+  saveOverviewPreference(false);
+  // The single spot forecast was paused; rebuild it now
+  backoffReset(refreshBackoff, 0);
+  if (haveForecast) showForecastScreen();
+  else showStatus("Fetching surf", cachedLocation.displayName, currentTheme.textSecondary);
+}
+
+// Apply a finished overview. Rows without data show as such; a total failure
+// keeps the previous rows and retries with the same backoff as the forecast.
+void handleSpotForecastResult(const std::vector<SpotForecast> &fresh) {
+  if (!fresh.empty()) {
+    spotForecasts = fresh;
+    haveSpotForecasts = true;
+    if (overviewMode && !inSettingsMode) showOverviewScreen();
+    backoffReset(overviewBackoff, FORECAST_REINDEX_INTERVAL_MS);
+    return;
+  }
+  uint32_t waitMs = backoffAfterFailure(overviewBackoff);
+  LOG_ERROR("Overview fetch failed (%d in a row), retrying in %us", overviewBackoff.failures, waitMs / 1000);
+  if (!overviewMode || inSettingsMode) return;
+  if (haveSpotForecasts) drawUpdatingIndicator(false);
+  else showStatus("Spots unavailable", "Tap to go back", currentTheme.error);
+}
+
+// Tide direction from the slope of the prediction curve at the forecast's time.
+// No arrow without a tide curve (zero range means no tide data).
+void setTideDirectionFromForecast() {
+  currentHasTideTrend = forecast.maxTide > forecast.minTide;
+  currentTideDirection = currentHasTideTrend ? (forecast.tideRate >= 0.0f ? 1 : -1) : 0;
+}
+
+// Wave trend from the history record for this spot about three hours before
+// the forecast was fetched. No arrow without one, or for a change under 10 cm.
+static const uint32_t WAVE_TREND_WINDOW_S = 3UL * 60UL * 60UL;
+static const float WAVE_TREND_MIN_CHANGE_M = 0.1f;
+
+void setWaveTrendFromHistory() {
+  currentWaveTrend = 0;
+  HistoryRecord earlier;
+  if (forecastFetchedAt < 1000000000 ||
+      !findHistoryBefore(cachedLocation, forecastFetchedAt - WAVE_TREND_WINDOW_S, earlier) ||
+      forecastFetchedAt - earlier.time > 2 * WAVE_TREND_WINDOW_S) {
+    return;
+  }
+  float change = forecast.waveHeight - earlier.waveHeightCm / 100.0f;
+  if (change >= WAVE_TREND_MIN_CHANGE_M) currentWaveTrend = 1;
+  else if (change <= -WAVE_TREND_MIN_CHANGE_M) currentWaveTrend = -1;
+}
+
+// Draw the last saved forecast for the saved location, if there is one, so the
+// screen is useful before Wi-Fi, NTP and the first fetch have finished.
+bool restoreForecastSnapshot() {
+  LocationInfo snapshotLocation;
+  SurfForecast snapshot;
+  time_t fetchedAt = 0;
+  if (!loadForecastSnapshot(snapshotLocation, snapshot, fetchedAt)) return false;
+  LocationInfo saved = loadSurfLocationInfo();
+  if (!saved.valid || saved.displayName != snapshotLocation.displayName) return false;
+
+  cachedLocation = saved;
+  forecast = snapshot;
+  haveForecast = true;
+  forecastFromSnapshot = true;
+  forecastFetchedAt = fetchedAt;
+  waveHeightThreshold = loadWaveHeightPreference();
+  setTideDirectionFromForecast();
+  setWaveTrendFromHistory();
+  showForecastScreen();
+  return true;
+}
+
 void setup() {
+  Serial.setTxBufferSize(1024);  // logDrain() only writes what fits here
   Serial.begin(115200);
   delay(200);
 
-  if (!SPIFFS.begin(true)) {
-    Serial.println("SPIFFS failed");
-    while (true) delay(1000);
+  if (!beginStorage()) {
+    Serial.println("Storage failed");
+    while (true) {
+      logDrain();
+      delay(1000);
+    }
   }
 
   // Load theme preference before display init
@@ -61,11 +182,8 @@ void setup() {
   setupDisplay();
   setupTouch();
   
-  // Check if this is first boot (no config files exist)
-  bool isFirstBoot = !SPIFFS.exists(WIFI_FILE) && 
-                     !SPIFFS.exists(LOCATION_FILE) && 
-                     !SPIFFS.exists(THEME_FILE) &&
-                     !SPIFFS.exists(WAVE_PREF_FILE);
+  // Check if this is first boot (nothing saved yet)
+  bool isFirstBoot = !haveSavedPreferences();
   
   if (isFirstBoot) {
     // Show welcome screen until user presses setup
@@ -74,6 +192,7 @@ void setup() {
     
     // Wait for setup button press
     while (true) {
+      logDrain();
       if (touch.touched()) {
         TS_Point raw = touch.getPoint();
         int16_t touchX = map(raw.x, TOUCH_MIN_X, TOUCH_MAX_X, gfx->width(), 0);
@@ -98,6 +217,7 @@ void setup() {
 
       bool confirmed = false;
       while (!confirmed) {
+        logDrain();
         if (touch.touched()) {
           TS_Point raw = touch.getPoint();
           int16_t touchX = map(raw.x, TOUCH_MIN_X, TOUCH_MAX_X, gfx->width(), 0);
@@ -118,11 +238,12 @@ void setup() {
     savePlayerName(playerName);
   }
 
-  ensureWifiConnected();
+  bool showingSnapshot = !isFirstBoot && restoreForecastSnapshot();
+  ensureWifiConnected(showingSnapshot);
   
   // Configure NTP time sync
   configTime(0, 0, "pool.ntp.org", "time.nist.gov");
-  logInfo("Waiting for NTP time sync...");
+  LOG_INFO("Waiting for NTP time sync...");
   // Wait up to 20 seconds for time sync
   int timeoutCount = 0;
   while (time(nullptr) < 1000000000 && timeoutCount < 200) {
@@ -130,171 +251,181 @@ void setup() {
     timeoutCount++;
   }
   if (time(nullptr) >= 1000000000) {
-    logInfo("NTP time synced successfully: " + String(time(nullptr)));
+    LOG_INFO("NTP time synced successfully: %d", time(nullptr));
   } else {
-    logError("NTP time sync failed after 10 seconds, time=" + String(time(nullptr)));
+    LOG_ERROR("NTP time sync failed after 10 seconds, time=%d", time(nullptr));
   }
+  if (showingSnapshot && forecastFromSnapshot) drawForecastAge(forecastFetchedAt);
 
   cachedLocation = loadSurfLocationInfo();
   if (!cachedLocation.valid) {
     surfLocation = runLocationSetupTouch(cachedLocation);
   } else {
     surfLocation = cachedLocation.displayName;
-    logInfo("Using saved location: " + surfLocation);
+    LOG_INFO("Using saved location: %s", surfLocation);
   }
   
   // Load wave height preference (will prompt if not saved)
   waveHeightThreshold = loadWaveHeightPreference();
-  if (waveHeightThreshold == 1.0f && !SPIFFS.exists(WAVE_PREF_FILE)) {
+  if (!haveWaveHeightPreference()) {
     waveHeightThreshold = runWaveHeightSetupTouch();
   }
+
+  startForecastWorker();
+  if (loadOverviewPreference()) enterOverviewMode();
+}
+
+// Apply a finished fetch. On failure the previous forecast stays on screen and
+// only the retry schedule changes.
+void handleForecastResult(const SurfForecast &fresh) {
+  if (fresh.valid) {
+    forecast = fresh;
+    haveForecast = true;
+    forecastFromSnapshot = false;
+    forecastFetchedAt = time(nullptr);
+    saveForecastSnapshot(cachedLocation, forecast, forecastFetchedAt);
+    setTideDirectionFromForecast();
+    setWaveTrendFromHistory();
+    LOG_INFO("Tide direction from curve slope: %.3f m/h", forecast.tideRate);
+    appendHistory(cachedLocation, forecast, forecastFetchedAt);
+    if (!inSettingsMode && !overviewMode) showForecastScreen();
+    backoffReset(refreshBackoff, nextForecastUpdateMs());
+    return;
+  }
+
+  // Keep all settings intact and retry with a growing wait, capped at 5 minutes;
+  // a screen tap skips the wait (see loop()).
+  uint32_t waitMs = backoffAfterFailure(refreshBackoff);
+  LOG_ERROR("Forecast fetch failed (%d in a row), retrying in %us", refreshBackoff.failures, waitMs / 1000);
+  if (!inSettingsMode && !haveForecast) {
+    if (refreshBackoff.failures >= 3) {
+      showStatus("Surf data unavailable", "Tap to retry / wait " + String((waitMs + 999) / 1000) + "s", currentTheme.error);
+    } else {
+      showStatus("Fetch failed", String("Retry ") + String(refreshBackoff.failures) + "/3", currentTheme.error);
+    }
+  }
+  if (!inSettingsMode && haveForecast) drawUpdatingIndicator(false);
 }
 
 void loop() {
+  logDrain();
+  flushStateFiles();
   if (WiFi.status() != WL_CONNECTED) ensureWifiConnected();
 
   if (surfLocation.isEmpty()) {
     surfLocation = runLocationSetupTouch(cachedLocation);
-    locationRetryCount = 0;  // Reset retry count for new location
+    backoffReset(locationBackoff, 0);  // Reset retry count for new location
   }
 
-  showStatus("Finding spot", surfLocation, currentTheme.textSecondary);
-  if (!cachedLocation.valid) cachedLocation = fetchLocation(surfLocation);
   if (!cachedLocation.valid) {
-    locationRetryCount++;
-    if (locationRetryCount >= 3) {
-      showStatus("Location failed", "Enter new location", currentTheme.error);
-      delay(3000);
-      surfLocation = "";
-      cachedLocation = LocationInfo();
-      locationRetryCount = 0;
+    // Between attempts just keep looping; nothing blocks while waiting
+    if (!backoffDue(locationBackoff)) {
+      delay(50);
       return;
     }
-    showStatus("Location failed", String("Retry ") + String(locationRetryCount) + "/3", currentTheme.error);
-    delay(4000);
-    return;
-  }
-  
-  // Successfully found location, reset retry count
-  locationRetryCount = 0;
-
-  showStatus("Fetching surf", cachedLocation.displayName, currentTheme.textSecondary);
-  SurfForecast forecast = fetchSurfForecast(cachedLocation.latitude, cachedLocation.longitude);
-  if (!forecast.valid) {
-    surfRetryCount++;
-    if (surfRetryCount >= 3) {
-      // Surf API is temporarily unavailable — keep all settings intact and retry later.
-      // Wait up to 5 minutes, but allow a screen tap to skip the wait immediately.
-      showStatus("Surf data unavailable", "Tap to retry / wait 5min", currentTheme.error);
-      surfRetryCount = 0;
-      {
-        uint32_t waitStart = millis();
-        while (millis() - waitStart < 300000UL) {
-          if (touch.touched()) {
-            while (touch.touched()) delay(20);
-            break;
-          }
-          delay(50);
-        }
+    showStatus("Finding spot", surfLocation, currentTheme.textSecondary);
+    cachedLocation = fetchLocation(surfLocation);
+    if (!cachedLocation.valid) {
+      backoffAfterFailure(locationBackoff);
+      if (locationBackoff.failures >= 3) {
+        showStatus("Location failed", "Enter new location", currentTheme.error);
+        delay(3000);
+        surfLocation = "";
+        cachedLocation = LocationInfo();
+        backoffReset(locationBackoff, 0);
+        return;
       }
+      showStatus("Location failed", String("Retry ") + String(locationBackoff.failures) + "/3", currentTheme.error);
       return;
     }
-    showStatus("Fetch failed", String("Retry ") + String(surfRetryCount) + "/3", currentTheme.error);
-    delay(4000);
-    return;
+    // Successfully found location, reset retry count
+    backoffReset(locationBackoff, 0);
   }
-  
-  // Successfully fetched surf, reset retry count
-  surfRetryCount = 0;
-
-  // Tide direction: always compare the latest hourly reading to the current reading
-  // so an up/down arrow is always available when tide data is available.
-  time_t currentTime = time(nullptr);
-  currentHasTideFile = SPIFFS.exists(TIDE_HOURLY_FILE);
-
-  float hourlyStartHeight = 0.0f;
-  int hourlyStartHour = -1;
-  time_t ignoredHourlyStartTime = 0;
-  bool hasHourlyReading = loadTideHourlyCheck(hourlyStartHeight, ignoredHourlyStartTime, hourlyStartHour);
-
-  struct tm *nowTm = localtime(&currentTime);
-  int currentHour = nowTm ? nowTm->tm_hour : -1;
-
-  if (!hasHourlyReading || hourlyStartHour < 0 || currentHour < 0) {
-    // Seed from current reading and default to rising arrow so it always renders.
-    saveTideHourlyCheck(forecast.tideHeight, currentTime, currentHour);
-    currentTideDirection = 1;
-    currentHasTideFile = true;
-    logInfo("Seeded hourly tide reading; defaulting arrow to rising for first sample.");
-  } else {
-    float heightChange = forecast.tideHeight - hourlyStartHeight;
-    currentTideDirection = (heightChange >= 0.0f) ? 1 : -1;
-    logInfo("Tide direction from hourly reading: " +
-            String(hourlyStartHeight, 3) + "m -> " +
-            String(forecast.tideHeight, 3) + "m (delta " +
-            String(heightChange, 3) + "m)");
-
-    // Start a new hourly baseline when the hour rolls over.
-    if (currentHour != hourlyStartHour) {
-      saveTideHourlyCheck(forecast.tideHeight, currentTime, currentHour);
-      logInfo("Updated tide hourly baseline for hour " + String(currentHour));
+
+  // Start a background refresh when due; the current forecast stays on screen.
+  // The overview replaces the single spot refresh while it is shown.
+  if (overviewMode && !inSettingsMode && !forecastUpdating() && backoffDue(overviewBackoff)) {
+    if (haveSpotForecasts) drawUpdatingIndicator(true);
+    requestSpotForecasts(overviewSpots);
+  }
+  if (!overviewMode && !forecastUpdating() && backoffDue(refreshBackoff)) {
+    if (!inSettingsMode) {
+      if (haveForecast) drawUpdatingIndicator(true);
+      else showStatus("Fetching surf", cachedLocation.displayName, currentTheme.textSecondary);
     }
+    requestForecast(cachedLocation.latitude, cachedLocation.longitude);
   }
 
-  // Keep compatibility file updated for diagnostics/screens that inspect it.
-  saveTideDirection(forecast.tideHeight, currentTime, currentTideDirection);
-
-  drawForecast(cachedLocation, forecast, settingsButton, badSurfGraphicRect, waveHeightThreshold, forecast.minTide, forecast.maxTide, currentTideDirection, currentHasTideFile);
-
-  uint32_t start = millis();
-  while (millis() - start < REFRESH_INTERVAL_MS) {
-    if (inSettingsMode) {
-      // Handle settings screen
-      int touchResult = handleSettingsScreenTouch(backButton, forgetButton, forgetLocationButton, themeButton, waveButton, tideButton, filesButton, leaderboardButton,
-                                                   surfLocation, cachedLocation, waveHeightThreshold);
-      if (touchResult == 1) {
-        // Location-affecting button: WiFi or Location
-        inSettingsMode = false;
-        ensureWifiConnected();
-        cachedLocation = LocationInfo();
-        locationRetryCount = 0;
-        surfRetryCount = 0;
-        // Reset tide state so it is cleanly re-seeded for the new location
-        currentHasTideFile = false;
-        currentTideDirection = 0;
-        break;
-      } else if (touchResult == 2) {
-        // Theme or Wave or Tide button: redraw settings screen
-        drawSettingsScreen(backButton, forgetButton, forgetLocationButton, themeButton, waveButton, tideButton, filesButton, leaderboardButton);
-      } else if (touchResult == 4) {
-        // Back button: exit settings
-        inSettingsMode = false;
-        drawForecast(cachedLocation, forecast, settingsButton, badSurfGraphicRect, waveHeightThreshold, forecast.minTide, forecast.maxTide, currentTideDirection, currentHasTideFile);
-      } else if (touchResult == 5) {
-        // View files button: show files screen (handles its own input now)
-        viewFilesScreen(backButton);
-        drawSettingsScreen(backButton, forgetButton, forgetLocationButton, themeButton, waveButton, tideButton, filesButton, leaderboardButton);
-      } else if (touchResult == 7) {
-        // Leaderboard button
-        showLeaderboard();
-        drawSettingsScreen(backButton, forgetButton, forgetLocationButton, themeButton, waveButton, tideButton, filesButton, leaderboardButton);
-      }
-    } else {
-      // Handle main screen
-      int touchResult = handleMainScreenTouch(settingsButton, badSurfGraphicRect);
-      if (touchResult == 3) {
-        // Settings button: enter settings mode
-        inSettingsMode = true;
-        drawSettingsScreen(backButton, forgetButton, forgetLocationButton, themeButton, waveButton, tideButton, filesButton, leaderboardButton);
-      } else if (touchResult == 6) {
-        // Bad surf graphic touched: enter game mode
-        inGameMode = true;
-        runSurfGame(exitButton);
-        // Game ended, return to main screen
-        inGameMode = false;
-        drawForecast(cachedLocation, forecast, settingsButton, badSurfGraphicRect, waveHeightThreshold, forecast.minTide, forecast.maxTide, currentTideDirection, currentHasTideFile);
-      }
+  SurfForecast fresh;
+  if (pollForecast(fresh)) handleForecastResult(fresh);
+  std::vector<SpotForecast> freshSpots;
+  if (pollSpotForecasts(freshSpots)) handleSpotForecastResult(freshSpots);
+
+  if (inSettingsMode) {
+    // Handle settings screen
+    int touchResult = handleSettingsScreenTouch(backButton, forgetButton, forgetLocationButton, themeButton, waveButton, tideButton, filesButton, leaderboardButton,
+                                                 surfLocation, cachedLocation, waveHeightThreshold);
+    if (touchResult == 1) {
+      // Location-affecting button: WiFi or Location
+      inSettingsMode = false;
+      ensureWifiConnected();
+      cachedLocation = LocationInfo();
+      backoffReset(locationBackoff, 0);
+      // Drop the old spot's forecast; the next request supersedes any fetch in flight
+      forecast = SurfForecast();
+      haveForecast = false;
+      forecastFromSnapshot = false;
+      backoffReset(refreshBackoff, 0);
+      // Reset tide state so it is cleanly re-seeded for the new location
+      currentHasTideTrend = false;
+      currentTideDirection = 0;
+      currentWaveTrend = 0;
+      return;
+    } else if (touchResult == 2) {
+      // Theme or Wave or Tide button: redraw settings screen
+      drawSettingsScreen(backButton, forgetButton, forgetLocationButton, themeButton, waveButton, tideButton, filesButton, leaderboardButton);
+    } else if (touchResult == 4) {
+      // Back button: exit settings
+      inSettingsMode = false;
+      if (haveForecast) showForecastScreen();
+      else showStatus("Fetching surf", cachedLocation.displayName, currentTheme.textSecondary);
+    } else if (touchResult == 5) {
+      // View files button: show files screen (handles its own input now)
+      viewFilesScreen(backButton);
+      drawSettingsScreen(backButton, forgetButton, forgetLocationButton, themeButton, waveButton, tideButton, filesButton, leaderboardButton);
+    } else if (touchResult == 7) {
+      // Leaderboard button
+      showLeaderboard();
+      drawSettingsScreen(backButton, forgetButton, forgetLocationButton, themeButton, waveButton, tideButton, filesButton, leaderboardButton);
+    }
+  } else if (overviewMode) {
+    // Any tap on the overview returns to the single spot screen
+    if (touch.touched()) {
+      while (touch.touched()) delay(20);
+      leaveOverviewMode();
+    }
+  } else if (haveForecast) {
+    // Handle main screen
+    int touchResult = handleMainScreenTouch(settingsButton, badSurfGraphicRect, spotTitleRect);
+    if (touchResult == 3) {
+      // Settings button: enter settings mode
+      inSettingsMode = true;
+      drawSettingsScreen(backButton, forgetButton, forgetLocationButton, themeButton, waveButton, tideButton, filesButton, leaderboardButton);
+    } else if (touchResult == 6) {
+      // Bad surf graphic touched: enter game mode
+      inGameMode = true;
+      runSurfGame(exitButton);
+      // Game ended, return to main screen
+      inGameMode = false;
+      showForecastScreen();
+    } else if (touchResult == 8) {
+      // Spot title touched: show all saved spots
+      enterOverviewMode();
     }
-    delay(50);
+  } else if (!forecastUpdating() && touch.touched()) {
+    // No forecast yet and waiting to retry: a tap retries immediately
+    while (touch.touched()) delay(20);
+    backoffRetryNow(refreshBackoff);
   }
+  delay(50);
 }